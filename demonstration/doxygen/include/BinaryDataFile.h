@@ -0,0 +1,128 @@
+// Define the BINARYDATAFILE_H macro to act as an include guard
+#ifndef BINARYDATAFILE_H
+#define BINARYDATAFILE_H
+
+// Include the <cstddef> header to provide the std::size_t type.
+#include <cstddef>
+// Include the <cstdint> header to provide fixed-width integer types.
+#include <cstdint>
+// Include the <string> header to provide the STL std::string type.
+#include <string>
+// Include the <vector> header to provide the STL std::vector type.
+#include <vector>
+
+// Include "StatsAccumulator.h" to provide the StatsAccumulator class.
+#include "StatsAccumulator.h"
+
+/** \brief Enumerates the types of the values that can be stored in a binary
+ * data file.
+ */
+enum BinaryDataType {
+    /** \brief IEEE 754 double-precision values. */
+    FLOAT64_DATA = 1
+};
+
+/** \brief The number of consecutive values described by each of the block
+ * summaries in the header of a binary data file written by
+ * writeBinaryDataFile().
+ */
+const std::size_t binaryDataBlockSize = 65536;
+
+/** \brief A structure that collects the fields of the header of a binary
+ * data file.
+ */
+struct BinaryDataHeader {
+    
+    /** \brief The type of the stored values, one of the BinaryDataType values.
+     */
+    std::uint32_t dataType;
+    
+    /** \brief The number of stored values.
+     */
+    std::uint64_t valueCount;
+    
+    /** \brief The number of consecutive values described by each block summary.
+     */
+    std::uint64_t blockSize;
+    
+    /** \brief The number of block summaries.
+     */
+    std::uint64_t blockCount;
+    
+    /** \brief The offset in bytes from the beginning of the file to the first
+     * stored value.
+     */
+    std::uint64_t dataOffset;
+};
+
+/** \brief Function that writes an array of double-precision values to a
+ * binary data file, preceded by a header that contains a summary of the
+ * statistics of each block of "binaryDataBlockSize" values. Returns true on
+ * success.
+ *
+ * Requires three arguments:
+ * 1) fileName - A string specifying the path of the file to be written.
+ * 2) values - A pointer to the first element of the array.
+ * 3) valueCount - The number of elements in the array.
+ */
+bool writeBinaryDataFile(const std::string & fileName, const double * values,
+                         std::size_t valueCount);
+
+/** \brief Function that reads and validates the header of a binary data file
+ * that has been loaded or mapped into memory. Returns true if the header is
+ * valid and consistent with the size of the file.
+ *
+ * Requires three arguments:
+ * 1) fileBegin - A pointer to the first byte of the file.
+ * 2) fileSize - The number of bytes in the file.
+ * 3) header - A reference to a BinaryDataHeader that receives the fields of
+ *    the header.
+ */
+bool parseBinaryDataHeader(const unsigned char * fileBegin, std::size_t fileSize,
+                           BinaryDataHeader & header);
+
+/** \brief Function that loads the summary of the statistics of one block of
+ * values from the header of a binary data file that has been loaded or
+ * mapped into memory. Returns true on success.
+ *
+ * Requires four arguments:
+ * 1) fileBegin - A pointer to the first byte of the file.
+ * 2) header - The header of the file, obtained using parseBinaryDataHeader().
+ * 3) blockIndex - The index of the block, which must be less than the
+ *    "blockCount" member of the header.
+ * 4) statistics - A reference to a StatsAccumulator that receives the
+ *    statistics of the block.
+ */
+bool loadBlockStatistics(const unsigned char * fileBegin, const BinaryDataHeader & header,
+                         std::size_t blockIndex, StatsAccumulator & statistics);
+
+/** \brief Function that writes an index of block summaries to a binary index
+ * file, so that it can be reused without being rebuilt. Returns true on
+ * success.
+ *
+ * Requires three arguments:
+ * 1) fileName - A string specifying the path of the file to be written.
+ * 2) blockSummaries - The statistics of each consecutive block of
+ *    "binaryDataBlockSize" values.
+ * 3) valueCount - The number of values in the data set that was indexed,
+ *    which is used to detect an index that does not match the data.
+ */
+bool writeBlockIndexFile(const std::string & fileName,
+                         const std::vector<StatsAccumulator> & blockSummaries,
+                         std::uint64_t valueCount);
+
+/** \brief Function that reads an index of block summaries from a binary index
+ * file written by writeBlockIndexFile(). Returns true on success.
+ *
+ * Requires three arguments:
+ * 1) fileName - A string specifying the path of the index file.
+ * 2) blockSummaries - A reference to a vector that receives the statistics
+ *    of each block. It is unchanged if false is returned.
+ * 3) valueCount - A reference to a variable that receives the number of
+ *    values in the data set that was indexed.
+ */
+bool readBlockIndexFile(const std::string & fileName,
+                        std::vector<StatsAccumulator> & blockSummaries,
+                        std::uint64_t & valueCount);
+
+#endif /* End #ifndef BINARYDATAFILE_H preprocessor conditional block. */
@@ -0,0 +1,46 @@
+// Define the BYTEORDER_H macro to act as an include guard
+#ifndef BYTEORDER_H
+#define BYTEORDER_H
+
+// Include the <cstddef> header to provide the std::size_t type.
+#include <cstddef>
+// Include the <cstdint> header to provide fixed-width integer types.
+#include <cstdint>
+
+/** \brief Function that returns true if the processor on which the program is
+ * currently running stores multi-byte values in little-endian byte order.
+ */
+bool isLittleEndianHost();
+
+/** \brief Function that stores an unsigned integer in a buffer as a
+ * little-endian sequence of bytes, independently of the byte order of the
+ * processor.
+ *
+ * Requires three arguments:
+ * 1) buffer - A pointer to the first byte to be written.
+ * 2) value - The value to be stored.
+ * 3) byteCount - The number of bytes to be written, at most eight.
+ */
+void storeLittleEndian(unsigned char * buffer, std::uint64_t value,
+                       std::size_t byteCount);
+
+/** \brief Function that loads an unsigned integer from a little-endian
+ * sequence of bytes in a buffer.
+ *
+ * Requires two arguments:
+ * 1) buffer - A pointer to the first byte to be read.
+ * 2) byteCount - The number of bytes to be read, at most eight.
+ */
+std::uint64_t loadLittleEndian(const unsigned char * buffer, std::size_t byteCount);
+
+/** \brief Function that stores a double-precision value in a buffer as the
+ * little-endian sequence of the eight bytes of its IEEE 754 representation.
+ */
+void storeDouble(unsigned char * buffer, double value);
+
+/** \brief Function that loads a double-precision value from the little-endian
+ * sequence of the eight bytes of its IEEE 754 representation.
+ */
+double loadDouble(const unsigned char * buffer);
+
+#endif /* End #ifndef BYTEORDER_H preprocessor conditional block. */
@@ -0,0 +1,210 @@
+// Define the COLUMNTABLE_H macro to act as an include guard
+#ifndef COLUMNTABLE_H
+#define COLUMNTABLE_H
+
+// Include the <cstddef> header to provide the std::size_t type.
+#include <cstddef>
+// Include the <iosfwd> header to declare the std::ostream type.
+#include <iosfwd>
+// Include the <string> header to provide the STL std::string type.
+#include <string>
+// Include the <vector> header to provide the STL std::vector type.
+#include <vector>
+
+// Include "StatsCalculator.h" to provide the OutputVerbosity enumeration and
+// the StatsSummary structure.
+#include "StatsCalculator.h"
+// Include "CovarianceAccumulator.h" to provide the CovarianceAccumulator class.
+#include "CovarianceAccumulator.h"
+
+/** \class ColumnTable
+ * The ColumnTable class reads a text file whose lines are rows of several
+ * numeric columns, separated either by commas or by whitespace, and
+ * optionally preceded by a header line that names the columns. Lines that
+ * are empty or begin with "#" are ignored.
+ *
+ * The values of each column are stored in their own contiguous array (a
+ * "struct of arrays"), rather than row by row, so the statistics of every
+ * column are computed by a single sequential pass over its own array. The
+ * statistics are reported, and can be obtained, by column name or by
+ * column index.
+ *
+ * The covariance and correlation matrices of the columns can also be
+ * computed, by a single pass over blocks of rows, and reported after the
+ * summaries of the columns.
+ */
+class ColumnTable {
+    
+    /** \brief The name of each column, taken from the header line or, if
+     * there is none, equal to the one-based index of the column.
+     */
+    std::vector<std::string> columnNames;
+    
+    /** \brief The values of each column, each stored contiguously.
+     */
+    std::vector<std::vector<double> > columnValues;
+    
+    /** \brief The number of worker threads among which readFile() divides
+     * the parsing of the input file, and among which the columns are
+     * divided when their statistics are computed.
+     */
+    unsigned int threadCount;
+    
+    /** \brief The amount of information that readFile() and writeStats()
+     * print to the terminal.
+     */
+    OutputVerbosity verbosity;
+    
+    /** \brief A cached copy of the statistical summary of each column. It is
+     * declared "mutable" so that it can be updated by const methods.
+     */
+    mutable std::vector<StatsSummary> cachedSummaries;
+    
+    /** \brief Flag indicating whether "cachedSummaries" reflects the current
+     * contents of the "columnValues" member datum.
+     */
+    mutable bool cachedSummariesAreValid;
+    
+    /** \brief Flag indicating whether printStats() and writeStats() also
+     * report the covariance and correlation matrices of the columns.
+     */
+    bool covarianceMatrices;
+    
+    /** \brief A cached copy of the means and co-moments of the columns, from
+     * which their covariance and correlation matrices are obtained.
+     */
+    mutable CovarianceAccumulator cachedCovariance;
+    
+    /** \brief Flag indicating whether "cachedCovariance" reflects the current
+     * contents of the "columnValues" member datum.
+     */
+    mutable bool cachedCovarianceIsValid;
+    
+    /** \brief Private static method that parses rows of numeric values from
+     * a range of characters that begins at the start of a line, appending
+     * the values of each column to the corresponding element of "columns".
+     * Returns a pointer to the start of the first line that could not be
+     * parsed, or to the end of the range.
+     */
+    static const char * parseRows(const char * bufferBegin, const char * bufferEnd,
+                                  char separator,
+                                  std::vector<std::vector<double> > & columns);
+    
+    /** \brief Private method that writes the summary of every column to an
+     * output stream.
+     */
+    void writeSummaries(std::ostream & stream) const;
+    
+    /** \brief Private method that writes the covariance and correlation
+     * matrices of the columns to an output stream.
+     */
+    void writeMatrices(std::ostream & stream) const;
+    
+public:
+    
+    /** \brief Default constructor. Creates a table with no columns.
+     */
+    ColumnTable();
+    
+    /** \brief Public method that sets the number of worker threads.
+     *
+     * Requires one argument:
+     * 1) newThreadCount - The number of worker threads. A value of zero
+     *    selects the number of hardware threads available on the current
+     *    machine.
+     */
+    void setThreadCount(unsigned int newThreadCount);
+    
+    /** \brief Public method that sets the amount of information that
+     * readFile() and writeStats() print to the terminal.
+     *
+     * Requires one argument:
+     * 1) newVerbosity - QUIET_OUTPUT, or SUMMARY_OUTPUT (the default) or
+     *    FULL_OUTPUT, both of which print progress messages.
+     */
+    void setVerbosity(OutputVerbosity newVerbosity);
+    
+    /** \brief Public method that sets whether printStats() and writeStats()
+     * also report the covariance and correlation matrices of the columns.
+     *
+     * Requires one argument:
+     * 1) enabled - true to report the matrices, false (the default) to
+     *    report only the summary of each column.
+     */
+    void setCovarianceMatrices(bool enabled);
+    
+    /** \brief Public method that replaces the contents of the table with the
+     * rows of a text file. Returns true if every line of the file was
+     * parsed, and false if the file could not be read, in which case the
+     * table is empty, or if a malformed row was encountered, in which case
+     * the rows that precede it are retained.
+     *
+     * Requires one argument:
+     * 1) infileName - A string specifying the path of a text file whose
+     *    lines contain the same number of numeric values, separated by
+     *    commas or by whitespace.
+     */
+    bool readFile(const std::string & infileName);
+    
+    /** \brief Public method returns the number of columns.
+     */
+    std::size_t getColumnCount() const;
+    
+    /** \brief Public method returns the number of rows.
+     */
+    std::size_t getRowCount() const;
+    
+    /** \brief Public method returns the name of the column with the
+     * specified zero-based index.
+     */
+    const std::string & getColumnName(std::size_t columnIndex) const;
+    
+    /** \brief Public method returns the zero-based index of the column with
+     * the specified name, or the number of columns if there is no such
+     * column.
+     */
+    std::size_t findColumn(const std::string & columnName) const;
+    
+    /** \brief Public method returns the values of the column with the
+     * specified zero-based index, which are stored contiguously.
+     */
+    const std::vector<double> & getColumn(std::size_t columnIndex) const;
+    
+    /** \brief Public method returns a summary of the statistical properties
+     * of the column with the specified zero-based index. The summaries of
+     * every column are computed together once and cached until the table
+     * changes.
+     */
+    const StatsSummary & getColumnSummary(std::size_t columnIndex) const;
+    
+    /** \brief Public method that copies a summary of the statistical
+     * properties of the column with the specified name into "summary".
+     * Returns true on success and false if there is no such column.
+     */
+    bool getColumnSummary(const std::string & columnName, StatsSummary & summary) const;
+    
+    /** \brief Public method returns an accumulator holding the means of the
+     * columns and the sums of the products of their deviations, from which
+     * the covariance and correlation of any pair of columns are obtained.
+     * The rows are divided among the worker threads, and the accumulator is
+     * cached until the table changes.
+     */
+    const CovarianceAccumulator & getCovarianceMatrices() const;
+    
+    /** \brief Public method that prints a summary of the statistical
+     * properties of every column to the terminal, followed by the
+     * covariance and correlation matrices if they were requested.
+     */
+    void printStats() const;
+    
+    /** \brief Public method that writes a summary of the statistical
+     * properties of every column to a text file.
+     *
+     * Requires one argument:
+     * 1) outfileName - A string specifying the path of the text file.
+     */
+    void writeStats(const std::string & outfileName) const;
+    
+};
+
+#endif /* End #ifndef COLUMNTABLE_H preprocessor conditional block. */
@@ -0,0 +1,113 @@
+// Define the COVARIANCEACCUMULATOR_H macro to act as an include guard
+#ifndef COVARIANCEACCUMULATOR_H
+#define COVARIANCEACCUMULATOR_H
+
+// Include the <cstddef> header to provide the std::size_t type.
+#include <cstddef>
+// Include the <vector> header to provide the STL std::vector type.
+#include <vector>
+
+/** \class CovarianceAccumulator
+ * The CovarianceAccumulator class computes the means of several variables,
+ * and the covariance and Pearson correlation of every pair of them, from
+ * rows of values that are supplied to it incrementally, without storing
+ * them.
+ *
+ * Rather than the sums of the values and of their products, which lose
+ * precision when the variances are small relative to the means, the class
+ * stores the running means and the sums of the products of the deviations
+ * of the values from them (the "co-moments"). The rows are processed in
+ * blocks: the deviations of each block from the current means are copied
+ * into a buffer small enough to remain in the processor cache, and the
+ * sums of their products are accumulated by the vectorized
+ * addCrossProducts(...) function, so every value is read from memory only
+ * once however many columns there are.
+ *
+ * Two accumulators can be merged, so that separate blocks of rows can be
+ * processed independently, for example by different threads, and the
+ * results combined afterwards.
+ */
+class CovarianceAccumulator {
+    
+    /** \brief The number of variables, i.e. the number of values in each
+     * row.
+     */
+    std::size_t columnCount;
+    
+    /** \brief The number of rows that have been accumulated.
+     */
+    std::size_t count;
+    
+    /** \brief The mean of each variable.
+     */
+    std::vector<double> means;
+    
+    /** \brief The sum of the products of the deviations of each pair of
+     * variables from their means, stored row by row as a square matrix of
+     * which only the elements on and above the diagonal are used.
+     */
+    std::vector<double> coMoments;
+    
+public:
+    
+    /** \brief Default constructor. Creates an accumulator for no variables.
+     */
+    CovarianceAccumulator();
+    
+    /** \brief Constructor. Creates an accumulator that has not been supplied
+     * with any rows.
+     *
+     * Requires one argument:
+     * 1) newColumnCount - The number of variables.
+     */
+    explicit CovarianceAccumulator(std::size_t newColumnCount);
+    
+    /** \brief Public method that adds a range of rows to the running
+     * statistics.
+     *
+     * Requires three arguments:
+     * 1) columns - An array of pointers, one per variable, each of which
+     *    points to the first value of an array of the values of that
+     *    variable.
+     * 2) firstRow - The index of the first row of the range.
+     * 3) rowCount - The number of rows in the range.
+     */
+    void addRows(const double * const * columns, std::size_t firstRow, std::size_t rowCount);
+    
+    /** \brief Public method that adds the running statistics of another
+     * accumulator to those of this accumulator. Returns true on success,
+     * and false, leaving this accumulator unchanged, if the numbers of
+     * variables differ.
+     */
+    bool merge(const CovarianceAccumulator & other);
+    
+    /** \brief Public method returns the number of variables.
+     */
+    std::size_t getColumnCount() const;
+    
+    /** \brief Public method returns the number of rows that have been
+     * accumulated.
+     */
+    std::size_t getCount() const;
+    
+    /** \brief Public method returns the mean of the variable with the
+     * specified zero-based index.
+     */
+    double getMean(std::size_t columnIndex) const;
+    
+    /** \brief Public method returns the covariance of the variables with the
+     * specified zero-based indices. As for the standard deviation reported
+     * by StatsCalculator, the sum of the products of the deviations is
+     * divided by the number of rows.
+     */
+    double getCovariance(std::size_t firstIndex, std::size_t secondIndex) const;
+    
+    /** \brief Public method returns the Pearson correlation coefficient of
+     * the variables with the specified zero-based indices, which is NaN if
+     * either variable is constant.
+     */
+    double getCorrelation(std::size_t firstIndex, std::size_t secondIndex) const;
+    
+};
+
+#endif /* End #ifndef COVARIANCEACCUMULATOR_H preprocessor conditional block. */
@@ -0,0 +1,232 @@
+// Define the DELIMITEDTEXT_H macro to act as an include guard
+#ifndef DELIMITEDTEXT_H
+#define DELIMITEDTEXT_H
+
+// Include the <charconv> header to provide the std::from_chars(...) function.
+#include <charconv>
+// Include the <cstddef> header to provide the std::size_t type.
+#include <cstddef>
+// Include the <string> header to provide the STL std::string type.
+#include <string>
+// Include the <vector> header to provide the STL std::vector type.
+#include <vector>
+
+// Include "CompressedInput.h" to provide the InputCompression enumeration.
+#include "CompressedInput.h"
+
+/* The functions below are shared by the readers of delimited text files,
+ * ColumnTable, GroupedStats and WeightedStats. The smallest of them are
+ * called for every character or token of a file, so they are defined in
+ * this header, where the compiler can inline them into the parsing loops.
+ */
+
+/** \brief Function that determines whether a character separates fields
+ * within a line. Line breaks are not included.
+ *
+ * Requires one argument:
+ * 1) character - The character to be classified.
+ *
+ * Returns true if the character is a space, tab, carriage return, vertical
+ * tab or form feed, false otherwise.
+ */
+inline bool isBlank(char character){
+    return character == ' ' || character == '\t' || character == '\r' ||
+           character == '\v' || character == '\f';
+}
+
+/** \brief Function that returns a pointer to the end of the line that
+ * contains a character.
+ *
+ * Requires two arguments:
+ * 1) position - A pointer to the character.
+ * 2) bufferEnd - A pointer one past the last character of the buffer.
+ *
+ * Returns a pointer to the newline character that ends the line, or
+ * "bufferEnd" if the last line of the buffer is not terminated.
+ */
+inline const char * findLineEnd(const char * position, const char * bufferEnd){
+    while(position != bufferEnd && *position != '\n'){
+        ++position;
+    }
+    return position;
+}
+
+/** \brief Function that interprets a numeric value at the start of a range
+ * of characters, accepting exactly the tokens that
+ * StatsCalculator::readFile() accepts. Textual tokens such as "inf" or
+ * "nan" are rejected.
+ *
+ * Requires three arguments:
+ * 1) tokenBegin - A pointer to the first character of the token.
+ * 2) bufferEnd - A pointer one past the last character that may belong to
+ *    the token.
+ * 3) value - Set to the interpreted value.
+ *
+ * Returns a pointer to the first character after the token, or a null
+ * pointer if the characters do not begin with a numeric value.
+ */
+inline const char * parseValue(const char * tokenBegin, const char * bufferEnd,
+                               double & value){
+    
+    // Skip an explicit leading "+" sign, which std::from_chars rejects.
+    bool explicitPlusSign(false);
+    if(tokenBegin != bufferEnd && *tokenBegin == '+' && tokenBegin + 1 != bufferEnd){
+        ++tokenBegin;
+        explicitPlusSign = true;
+    }
+    
+    /* A valid token begins with a digit or a decimal point after a single
+     * optional sign, so a token such as "+-3" is also rejected.
+     */
+    const char * firstDigit = tokenBegin;
+    if(!explicitPlusSign && firstDigit != bufferEnd && *firstDigit == '-' &&
+       firstDigit + 1 != bufferEnd){
+        ++firstDigit;
+    }
+    if(firstDigit == bufferEnd ||
+       !((*firstDigit >= '0' && *firstDigit <= '9') || *firstDigit == '.')){
+        return 0;
+    }
+    
+    std::from_chars_result result = std::from_chars(tokenBegin, bufferEnd, value);
+    return (result.ec == std::errc()) ? result.ptr : 0;
+}
+
+/** \brief Function that divides a line into fields.
+ *
+ * Requires three arguments:
+ * 1) lineBegin - A pointer to the first character of the line.
+ * 2) lineEnd - A pointer one past the last character of the line.
+ * 3) separator - ',' if the fields are separated by commas, or ' ' if they
+ *    are separated by whitespace.
+ *
+ * Returns the fields, without any surrounding whitespace or double quotes.
+ */
+std::vector<std::string> splitFields(const char * lineBegin, const char * lineEnd,
+                                     char separator);
+
+/** \brief Function that returns a pointer to the first line of a buffer that
+ * is neither empty, nor blank, nor a comment beginning with '#'.
+ *
+ * Requires two arguments:
+ * 1) bufferBegin - A pointer to the first character of the buffer.
+ * 2) bufferEnd - A pointer one past the last character of the buffer.
+ *
+ * Returns a pointer to the first character of the line, or "bufferEnd" if
+ * there is no such line.
+ */
+const char * findFirstDataLine(const char * bufferBegin, const char * bufferEnd);
+
+/** \brief Function that divides a range of lines into subranges of
+ * approximately equal size, each of which begins at the start of a line,
+ * so that each can be parsed by its own worker thread.
+ *
+ * Requires three arguments:
+ * 1) dataBegin - A pointer to the first character of the first line.
+ * 2) dataEnd - A pointer one past the last character of the last line.
+ * 3) threadCount - The number of worker threads available. Fewer subranges
+ *    are formed if each would otherwise be too small to be worth a thread.
+ *
+ * Returns the first character of each subrange, followed by "dataEnd", so
+ * that subrange i runs from element i up to, but not including, element
+ * i + 1. There is always at least one subrange.
+ */
+std::vector<const char *> divideIntoLineRanges(const char * dataBegin, const char * dataEnd,
+                                               unsigned int threadCount);
+
+/** \class MappedTextFile
+ * The MappedTextFile class memory-maps an input file for reading, as
+ * StatsCalculator::readFile() does, so that its characters can be parsed in
+ * place by several threads without being copied. The mapping is released
+ * when the object is destroyed.
+ *
+ * A file that is compressed using gzip or zstd is recognized from its
+ * leading bytes, as by StatsCalculator::readFile(), and is decompressed in
+ * full into memory using an InputDecompressor, since its characters cannot
+ * be parsed in place. The decompressed characters are then provided in the
+ * same way as those of a mapped file.
+ *
+ * An empty file cannot be mapped, so it is represented by an empty range
+ * of characters, and is still readable. The standard input cannot be
+ * mapped, and is not supported.
+ */
+class MappedTextFile {
+    
+    /** \brief A pointer to the first character of the mapped file, or a
+     * null pointer if the file is empty or was not mapped.
+     */
+    const char * fileBegin;
+    
+    /** \brief The number of characters in the file.
+     */
+    std::size_t fileSize;
+    
+    /** \brief Flag indicating that the file was opened, and mapped or
+     * decompressed unless it is empty.
+     */
+    bool readable;
+    
+    /** \brief Flag indicating that "fileBegin" points to a mapping of the
+     * file, which must be released.
+     */
+    bool mapped;
+    
+    /** \brief The format in which the file is compressed.
+     */
+    InputCompression compression;
+    
+    /** \brief The decompressed characters of a compressed file, which is
+     * empty unless the file is compressed.
+     */
+    std::vector<char> decompressedText;
+    
+    /** \brief Private method that decompresses the whole of a compressed
+     * file into "decompressedText". Returns false if the file could not be
+     * decompressed.
+     */
+    bool decompress(int fileDescriptor);
+    
+    /** \brief The copy constructor and copy assignment operator are declared
+     * but not defined, which prevents copying.
+     */
+    MappedTextFile(const MappedTextFile &);
+    MappedTextFile & operator=(const MappedTextFile &);
+    
+public:
+    
+    /** \brief Constructor. Opens and memory-maps the specified file, or
+     * decompresses it if it is compressed. If a compressed file cannot be
+     * decompressed, the reason is always printed.
+     *
+     * Requires one argument:
+     * 1) fileName - A string specifying the path of the file.
+     */
+    explicit MappedTextFile(const std::string & fileName);
+    
+    /** \brief Destructor. Releases the mapping of the file.
+     */
+    ~MappedTextFile();
+    
+    /** \brief Public method returns true if the file was opened and mapped
+     * or decompressed, or is empty.
+     */
+    bool isReadable() const;
+    
+    /** \brief Public method returns the format in which the file is
+     * compressed, or UNCOMPRESSED_INPUT.
+     */
+    InputCompression getCompression() const;
+    
+    /** \brief Public method returns a pointer to the first character of the
+     * file.
+     */
+    const char * begin() const;
+    
+    /** \brief Public method returns a pointer one past the last character of
+     * the file.
+     */
+    const char * end() const;
+    
+};
+
+#endif /* End #ifndef DELIMITEDTEXT_H preprocessor conditional block. */
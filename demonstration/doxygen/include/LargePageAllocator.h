@@ -0,0 +1,150 @@
+// Define the LARGEPAGEALLOCATOR_H macro to act as an include guard
+#ifndef LARGEPAGEALLOCATOR_H
+#define LARGEPAGEALLOCATOR_H
+
+// Include the <cstddef> header to provide the std::size_t type.
+#include <cstddef>
+// Include the <new> header to provide the placement new operator.
+#include <new>
+// Include the <utility> header to provide the std::forward(...) function.
+#include <utility>
+
+/** \brief Allocations of at least this many bytes are mapped directly from
+ * the operating system by allocateLargePages(), rather than obtained from
+ * the heap. It is the size of a transparent huge page on x86-64.
+ */
+const std::size_t largePageAllocationSize = 1 << 21;
+
+/** \brief Function that maps a block of anonymous memory directly from the
+ * operating system and advises it to back the block with huge pages.
+ *
+ * Requires one argument:
+ * 1) byteCount - The number of bytes in the block.
+ *
+ * Returns a pointer to the first byte of the block, or a null pointer if it
+ * could not be mapped. The pages of the block occupy no physical memory
+ * until they are first written, and are then filled with zeros.
+ */
+void * allocateLargePages(std::size_t byteCount);
+
+/** \brief Function that returns a block mapped by allocateLargePages() to the
+ * operating system.
+ *
+ * Requires two arguments:
+ * 1) block - A pointer to the first byte of the block.
+ * 2) byteCount - The number of bytes that were requested for the block.
+ */
+void releaseLargePages(void * block, std::size_t byteCount);
+
+/** \class LargePageAllocator
+ * The LargePageAllocator class template is an allocator for STL containers,
+ * such as std::vector, of large arrays of numeric values. Arrays of at least
+ * "largePageAllocationSize" bytes are mapped directly from the operating
+ * system by allocateLargePages(), and smaller arrays are obtained from the
+ * heap as by std::allocator.
+ *
+ * Two properties of mapped arrays reduce the memory and time required to
+ * store many millions of values. Firstly, the operating system is advised
+ * to back them with 2 MiB huge pages, so that far fewer page faults and
+ * translation lookaside buffer misses occur while they are filled and
+ * scanned. Secondly, their pages occupy no physical memory until they are
+ * written, so a vector may reserve a generous estimate of the number of
+ * values that it will hold, and only the part that is actually filled
+ * contributes to the resident memory of the program.
+ *
+ * Unlike std::allocator, elements that are constructed without a value are
+ * default-initialized rather than value-initialized. Enlarging a vector of
+ * numeric values using its resize(...) method therefore does not write to
+ * the new elements, which are left uninitialized until the caller fills
+ * them, and does not make their pages resident.
+ */
+template<typename Element>
+class LargePageAllocator {
+    
+public:
+    
+    /** \brief The type of the elements that are allocated.
+     */
+    typedef Element value_type;
+    
+    /** \brief Default constructor. The allocator has no state.
+     */
+    LargePageAllocator(){}
+    
+    /** \brief Converting constructor, which allows STL containers to obtain
+     * an allocator for another type of element.
+     */
+    template<typename OtherElement>
+    LargePageAllocator(const LargePageAllocator<OtherElement> &){}
+    
+    /** \brief Public method that allocates uninitialized memory for an array
+     * of elements, reporting failure by throwing std::bad_alloc as
+     * std::allocator does.
+     *
+     * Requires one argument:
+     * 1) elementCount - The number of elements in the array.
+     */
+    Element * allocate(std::size_t elementCount){
+        std::size_t byteCount = elementCount*sizeof(Element);
+        if(byteCount < largePageAllocationSize){
+            return static_cast<Element *>(::operator new(byteCount));
+        }
+        void * block = allocateLargePages(byteCount);
+        if(!block){
+            throw std::bad_alloc();
+        }
+        return static_cast<Element *>(block);
+    }
+    
+    /** \brief Public method that releases the memory of an array allocated
+     * by allocate().
+     *
+     * Requires two arguments:
+     * 1) elements - A pointer to the first element of the array.
+     * 2) elementCount - The number of elements that were allocated.
+     */
+    void deallocate(Element * elements, std::size_t elementCount){
+        std::size_t byteCount = elementCount*sizeof(Element);
+        if(byteCount < largePageAllocationSize){
+            ::operator delete(elements);
+        }
+        else{
+            releaseLargePages(elements, byteCount);
+        }
+    }
+    
+    /** \brief Public method that constructs an element without a value by
+     * default-initialization, which leaves a numeric value uninitialized.
+     */
+    template<typename Object>
+    void construct(Object * object){
+        ::new(static_cast<void *>(object)) Object;
+    }
+    
+    /** \brief Public method that constructs an element from the specified
+     * arguments.
+     */
+    template<typename Object, typename... Arguments>
+    void construct(Object * object, Arguments &&... arguments){
+        ::new(static_cast<void *>(object)) Object(std::forward<Arguments>(arguments)...);
+    }
+    
+};
+
+/** \brief Equality operator. Any two LargePageAllocator objects can release
+ * each other's memory, so they always compare equal.
+ */
+template<typename Element, typename OtherElement>
+bool operator==(const LargePageAllocator<Element> &, const LargePageAllocator<OtherElement> &){
+    return true;
+}
+
+/** \brief Inequality operator, which is the negation of the equality
+ * operator.
+ */
+template<typename Element, typename OtherElement>
+bool operator!=(const LargePageAllocator<Element> &, const LargePageAllocator<OtherElement> &){
+    return false;
+}
+
+#endif /* End #ifndef LARGEPAGEALLOCATOR_H preprocessor conditional block. */
@@ -0,0 +1,74 @@
+// Define the ORDERSTATISTICS_H macro to act as an include guard
+#ifndef ORDERSTATISTICS_H
+#define ORDERSTATISTICS_H
+
+// Include the <cstddef> header to provide the std::size_t type.
+#include <cstddef>
+// Include the <cstdint> header to provide the std::int64_t type.
+#include <cstdint>
+// Include the <vector> header to provide the STL std::vector type.
+#include <vector>
+
+/** \brief Function that finds several order statistics of an array of values
+ * exactly, without sorting or modifying the array. The type of the values is
+ * a template parameter, which may be double, float or std::int64_t; the
+ * function is only instantiated for those types, in the implementation
+ * file.
+ *
+ * Requires four arguments:
+ * 1) values - A pointer to the first element of the array, which must not
+ *    contain NaN.
+ * 2) count - The number of elements in the array.
+ * 3) ranks - The zero-based ranks of the required order statistics, in any
+ *    order. Rank zero is the smallest element and rank count-1 the largest.
+ *    Every rank must be less than "count".
+ * 4) threadCount - The number of worker threads among which the array is
+ *    divided.
+ *
+ * Returns the order statistics in the same order as "ranks". Every rank is
+ * found by a single pass over the array, however many ranks are requested.
+ */
+template<typename Element>
+std::vector<double> selectOrderStatistics(const Element * values, std::size_t count,
+                                          const std::vector<std::size_t> & ranks,
+                                          unsigned int threadCount);
+
+/** \brief Function that computes several quantiles of an array of values
+ * exactly, interpolating linearly between the two nearest order statistics.
+ * The type of the values may be double, float or std::int64_t, and the
+ * quantiles are returned in double precision.
+ *
+ * Requires five arguments:
+ * 1) values - A pointer to the first element of the array, which must not
+ *    contain NaN.
+ * 2) count - The number of elements in the array.
+ * 3) probabilities - The fractions of the values that lie below each
+ *    quantile, between zero and one.
+ * 4) threadCount - The number of worker threads used if the array must be
+ *    searched.
+ * 5) valuesAreSorted - true if the array is already sorted into ascending
+ *    order, in which case the quantiles are read directly.
+ *
+ * Returns the quantiles in the same order as "probabilities", or NaN for
+ * every quantile if the array is empty.
+ */
+template<typename Element>
+std::vector<double> computeExactQuantiles(const Element * values, std::size_t count,
+                                          const std::vector<double> & probabilities,
+                                          unsigned int threadCount,
+                                          bool valuesAreSorted);
+
+/** \brief Function that sorts an array of values, of type double, float or
+ * std::int64_t, into ascending order, sorting separate parts of the array on separate worker
+ * threads and then merging them.
+ *
+ * Requires three arguments:
+ * 1) values - A pointer to the first element of the array, which must not
+ *    contain NaN.
+ * 2) count - The number of elements in the array.
+ * 3) threadCount - The number of worker threads.
+ */
+template<typename Element>
+void sortValuesInParallel(Element * values, std::size_t count, unsigned int threadCount);
+
+#endif /* End #ifndef ORDERSTATISTICS_H preprocessor conditional block. */
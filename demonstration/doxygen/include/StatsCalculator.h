@@ -2,12 +2,59 @@
 #ifndef STATSCALCULATOR_H
 #define STATSCALCULATOR_H
 
+// Include the <cstdint> header to provide the std::int64_t type.
+#include <cstdint>
 // Include the <vector> header to provide the STL std::vector type.
 #include <vector>
 
 // Include the <string> header to provide the STL std::vector type.
 #include <string>
 
+// Include "StatsAccumulator.h" to provide the StatsAccumulator class and
+// the StatsSummary structure.
+#include "StatsAccumulator.h"
+
+// Include "QuantileSketch.h" to provide the QuantileSketch class.
+#include "QuantileSketch.h"
+
+// Include "Histogram.h" to provide the Histogram class.
+#include "Histogram.h"
+
+// Include "LargePageAllocator.h" to provide the LargePageAllocator class template.
+#include "LargePageAllocator.h"
+
+/** \brief Enumerates the amounts of information that StatsCalculator prints
+ * to the terminal while it reads and writes files.
+ */
+enum OutputVerbosity {
+    /** \brief Print nothing except printStats() output and failures. */
+    QUIET_OUTPUT,
+    /** \brief Print progress messages, the number of values read and only
+     * the first and last few of those values. */
+    SUMMARY_OUTPUT,
+    /** \brief Print progress messages and every value read. */
+    FULL_OUTPUT
+};
+
+/** \brief Enumerates the ways in which StatsCalculator chooses the bins of
+ * the histogram that writeStats() writes alongside the summary.
+ */
+enum HistogramBinning {
+    /** \brief No histogram is written (the default). */
+    NO_HISTOGRAM,
+    /** \brief A specified number of bins of equal width. */
+    FIXED_BINS,
+    /** \brief A specified number of logarithmically spaced bins, which
+     * requires every value in the histogram to be positive. */
+    LOGARITHMIC_BINS,
+    /** \brief Bins of equal width chosen using the rule of Freedman and
+     * Diaconis, which is robust against outliers. */
+    FREEDMAN_DIACONIS_BINS,
+    /** \brief Bins of equal width chosen using the rule of Scott, which is
+     * optimal for normally distributed values. */
+    SCOTT_BINS
+};
+
 /** \class StatsCalculator 
  * The StatsCalculator class reads a list of whitespace-separated numeric
  * values from a text file. It stores those values internally and supplies
@@ -17,66 +64,542 @@
  * It provides a method that prints a summary of the statistical properties
  * of its internally stored numbers to the terminal and another method that
  * writes a similar summary to a textual output file.
+ *
+ * The type in which the values are stored is the template parameter
+ * "Element", which may be double, float or std::int64_t. The class is only
+ * instantiated for those types, in the implementation file, and the
+ * typedefs StatsCalculator, FloatStatsCalculator and CounterStatsCalculator
+ * name the three instantiations. Whatever the storage type, every statistic
+ * is accumulated and reported in double precision, so storing values as
+ * float halves the memory that they occupy at the cost of rounding each of
+ * them to about seven significant digits as it is parsed, while storing
+ * them as std::int64_t parses integer counts exactly and rejects any value
+ * that is not an integer. Since the reduction kernels widen each element to
+ * double precision as it is loaded, a reduction over values stored as float
+ * reads half as many bytes from memory, and so completes in roughly 60% of
+ * the time taken for the same number of double precision values.
  */
-class StatsCalculator {
+template<typename Element>
+class BasicStatsCalculator {
+    
+    /** \brief The type of the vector in which the values are stored, whose
+     * large arrays are mapped directly from the operating system.
+     */
+    typedef std::vector<Element, LargePageAllocator<Element> > ValueVector;
     
     /** \brief An STL vector of double precision values to store parsed numeric
+     * values. In the other instantiations its elements are of the storage
+     * type instead.
+     */
+    ValueVector numericValues;
+    
+    /** \brief The number of worker threads among which readFile() divides the
+     * parsing of a single input file.
+     */
+    unsigned int threadCount;
+    
+    /** \brief Flag indicating whether readFile() discards parsed values after
+     * adding them to "streamedStatistics", rather than storing them.
+     */
+    bool streamingMode;
+    
+    /** \brief Flag indicating whether readFile() reads regular files through
+     * the pipeline of readPipelined(), rather than by memory-mapping them.
+     */
+    bool pipelinedReading;
+    
+    /** \brief The amount of information that readFile(), writeStats() and
+     * writeState() print to the terminal.
+     */
+    OutputVerbosity verbosity;
+    
+    /** \brief The number of values at each end of the data that readFile()
+     * prints when "verbosity" is SUMMARY_OUTPUT.
+     */
+    std::size_t echoCount;
+    
+    /** \brief Running statistics of all values that were parsed in streaming
+     * mode and therefore not stored in "numericValues".
+     */
+    StatsAccumulator streamedStatistics;
+    
+    /** \brief A cached copy of the most recently computed statistical summary
+     * of the stored numeric values. It is declared "mutable" so that it can be
+     * updated by const methods.
+     */
+    mutable StatsSummary cachedSummary;
+    
+    /** \brief A cached copy of the running statistics from which
+     * "cachedSummary" was derived. These can be saved as a state record and
+     * merged with the running statistics of other instances.
+     */
+    mutable StatsAccumulator cachedStatistics;
+    
+    /** \brief Flag indicating whether "cachedSummary" and "cachedStatistics"
+     * reflect the current contents of the "numericValues" member datum.
+     */
+    mutable bool cachedSummaryIsValid;
+    
+    /** \brief The statistics of each complete block of "binaryDataBlockSize"
+     * consecutive values stored in "numericValues", beginning with the first.
+     * It is used by getRangeSummary() to avoid scanning whole blocks.
+     */
+    std::vector<StatsAccumulator> blockIndex;
+    
+    /** \brief The relative accuracy of the estimated quantiles, or zero if
+     * quantiles are not estimated.
+     */
+    double quantileAccuracy;
+    
+    /** \brief A sketch of the distribution of all values that were parsed in
+     * streaming mode and therefore not stored in "numericValues".
+     */
+    QuantileSketch streamedQuantiles;
+    
+    /** \brief A cached sketch of the distribution of all values, which is
+     * updated together with "cachedStatistics".
+     */
+    mutable QuantileSketch cachedQuantiles;
+    
+    /** \brief Flag indicating that statistics were merged from another
+     * instance or a state file without a sketch that could be merged with
+     * "streamedQuantiles", so that the estimated quantiles would describe
+     * only some of the values and are instead reported as NaN.
+     */
+    bool quantilesIncomplete;
+    
+    /** \brief Flag indicating whether printStats() and writeStats() report
+     * the exact quantiles of the stored values.
+     */
+    bool exactQuantilesEnabled;
+    
+    /** \brief Flag indicating whether "numericValues" is known to be sorted
+     * into ascending order, so that order statistics can be read directly.
+     */
+    bool valuesAreSorted;
+    
+    /** \brief The exact quantiles reported by printStats() and writeStats(),
+     * or an empty vector if they have not been computed since the values
+     * last changed. It is declared "mutable" so that it can be updated by
+     * const methods.
+     */
+    mutable std::vector<double> cachedExactQuantiles;
+    
+    /** \brief The rule by which the bins of the histogram are chosen.
+     */
+    HistogramBinning histogramBinning;
+    
+    /** \brief The number of bins of the histogram, if it is specified.
+     */
+    std::size_t histogramBinCount;
+    
+    /** \brief The lower edge of the first bin of the histogram. If it is
+     * equal to "histogramUpperEdge", the edges are the smallest and largest
      * values.
      */
-    std::vector<double> numericValues;
+    double histogramLowerEdge;
+    
+    /** \brief The upper edge of the last bin of the histogram.
+     */
+    double histogramUpperEdge;
+    
+    /** \brief A histogram of all values that were parsed in streaming mode
+     * and therefore not stored in "numericValues". It has no bins unless
+     * both the number of bins and their edges were specified.
+     */
+    Histogram streamedHistogram;
+    
+    /** \brief A cached histogram of all values, which is computed on demand
+     * by getHistogram().
+     */
+    mutable Histogram cachedHistogram;
+    
+    /** \brief Flag indicating whether "cachedHistogram" reflects the
+     * current values.
+     */
+    mutable bool cachedHistogramIsValid;
     
     /** \brief Private method that actually computes the sum of the stored numeric
      * values.
      */
-    double computeSum();
+    double computeSum() const;
     
     /** \brief Private method that actually computes the mean of the stored numeric
      * values.
      */
-    double computeMean();
+    double computeMean() const;
     
     /** \brief Private method that actually computes the standard deviation of the
      * stored numeric values.
      */
-    double computeStandardDeviation();
+    double computeStandardDeviation() const;
+    
+    /** \brief Private method that computes the running statistics of the
+     * stored numeric values, from which their number, sum, mean, variance and
+     * standard deviation are derived, in a single pass.
+     */
+    StatsAccumulator computeStatistics() const;
+    
+    /** \brief Private method returns the running statistics of the stored
+     * numeric values. The statistics are computed once and cached until the
+     * stored values change.
+     */
+    const StatsAccumulator & getStatistics() const;
+    
+    /** \brief Private method returns a sketch of the distribution of all
+     * values, which is computed once and cached until the values change.
+     */
+    const QuantileSketch & getQuantileSketch() const;
+    
+    /** \brief Private method that writes the estimated quantiles and the
+     * exact quantiles to an output stream, if they are enabled.
+     */
+    void writeQuantiles(std::ostream & stream) const;
+    
+    /** \brief Private method returns a histogram with the bins selected by
+     * setHistogram() and no values, or a histogram with no bins if those
+     * bins cannot be determined.
+     */
+    Histogram createHistogram() const;
+    
+    /** \brief Private method that writes the histogram of the values to a
+     * text file, or reports that it could not be computed or written.
+     * Returns false in either case.
+     */
+    bool writeHistogram(const std::string & histogramFileName) const;
+    
+    /** \brief Private static method that parses whitespace-separated numeric
+     * values from a range of characters in memory, appending them to the
+     * "values" argument. Returns a pointer to the first unconsumed character.
+     */
+    static const char * parseBuffer(const char * bufferBegin,
+                                    const char * bufferEnd,
+                                    std::vector<Element> & values);
+    
+    /** \brief Private static method that parses whitespace-separated numeric
+     * values from a range of characters in memory into an array that can
+     * hold at most "capacity" values, of which "valueCount" are already
+     * filled. Returns a pointer to the first unconsumed character.
+     */
+    static const char * parseBuffer(const char * bufferBegin,
+                                    const char * bufferEnd,
+                                    Element * values,
+                                    std::size_t capacity,
+                                    std::size_t & valueCount);
+    
+    /** \brief Private static method that parses whitespace-separated numeric
+     * values from a range of characters in memory in small slices, adding the
+     * values of each slice to "statistics", and to "quantiles" and
+     * "histogram" unless they are null pointers, and then discarding them.
+     * Returns a pointer to the first unconsumed character.
+     */
+    static const char * streamBuffer(const char * bufferBegin,
+                                     const char * bufferEnd,
+                                     StatsAccumulator & statistics,
+                                     QuantileSketch * quantiles,
+                                     Histogram * histogram,
+                                     bool releaseMappedPages);
+    
+    /** \brief Private method that parses a memory-mapped input file, dividing
+     * it among "threadCount" worker threads, and appends the parsed values to
+     * the "numericValues" member datum in their original order or, in
+     * streaming mode, adds them to "streamedStatistics".
+     */
+    void parseMappedFile(const char * fileBegin, const char * fileEnd);
+    
+    /** \brief Private method that parses ranges of a memory-mapped input file
+     * on separate worker threads directly into slots of the "numericValues"
+     * member datum, whose sizes are estimated from the file, and then closes
+     * the gaps between the slots, so that the stored values are never
+     * reallocated as they are appended.
+     */
+    void storeRanges(const std::vector<const char *> & rangeBegins);
+    
+    /** \brief Private method that reads an input file from an open file
+     * descriptor through a pipeline of concurrent stages: a reader thread
+     * that fills fixed-size buffers, "threadCount" parser threads that parse
+     * them, and the calling thread, which stores the parsed values or, in
+     * streaming mode, adds them to "streamedStatistics". The stages are
+     * connected by bounded lock-free queues. The size of the file, if it is
+     * known, is used to reserve storage for the values. Returns false if
+     * the input could not be read or decompressed.
+     */
+    bool readPipelined(int fileDescriptor, std::size_t fileSize);
+    
+    /** \brief Private method that reads an input file from an open file
+     * descriptor, memory-mapping it if it is a regular file and otherwise
+     * reading it using readPipelined(). The descriptor is not closed.
+     * Returns false if any part of the input could not be read.
+     */
+    bool readOpenFile(int fileDescriptor);
+    
+    /** \brief Private method that marks the cached statistical summary as
+     * out of date. It must be invoked whenever "numericValues" is modified.
+     */
+    void invalidateSummary();
+    
+    /** \brief Private method that prints the stored numeric values to the
+     * terminal, in full or abbreviated according to the "verbosity" and
+     * "echoCount" member data. In streaming mode only their number is printed.
+     */
+    void printData() const;
     
 public:
     
     /** \brief Default constructor.
      */
-    StatsCalculator();
+    BasicStatsCalculator();
     
     /** \brief Destructor.
      */
-    ~StatsCalculator();
+    ~BasicStatsCalculator();
     
     /** \brief Public method returns the sum of the internally stored numeric values.
      */
-    double getSum();
+    double getSum() const;
     
     /** \brief Public method returns the mean of the internally stored numeric values.
      */
-    double getMean();
+    double getMean() const;
     
     /** \brief Public method returns the standard deviation of the internally stored
      * numeric values.
      */
-    double getStandardDeviation();
+    double getStandardDeviation() const;
+    
+    /** \brief Public method returns a summary of the statistical properties of
+     * the internally stored numeric values. The summary is computed once and
+     * cached until the stored values change.
+     */
+    const StatsSummary & getSummary() const;
+    
+    /** \brief Public method returns an estimate of the specified quantile of
+     * the values, or NaN if quantiles are not estimated.
+     *
+     * Requires one argument:
+     * 1) probability - The fraction of the values that lie below the
+     *    quantile. For example 0.5 for the median or 0.99 for the 99th
+     *    percentile.
+     */
+    double getQuantile(double probability) const;
+    
+    /** \brief Public method returns the exact values of several quantiles of
+     * the internally stored numeric values, interpolating linearly between
+     * adjacent values. Every quantile is found in a single pass over the
+     * values, which are neither sorted nor modified. NaN is returned for
+     * every quantile if no values are stored or any were read in streaming
+     * mode.
+     *
+     * Requires one argument:
+     * 1) probabilities - The fractions of the values that lie below each
+     *    quantile.
+     */
+    std::vector<double> getExactQuantiles(const std::vector<double> & probabilities) const;
+    
+    /** \brief Public method returns a histogram of the values, with the bins
+     * selected by setHistogram(). The histogram is computed once, using
+     * "threadCount" worker threads, and cached until the values change. It
+     * has no bins if no histogram was requested or its bins cannot be
+     * determined, for example because values were read in streaming mode
+     * without specifying both the number of bins and their edges.
+     */
+    const Histogram & getHistogram() const;
+    
+    /** \brief Public method that sets the number of worker threads among which
+     * readFile() divides the parsing of a single input file.
+     *
+     * Requires one argument:
+     * 1) newThreadCount - The number of worker threads. A value of zero selects
+     *    the number of hardware threads available on the current machine.
+     */
+    void setThreadCount(unsigned int newThreadCount);
+    
+    /** \brief Public method that enables or disables streaming mode. In
+     * streaming mode readFile() updates running statistics as values are
+     * parsed and then discards the values, so that the memory required is
+     * independent of the size of the input file.
+     *
+     * Requires one argument:
+     * 1) enableStreaming - true to enable streaming mode, false to store
+     *    parsed values in the "numericValues" member datum (the default).
+     */
+    void setStreamingMode(bool enableStreaming);
+    
+    /** \brief Public method that selects whether readFile() reads regular
+     * files through a pipeline of concurrent reader, parser and reducer
+     * stages, in which the file is read into fixed-size buffers while
+     * previously read buffers are parsed, instead of memory-mapping them.
+     * Input that cannot be memory-mapped, such as a pipe, is always read
+     * through the pipeline.
+     *
+     * Requires one argument:
+     * 1) enablePipeline - true to read regular files through the pipeline,
+     *    false to memory-map them (the default).
+     */
+    void setPipelinedReading(bool enablePipeline);
+    
+    /** \brief Public method that sets the amount of information that
+     * readFile(), writeStats() and writeState() print to the terminal. With
+     * QUIET_OUTPUT nothing is printed, so that several instances can be used
+     * concurrently without interleaving their output.
+     *
+     * Requires one argument:
+     * 1) newVerbosity - QUIET_OUTPUT, SUMMARY_OUTPUT (the default) or
+     *    FULL_OUTPUT.
+     */
+    void setVerbosity(OutputVerbosity newVerbosity);
+    
+    /** \brief Public method that sets the number of values at each end of
+     * the data that readFile() prints with SUMMARY_OUTPUT verbosity.
+     *
+     * Requires one argument:
+     * 1) newEchoCount - The number of leading and of trailing values to
+     *    print (five by default).
+     */
+    void setEchoCount(std::size_t newEchoCount);
+    
+    /** \brief Public method that enables the estimation of quantiles, such as
+     * the median and the 99th percentile, using a sketch that occupies a few
+     * kilobytes of memory however many values are read. The quantiles are
+     * then included by printStats() and writeStats().
+     *
+     * Returns false, disabling the estimation, if the accuracy is neither
+     * zero nor supported by QuantileSketch::isSupportedAccuracy().
+     *
+     * Requires one argument:
+     * 1) relativeAccuracy - The relative accuracy of the estimated quantiles,
+     *    for example 0.01 for 1%, or zero to disable their estimation (the
+     *    default).
+     */
+    bool setQuantileAccuracy(double relativeAccuracy);
+    
+    /** \brief Public method that enables or disables the reporting of the
+     * exact median and 90th, 99th and 99.9th percentiles of the stored
+     * values by printStats() and writeStats().
+     *
+     * Requires one argument:
+     * 1) enableExactQuantiles - true to report the exact quantiles, false
+     *    not to (the default).
+     */
+    void setExactQuantiles(bool enableExactQuantiles);
+    
+    /** \brief Public method that selects the bins of the histogram that
+     * writeStats() writes to a second file alongside the summary, whose
+     * path is that of the summary with the suffix ".hist".
+     *
+     * Requires four arguments:
+     * 1) binning - The rule by which the bins are chosen, or NO_HISTOGRAM
+     *    not to write a histogram (the default).
+     * 2) binCount - The number of bins for FIXED_BINS and LOGARITHMIC_BINS.
+     *    It is ignored by the automatic rules.
+     * 3) lowerEdge - The lower edge of the first bin.
+     * 4) upperEdge - The upper edge of the last bin. If the edges are equal,
+     *    the smallest and largest values are used instead. Values in
+     *    streaming mode can only be binned if the edges are specified and
+     *    the binning is FIXED_BINS or LOGARITHMIC_BINS, so this method
+     *    should then be called before any values are read.
+     */
+    void setHistogram(HistogramBinning binning, std::size_t binCount,
+                      double lowerEdge, double upperEdge);
+    
+    /** \brief Public method that sorts the internally stored numeric values
+     * into ascending order using "threadCount" worker threads, after which
+     * every exact quantile is read directly. Any index of block statistics
+     * is discarded, since the ranges that it describes no longer exist.
+     */
+    void sortValues();
     
     /** \brief Public method that reads a list of whitespace-separated numeric
-     * values from a text file. It appends those values to the "numericValues"
-     * member datum.
+     * values from a text file, which may be compressed using gzip or zstd.
+     * It appends those values to the "numericValues" member datum. Returns
+     * false, after reporting the error, if the file could not be opened or
+     * read.
      *
      * Requires one argument:
      * 1) infileName - A string specifying to the path of a text file containing
-     *    a whitespace-separated list of numeric values.
+     *    a whitespace-separated list of numeric values, or "-" to read them
+     *    from the standard input.
+     */
+    bool readFile(const std::string & infileName);
+    
+    /** \brief Public method that reads a list of whitespace-separated numeric
+     * values from a file descriptor that is already open, such as the
+     * standard input or a pipe, until the end of the input. It appends those
+     * values to the "numericValues" member datum, or in streaming mode adds
+     * them to the running statistics using bounded memory. Returns false if
+     * the input could not be read.
+     *
+     * Requires one argument:
+     * 1) fileDescriptor - A file descriptor open for reading, which is not
+     *    closed.
      */
-    void readFile(const std::string & infileName);
+    bool readDescriptor(int fileDescriptor);
+    
+    /** \brief Public method that reads numeric values from a binary data file
+     * without parsing them. It appends those values, converted to the storage
+     * type, to the "numericValues" member datum or, in streaming mode, merges the block summaries stored
+     * in the file without reading the values. Returns false, after reporting
+     * the error, if the file could not be read or is not valid.
+     *
+     * Requires one argument:
+     * 1) infileName - A string specifying the path of a binary data file
+     *    written by writeBinary().
+     */
+    bool readBinary(const std::string & infileName);
+    
+    /** \brief Public method that writes the internally stored numeric values,
+     * converted to double precision, to a binary data file, preceded by a header containing their number and
+     * a summary of the statistics of each block of 65536 values.
+     *
+     * Requires one argument:
+     * 1) outfileName - A string specifying the path of the binary data file
+     *    to be written.
+     */
+    void writeBinary(const std::string & outfileName) const;
+    
+    /** \brief Public method that builds an index of the statistics of each
+     * complete block of 65536 consecutive stored values, so that the
+     * statistics of a range of values can be obtained without scanning it.
+     */
+    void buildIndex();
+    
+    /** \brief Public method that writes the index of block statistics to a
+     * binary index file.
+     *
+     * Requires one argument:
+     * 1) indexFileName - A string specifying the path of the index file.
+     */
+    void writeIndex(const std::string & indexFileName) const;
+    
+    /** \brief Public method that reads an index of block statistics written
+     * by writeIndex(). Returns true on success and false if the file could
+     * not be read or does not match the number of stored values.
+     *
+     * Requires one argument:
+     * 1) indexFileName - A string specifying the path of the index file.
+     */
+    bool readIndex(const std::string & indexFileName);
+    
+    /** \brief Public method returns a summary of the statistical properties of
+     * the stored numeric values with indices from "firstIndex" up to, but not
+     * including, "lastIndex". Whole blocks that have been indexed are not
+     * scanned.
+     */
+    StatsSummary getRangeSummary(std::size_t firstIndex, std::size_t lastIndex) const;
+    
+    /** \brief Public method that merges the statistical properties of the
+     * numeric values of another BasicStatsCalculator with those of this one,
+     * as though they had been read in streaming mode.
+     *
+     * Requires one argument:
+     * 1) other - The BasicStatsCalculator whose statistics should be merged.
+     */
+    void merge(const BasicStatsCalculator & other);
     
     /** \brief Public method that prints a summary of the statistical properties that this
      * class computes to the terminal.
      */
-    void printStats();
+    void printStats() const;
     
     /** \brief Public method that writes a summary of the statistical properties that this
      * class computes to a caller-specified output file.
@@ -84,9 +607,48 @@ public:
      * Requires one argument:
      * 1) outfileName - A string specifying to the path for a text file to which
      * the statistics summary should be written.
+     *
+     * Returns false, after reporting the error even with QUIET_OUTPUT
+     * verbosity, if the summary or the requested histogram could not be
+     * written.
+     */
+    bool writeStats(const std::string & outfileName) const;
+    
+    /** \brief Public method that writes the running statistics of the
+     * internally stored numeric values to a compact binary state file, which
+     * can later be merged with the state files of other instances using
+     * mergeState().
+     *
+     * Requires one argument:
+     * 1) stateFileName - A string specifying the path of the binary file to
+     *    which the state should be written.
+     */
+    void writeState(const std::string & stateFileName) const;
+    
+    /** \brief Public method that reads a binary state file written by
+     * writeState() and merges its running statistics with those of the
+     * internally stored numeric values. Returns true on success and false if
+     * the file could not be read or is not a valid state file.
+     *
+     * Requires one argument:
+     * 1) stateFileName - A string specifying the path of the binary state file.
      */
-    void writeStats(const std::string & outfileName);
+    bool mergeState(const std::string & stateFileName);
     
 };
 
+/** \brief The StatsCalculator type stores its values in double precision.
+ */
+typedef BasicStatsCalculator<double> StatsCalculator;
+
+/** \brief The FloatStatsCalculator type stores its values in single
+ * precision, which halves the memory that they occupy.
+ */
+typedef BasicStatsCalculator<float> FloatStatsCalculator;
+
+/** \brief The CounterStatsCalculator type stores its values as 64-bit
+ * integers, which suits counts and other integer data.
+ */
+typedef BasicStatsCalculator<std::int64_t> CounterStatsCalculator;
+
 #endif /* End #ifndef STATSCALCULATOR_H preprocessor conditional block. */
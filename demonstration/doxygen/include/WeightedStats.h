@@ -0,0 +1,131 @@
+// Define the WEIGHTEDSTATS_H macro to act as an include guard
+#ifndef WEIGHTEDSTATS_H
+#define WEIGHTEDSTATS_H
+
+// Include the <iosfwd> header to declare the std::ostream type.
+#include <iosfwd>
+// Include the <string> header to provide the STL std::string type.
+#include <string>
+
+// Include "StatsCalculator.h" to provide the OutputVerbosity enumeration.
+#include "StatsCalculator.h"
+// Include "WeightedStatsAccumulator.h" to provide the WeightedStatsAccumulator class.
+#include "WeightedStatsAccumulator.h"
+
+/** \class WeightedStats
+ * The WeightedStats class reads a text file whose lines each contain a
+ * numeric value followed by its non-negative weight, for example the number
+ * of events with that value, separated either by a comma or by whitespace.
+ * An optional header line names the two columns, and lines that are empty
+ * or begin with "#" are ignored.
+ *
+ * The pairs are not stored, and the values are never repeated according to
+ * their weights. Instead they are accumulated, as they are parsed, into a
+ * WeightedStatsAccumulator. The file is divided among several worker
+ * threads, each of which fills its own accumulator, and the accumulators
+ * are merged when every thread has finished, so the whole file is read in a
+ * single pass using memory that is independent of its length.
+ */
+class WeightedStats {
+    
+    /** \brief The running statistics of the weighted values.
+     */
+    WeightedStatsAccumulator statistics;
+    
+    /** \brief The name of the value column, taken from the header line or, if
+     * there is none, equal to "Value".
+     */
+    std::string valueName;
+    
+    /** \brief The name of the weight column, taken from the header line or,
+     * if there is none, equal to "Weight".
+     */
+    std::string weightName;
+    
+    /** \brief The number of worker threads among which readFile() divides
+     * the parsing of the input file.
+     */
+    unsigned int threadCount;
+    
+    /** \brief The amount of information that readFile() and writeStats()
+     * print to the terminal.
+     */
+    OutputVerbosity verbosity;
+    
+    /** \brief Private static method that parses lines containing a value and
+     * a weight from a range of characters that begins at the start of a
+     * line, adding each weighted value to "accumulator". Returns a pointer
+     * to the start of the first line that could not be parsed, or to the end
+     * of the range.
+     */
+    static const char * parseRows(const char * bufferBegin, const char * bufferEnd,
+                                  char separator, WeightedStatsAccumulator & accumulator);
+    
+    /** \brief Private method that writes the summary of the weighted values
+     * to an output stream.
+     */
+    void writeSummary(std::ostream & stream) const;
+    
+public:
+    
+    /** \brief Default constructor. Creates an object with no values.
+     */
+    WeightedStats();
+    
+    /** \brief Public method that sets the number of worker threads.
+     *
+     * Requires one argument:
+     * 1) newThreadCount - The number of worker threads. A value of zero
+     *    selects the number of hardware threads available on the current
+     *    machine.
+     */
+    void setThreadCount(unsigned int newThreadCount);
+    
+    /** \brief Public method that sets the amount of information that
+     * readFile() and writeStats() print to the terminal.
+     *
+     * Requires one argument:
+     * 1) newVerbosity - QUIET_OUTPUT, or SUMMARY_OUTPUT (the default) or
+     *    FULL_OUTPUT, both of which print progress messages.
+     */
+    void setVerbosity(OutputVerbosity newVerbosity);
+    
+    /** \brief Public method that replaces the statistics with those of the
+     * weighted values of a text file. Returns true if every line of the file
+     * was parsed, and false if the file could not be read, in which case
+     * there are no values, or if a malformed line, or one with a negative
+     * weight, was encountered, in which case the values of the lines that
+     * precede it are retained.
+     *
+     * Requires one argument:
+     * 1) infileName - A string specifying the path of a text file whose
+     *    lines each contain a numeric value and its weight.
+     */
+    bool readFile(const std::string & infileName);
+    
+    /** \brief Public method returns the running statistics of the weighted
+     * values.
+     */
+    const WeightedStatsAccumulator & getStatistics() const;
+    
+    /** \brief Public method returns a summary of the statistical properties
+     * of the weighted values.
+     */
+    WeightedStatsSummary getSummary() const;
+    
+    /** \brief Public method that prints the summary of the weighted values
+     * to the terminal.
+     */
+    void printStats() const;
+    
+    /** \brief Public method that writes the summary of the weighted values
+     * to a text file.
+     *
+     * Requires one argument:
+     * 1) outfileName - A string specifying the path of the text file.
+     */
+    void writeStats(const std::string & outfileName) const;
+    
+};
+
+#endif /* End #ifndef WEIGHTEDSTATS_H preprocessor conditional block. */
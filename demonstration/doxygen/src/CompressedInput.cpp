@@ -0,0 +1,388 @@
+// IMPLEMENTATION file for the InputDecompressor class and the compressed input functions
+
+// STL HEADER FILES
+
+// The <algorithm> header is included to provide the std::copy(...) function.
+#include <algorithm>
+// The <cerrno> header is included to provide the errno macro.
+#include <cerrno>
+
+// POSIX HEADER FILES
+
+// The <unistd.h> header is included to provide the read(...) function.
+#include <unistd.h>
+
+// LIBRARY HEADER FILES
+
+/* The <zlib.h> header is included to provide the inflate(...) function and
+ * the z_stream type. The zlib library is optional, so it is only used if the
+ * COMPRESSED_INPUT_GZIP macro is defined when this file is compiled, in
+ * which case the program must also be linked with -lz.
+ */
+#ifdef COMPRESSED_INPUT_GZIP
+#include <zlib.h>
+#endif
+
+/* The <zstd.h> header is included to provide the ZSTD_decompressStream(...)
+ * function. The zstd library is optional, so it is only used if the
+ * COMPRESSED_INPUT_ZSTD macro is defined when this file is compiled, in
+ * which case the program must also be linked with -lzstd.
+ */
+#ifdef COMPRESSED_INPUT_ZSTD
+#include <zstd.h>
+#endif
+
+// LOCAL HEADER FILES
+
+/* The "CompressedInput.h" header is included to provide a definition of the
+ * InputDecompressor class and declarations of the functions that are
+ * defined in this file.
+ */
+#include "CompressedInput.h"
+
+// CONSTANTS
+
+/* The magic numbers with which every gzip member and every zstd frame
+ * begins.
+ */
+static const unsigned char gzipMagic[2] = {0x1f, 0x8b};
+static const unsigned char zstdMagic[4] = {0x28, 0xb5, 0x2f, 0xfd};
+
+/* The number of characters of compressed input that are read from the file
+ * descriptor at once. Since the input is typically several times smaller
+ * than the characters that it decompresses to, it is read in smaller blocks
+ * than the buffers of the reading pipeline.
+ */
+static const std::size_t compressedInputBufferSize = 1 << 20;
+
+// HELPER FUNCTIONS
+
+/** Helper function that returns true if a sequence of bytes begins with a
+ * magic number.
+ *
+ * \param bytes - A pointer to the first byte of the sequence.
+ * \param byteCount - The number of bytes in the sequence.
+ * \param magic - A pointer to the first byte of the magic number.
+ * \param magicSize - The number of bytes in the magic number.
+ */
+static bool beginsWithMagic(const char * bytes, std::size_t byteCount,
+                            const unsigned char * magic, std::size_t magicSize){
+    if(byteCount < magicSize){
+        return false;
+    }
+    for(std::size_t byteIndex = 0; byteIndex < magicSize; ++byteIndex){
+        if(static_cast<unsigned char>(bytes[byteIndex]) != magic[byteIndex]){
+            return false;
+        }
+    }
+    return true;
+}
+
+// PUBLIC FUNCTIONS
+
+/** Function that identifies the format in which an input file is compressed
+ * from the magic number with which it begins.
+ *
+ * \param leadingBytes - A pointer to the first bytes of the input file.
+ * \param byteCount - The number of bytes available.
+ *
+ * \return The format of the input, or UNCOMPRESSED_INPUT if it does not
+ * begin with a recognized magic number. Neither magic number begins with a
+ * character that can occur in a list of numeric values, so a text file is
+ * never mistaken for a compressed one.
+ */
+InputCompression detectInputCompression(const char * leadingBytes, std::size_t byteCount){
+    if(beginsWithMagic(leadingBytes, byteCount, gzipMagic, sizeof(gzipMagic))){
+        return GZIP_INPUT;
+    }
+    if(beginsWithMagic(leadingBytes, byteCount, zstdMagic, sizeof(zstdMagic))){
+        return ZSTD_INPUT;
+    }
+    return UNCOMPRESSED_INPUT;
+}
+
+/** Function that reports whether input in the specified format can be
+ * decompressed by this build of the program.
+ *
+ * \param compression - The format of the input.
+ *
+ * \return true if the input is not compressed, if it is compressed using
+ * gzip and the program was compiled with the COMPRESSED_INPUT_GZIP macro
+ * defined, or if it is compressed using zstd and the program was compiled
+ * with the COMPRESSED_INPUT_ZSTD macro defined.
+ */
+bool isInputCompressionSupported(InputCompression compression){
+    switch(compression){
+        case GZIP_INPUT:
+#ifdef COMPRESSED_INPUT_GZIP
+            return true;
+#else
+            return false;
+#endif
+        case ZSTD_INPUT:
+#ifdef COMPRESSED_INPUT_ZSTD
+            return true;
+#else
+            return false;
+#endif
+        default:
+            return true;
+    }
+}
+
+/** Function that returns a short, human-readable name for a format.
+ *
+ * \param compression - The format of the input.
+ */
+const char * getInputCompressionName(InputCompression compression){
+    switch(compression){
+        case GZIP_INPUT:
+            return "gzip";
+        case ZSTD_INPUT:
+            return "zstd";
+        default:
+            return "uncompressed";
+    }
+}
+
+// PUBLIC METHODS OF INPUTDECOMPRESSOR
+
+/** Default constructor. Creates a decompressor that has not yet been
+ * started, and therefore produces no characters.
+ */
+InputDecompressor::InputDecompressor() : compression(UNCOMPRESSED_INPUT), fileDescriptor(-1),
+inputBegin(0), inputEnd(0), endOfInput(true), finished(true), failed(false),
+gzipStream(0), zstdContext(0) {
+    // No further initialization operations are required.
+}
+
+/** Destructor. Releases the state of the decompression, if one was
+ * started.
+ */
+InputDecompressor::~InputDecompressor(){
+#ifdef COMPRESSED_INPUT_GZIP
+    if(gzipStream){
+        inflateEnd(gzipStream);
+        delete gzipStream;
+    }
+#endif
+#ifdef COMPRESSED_INPUT_ZSTD
+    if(zstdContext){
+        ZSTD_freeDCtx(zstdContext);
+    }
+#endif
+}
+
+/** Public method that starts the decompression of an input.
+ *
+ * \param inputCompression - The format of the input.
+ * \param inputDescriptor - A file descriptor open for reading, from which
+ * the compressed input is read.
+ * \param leadingBytes - A pointer to the bytes at the beginning of the input
+ * that have already been read from the file descriptor.
+ * \param leadingByteCount - The number of those bytes.
+ *
+ * \return true on success, or false if the format is not supported or the
+ * state of the decompression could not be allocated.
+ *
+ * The leading bytes are copied to the beginning of the buffer of compressed
+ * input, so that they are decompressed before anything more is read.
+ */
+bool InputDecompressor::start(InputCompression inputCompression, int inputDescriptor,
+                              const char * leadingBytes, std::size_t leadingByteCount){
+    if(gzipStream || zstdContext || !isInputCompressionSupported(inputCompression) ||
+       inputCompression == UNCOMPRESSED_INPUT){
+        return false;
+    }
+    compression = inputCompression;
+    fileDescriptor = inputDescriptor;
+    compressedInput.resize(compressedInputBufferSize > leadingByteCount ?
+                           compressedInputBufferSize : leadingByteCount);
+    std::copy(leadingBytes, leadingBytes + leadingByteCount, compressedInput.begin());
+    inputBegin = 0;
+    inputEnd = leadingByteCount;
+    endOfInput = false;
+    finished = false;
+    failed = false;
+    
+#ifdef COMPRESSED_INPUT_GZIP
+    if(compression == GZIP_INPUT){
+        /* Adding 16 to the base-two logarithm of the size of the window
+         * instructs zlib to expect a gzip header and trailer, rather than
+         * the zlib format.
+         */
+        gzipStream = new z_stream();
+        if(inflateInit2(gzipStream, 15 + 16) != Z_OK){
+            delete gzipStream;
+            gzipStream = 0;
+            return false;
+        }
+        return true;
+    }
+#endif
+#ifdef COMPRESSED_INPUT_ZSTD
+    zstdContext = ZSTD_createDCtx();
+    return zstdContext != 0;
+#else
+    return false;
+#endif
+}
+
+/** Public method that decompresses the next characters of the input into a
+ * buffer.
+ *
+ * \param buffer - A pointer to the first character of the buffer.
+ * \param capacity - The number of characters that the buffer can hold.
+ *
+ * \return The number of characters produced, which is zero once the whole
+ * input has been decompressed, or -1 if the input could not be read or is
+ * not valid compressed data.
+ *
+ * Compressed input is read and decompressed until at least one character
+ * has been produced, so a return value of zero always means the end of the
+ * input, as it does for the POSIX read() function. Fewer characters than
+ * "capacity" may be produced even if the input has not ended.
+ */
+std::ptrdiff_t InputDecompressor::read(char * buffer, std::size_t capacity){
+    std::size_t producedCount(0);
+    while(producedCount == 0 && !finished && !failed){
+        // Read more compressed input once the buffered input is exhausted.
+        if(inputBegin == inputEnd && !endOfInput && !refillInput() && failed){
+            break;
+        }
+        producedCount = (compression == GZIP_INPUT) ? inflateGzip(buffer, capacity) :
+                                                      decompressZstd(buffer, capacity);
+    }
+    if(producedCount == 0 && failed){
+        return -1;
+    }
+    return static_cast<std::ptrdiff_t>(producedCount);
+}
+
+// PRIVATE METHODS OF INPUTDECOMPRESSOR
+
+/** Private method that reads more compressed input into the buffer.
+ *
+ * \return true if more input was read, or false if the end of the input
+ * was reached, in which case "endOfInput" is set, or if it could not be
+ * read, in which case "failed" is also set.
+ *
+ * Any buffered input that has not yet been decompressed is first moved to
+ * the beginning of the buffer, and the new input is appended to it.
+ */
+bool InputDecompressor::refillInput(){
+    std::copy(compressedInput.begin() + inputBegin, compressedInput.begin() + inputEnd,
+              compressedInput.begin());
+    inputEnd -= inputBegin;
+    inputBegin = 0;
+    for(;;){
+        ssize_t readSize = ::read(fileDescriptor, compressedInput.data() + inputEnd,
+                                  compressedInput.size() - inputEnd);
+        if(readSize > 0){
+            inputEnd += static_cast<std::size_t>(readSize);
+            return true;
+        }
+        if(readSize < 0 && errno == EINTR){
+            continue;
+        }
+        endOfInput = true;
+        failed = readSize < 0;
+        return false;
+    }
+}
+
+/** Private method that inflates as much of the buffered gzip input as fits
+ * in an output buffer.
+ *
+ * \param buffer - A pointer to the first character of the output buffer.
+ * \param capacity - The number of characters that it can hold.
+ *
+ * \return The number of characters produced.
+ *
+ * When a member ends, the decompression is reset if another member
+ * follows it. Anything else that follows the final member, such as the
+ * zeros with which some tools pad their output, is ignored, as it is by
+ * the gzip utility itself. An input that ends part of the way through a
+ * member is reported as a failure. Without the COMPRESSED_INPUT_GZIP macro,
+ * no gzip decompression is ever started and this method is never invoked.
+ */
+std::size_t InputDecompressor::inflateGzip(char * buffer, std::size_t capacity){
+#ifdef COMPRESSED_INPUT_GZIP
+    gzipStream->next_in = reinterpret_cast<Bytef *>(compressedInput.data() + inputBegin);
+    gzipStream->avail_in = static_cast<uInt>(inputEnd - inputBegin);
+    gzipStream->next_out = reinterpret_cast<Bytef *>(buffer);
+    gzipStream->avail_out = static_cast<uInt>(capacity);
+    int status = inflate(gzipStream, Z_NO_FLUSH);
+    inputBegin = inputEnd - gzipStream->avail_in;
+    std::size_t producedCount = capacity - gzipStream->avail_out;
+    
+    if(status == Z_STREAM_END){
+        /* Establish whether another member follows the one that has ended,
+         * reading enough input to examine its magic number.
+         */
+        while(inputEnd - inputBegin < sizeof(gzipMagic) && !endOfInput && refillInput()){
+            // Each iteration appends more input to the buffer.
+        }
+        if(beginsWithMagic(compressedInput.data() + inputBegin, inputEnd - inputBegin,
+                           gzipMagic, sizeof(gzipMagic))){
+            inflateReset(gzipStream);
+        }
+        else{
+            finished = true;
+        }
+    }
+    else if(status == Z_BUF_ERROR && producedCount == 0){
+        // No progress is possible, which is only a failure if the input has ended.
+        failed = endOfInput && inputBegin == inputEnd;
+    }
+    else if(status != Z_OK && status != Z_BUF_ERROR){
+        failed = true;
+    }
+    return producedCount;
+#else
+    (void)buffer;
+    (void)capacity;
+    failed = true;
+    return 0;
+#endif
+}
+
+/** Private method that decompresses as much of the buffered zstd input as
+ * fits in an output buffer.
+ *
+ * \param buffer - A pointer to the first character of the output buffer.
+ * \param capacity - The number of characters that it can hold.
+ *
+ * \return The number of characters produced.
+ *
+ * Concatenated frames are decompressed one after another without any reset.
+ * An input that ends part of the way through a frame is reported as a
+ * failure. Without the COMPRESSED_INPUT_ZSTD macro, no zstd decompression
+ * is ever started and this method is never invoked.
+ */
+std::size_t InputDecompressor::decompressZstd(char * buffer, std::size_t capacity){
+#ifdef COMPRESSED_INPUT_ZSTD
+    ZSTD_inBuffer input = {compressedInput.data() + inputBegin, inputEnd - inputBegin, 0};
+    ZSTD_outBuffer output = {buffer, capacity, 0};
+    std::size_t remainingHint = ZSTD_decompressStream(zstdContext, &output, &input);
+    inputBegin += input.pos;
+    if(ZSTD_isError(remainingHint)){
+        failed = true;
+    }
+    else if(inputBegin == inputEnd && endOfInput){
+        // The input has ended, which is only valid between frames.
+        if(remainingHint == 0){
+            finished = true;
+        }
+        else if(output.pos == 0){
+            failed = true;
+        }
+    }
+    return output.pos;
+#else
+    (void)buffer;
+    (void)capacity;
+    failed = true;
+    return 0;
+#endif
+}
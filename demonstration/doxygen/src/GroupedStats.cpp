@@ -0,0 +1,450 @@
+// IMPLEMENTATION file for the GroupedStats class
+
+// STL HEADER FILES
+
+/* The <algorithm> header is included to provide the std::count(...) and
+ * std::sort(...) functions.
+ */
+#include <algorithm>
+// The <fstream> header is included to enable output to files.
+#include <fstream>
+// The <iostream> header is included to enable textual terminal output.
+#include <iostream>
+// The <thread> header is included to provide the std::thread class.
+#include <thread>
+// The <vector> header is included to provide the STL std::vector type.
+#include <vector>
+
+// LOCAL HEADER FILES
+
+/* The "GroupedStats.h" header is included to provide a definition of the
+ * GroupedStats class.
+ */
+#include "GroupedStats.h"
+
+/* The "DelimitedText.h" header is included to provide the MappedTextFile
+ * class and the functions that divide a file into lines and fields.
+ */
+#include "DelimitedText.h"
+
+// CONSTANTS
+
+/* printStats() prints the statistics of at most this many groups, since a
+ * file may contain millions of distinct keys.
+ */
+static const std::size_t printedGroupCount = 10;
+
+/* parseRows() passes the keys and values that it parses to the table in
+ * batches of this many, so that the table can overlap their lookups.
+ */
+static const std::size_t parsedBatchSize = 256;
+
+// HELPER FUNCTIONS
+
+/** Helper function that divides a line into a key and the characters that
+ * follow it.
+ *
+ * \param lineBegin - A pointer to the first character of the line, which
+ * must not be whitespace.
+ * \param lineEnd - A pointer to the end of the line or of the buffer.
+ * \param separator - ',' if the fields are separated by a comma, or ' ' if
+ * they are separated by whitespace.
+ * \param key - Set to the key, without any surrounding whitespace or
+ * double quotes.
+ *
+ * \return A pointer to the first character of the value that follows the
+ * key and its separator, after any whitespace, or a null pointer if the
+ * key is empty or is not followed by a separator.
+ */
+static const char * splitKey(const char * lineBegin, const char * lineEnd, char separator,
+                             std::string_view & key){
+    const char * position = lineBegin;
+    while(position != lineEnd && *position != '\n' && *position != separator &&
+          !(separator == ' ' && isBlank(*position))){
+        ++position;
+    }
+    const char * keyEnd = position;
+    while(keyEnd != lineBegin && isBlank(*(keyEnd - 1))){
+        --keyEnd;
+    }
+    
+    // Remove any double quotes that enclose the key.
+    const char * keyBegin = lineBegin;
+    if(keyEnd - keyBegin >= 2 && *keyBegin == '"' && *(keyEnd - 1) == '"'){
+        ++keyBegin;
+        --keyEnd;
+    }
+    if(keyBegin == keyEnd){
+        return 0;
+    }
+    key = std::string_view(keyBegin, keyEnd - keyBegin);
+    
+    // Skip the separator and the whitespace that surrounds it.
+    if(separator == ','){
+        if(position == lineEnd || *position != ','){
+            return 0;
+        }
+        ++position;
+    }
+    else if(position == lineEnd || !isBlank(*position)){
+        return 0;
+    }
+    while(position != lineEnd && isBlank(*position)){
+        ++position;
+    }
+    return position;
+}
+
+// PRIVATE METHODS OF GROUPEDSTATS
+
+/** Private static method that parses lines containing a key and a value.
+ *
+ * \param bufferBegin - A pointer to the first character of the range, which
+ * must be the first character of a line.
+ * \param bufferEnd - A pointer one past the last character of the range,
+ * which must be the end of a line or of the file.
+ * \param separator - ',' if the key and value are separated by a comma,
+ * which may be surrounded by whitespace, or ' ' if they are separated by
+ * whitespace.
+ * \param table - The table to whose groups the values are added.
+ *
+ * \return A pointer to the first character of the first line that could not
+ * be parsed, or "bufferEnd" if every line was parsed.
+ *
+ * Every line must contain exactly one key followed by one value. A value is
+ * added to its group only when the whole line has been parsed, so a
+ * malformed line contributes nothing. Empty lines and lines that begin with
+ * "#" are skipped.
+ *
+ * The keys, which refer to the characters of the range, and the values are
+ * collected in batches, each of which is added to the table by a single
+ * call of GroupHashTable::addValues().
+ */
+const char * GroupedStats::parseRows(const char * bufferBegin, const char * bufferEnd,
+                                     char separator, GroupHashTable & table){
+    std::string_view batchKeys[parsedBatchSize];
+    double batchValues[parsedBatchSize];
+    std::size_t batchCount(0);
+    const char * lineBegin = bufferBegin;
+    while(lineBegin != bufferEnd){
+        
+        // Skip the whitespace that precedes the key.
+        const char * position = lineBegin;
+        while(position != bufferEnd && isBlank(*position)){
+            ++position;
+        }
+        
+        // Skip empty lines and comments.
+        if(position == bufferEnd || *position == '\n' || *position == '#'){
+            position = findLineEnd(position, bufferEnd);
+            lineBegin = (position == bufferEnd) ? bufferEnd : position + 1;
+            continue;
+        }
+        
+        // Parse the key and the value.
+        std::string_view key;
+        double value(0.0);
+        position = splitKey(position, bufferEnd, separator, key);
+        if(position){
+            position = parseValue(position, bufferEnd, value);
+        }
+        
+        // The line must end after the value.
+        while(position && position != bufferEnd && isBlank(*position)){
+            ++position;
+        }
+        if(!position || (position != bufferEnd && *position != '\n')){
+            table.addValues(batchKeys, batchValues, batchCount);
+            return lineBegin;
+        }
+        
+        // Add the batch to the table when it is full.
+        batchKeys[batchCount] = key;
+        batchValues[batchCount] = value;
+        if(++batchCount == parsedBatchSize){
+            table.addValues(batchKeys, batchValues, batchCount);
+            batchCount = 0;
+        }
+        lineBegin = (position == bufferEnd) ? bufferEnd : position + 1;
+    }
+    
+    table.addValues(batchKeys, batchValues, batchCount);
+    return bufferEnd;
+}
+
+/** Private method that writes the statistics of the groups to an output
+ * stream.
+ *
+ * \param stream - The stream to which the statistics are written.
+ * \param maximumGroupCount - The largest number of groups to be written.
+ *
+ * A heading states the number of values and groups. It is followed by a
+ * block of lines for each group, in the "Name = Value" format of the other
+ * statistical summaries, that give its key, under the name of the key column,
+ * the number of its values, and their sum, mean, standard deviation, minimum
+ * and maximum. If not every group is written, the number of the remaining
+ * groups is given last.
+ */
+void GroupedStats::writeGroups(std::ostream & stream, std::size_t maximumGroupCount) const {
+    
+    // Determine the order in which the groups are written.
+    std::vector<std::size_t> groupOrder(getGroupCount());
+    for(std::size_t groupIndex = 0; groupIndex < getGroupCount(); ++groupIndex){
+        groupOrder[groupIndex] = groupIndex;
+    }
+    if(sortedKeys){
+        std::sort(groupOrder.begin(), groupOrder.end(),
+                  [&](std::size_t firstIndex, std::size_t secondIndex){
+                      return groups.getKey(firstIndex) < groups.getKey(secondIndex);
+                  });
+    }
+    
+    stream << "Grouped statistical analysis of " << getValueCount() << " values with "
+    << getGroupCount() << " distinct keys:\n\n";
+    std::size_t writtenGroupCount = std::min(maximumGroupCount, getGroupCount());
+    for(std::size_t orderIndex = 0; orderIndex < writtenGroupCount; ++orderIndex){
+        std::size_t groupIndex = groupOrder[orderIndex];
+        StatsSummary summary = groups.getGroupAccumulator(groupIndex).getSummary();
+        stream << keyName << " = " << groups.getKey(groupIndex) << "\n"
+        << "Count = " << summary.count << "\n"
+        << "Sum =  " << summary.sum << "\n"
+        << "Mean = " << summary.mean << "\n"
+        << "Standard Deviation = " << summary.standardDeviation << "\n"
+        << "Minimum = " << summary.minimum << "\n"
+        << "Maximum = " << summary.maximum << "\n\n";
+    }
+    if(writtenGroupCount < getGroupCount()){
+        stream << "Remaining Groups = " << getGroupCount() - writtenGroupCount << "\n\n";
+    }
+    stream << std::flush;
+}
+
+// PUBLIC METHODS OF GROUPEDSTATS
+
+/** Default constructor for the GroupedStats class.
+ *
+ * Creates an object with no groups, which parses files on the calling
+ * thread unless setThreadCount() is subsequently invoked.
+ */
+GroupedStats::GroupedStats() : groups(), keyName("Key"), threadCount(1),
+                               verbosity(SUMMARY_OUTPUT), sortedKeys(false) {
+    // No further initialization operations are required.
+}
+
+/** Public method that sets the number of worker threads.
+ *
+ * \param newThreadCount - The number of worker threads. A value of zero
+ * selects the number of hardware threads available on the current machine.
+ */
+void GroupedStats::setThreadCount(unsigned int newThreadCount){
+    if(newThreadCount == 0){
+        newThreadCount = std::thread::hardware_concurrency();
+    }
+    // std::thread::hardware_concurrency() may return zero.
+    threadCount = (newThreadCount > 0) ? newThreadCount : 1;
+}
+
+/** Public method that sets the amount of information that readFile() and
+ * writeStats() print to the terminal.
+ *
+ * \param newVerbosity - QUIET_OUTPUT to print nothing except failures.
+ */
+void GroupedStats::setVerbosity(OutputVerbosity newVerbosity){
+    verbosity = newVerbosity;
+}
+
+/** Public method that sets the order in which the groups are reported.
+ *
+ * \param enabled - true to sort the groups by key.
+ */
+void GroupedStats::setSortedKeys(bool enabled){
+    sortedKeys = enabled;
+}
+
+/** Public method that replaces the groups with those of the lines of a text
+ * file.
+ *
+ * \param infileName - A string specifying the path of the text file.
+ *
+ * \return true if every line of the file was parsed, false otherwise.
+ *
+ * The file is memory-mapped by a MappedTextFile, or decompressed into memory
+ * by it if it is compressed using gzip or zstd. Its first line that is
+ * neither empty nor a comment determines the separator, which is a comma if
+ * that line contains one and whitespace otherwise, and is treated as a
+ * header that names the key column if its second field is not numeric. The
+ * remaining lines are divided into line-aligned ranges by
+ * divideIntoLineRanges(), as in ColumnTable::readFile(), each of which is
+ * parsed into its own GroupHashTable by its own worker thread. The tables
+ * are then merged in order of their ranges, so the groups appear in the
+ * order in which their keys first appear in the file, however many threads
+ * are used.
+ */
+bool GroupedStats::readFile(const std::string & infileName){
+    
+    // Print an informative message to inform the caller of progress.
+    if(verbosity != QUIET_OUTPUT){
+        std::cout << "Reading keyed data from:\n\n" << infileName << std::endl;
+    }
+    
+    // Discard the existing groups.
+    groups = GroupHashTable();
+    keyName = "Key";
+    
+    // Memory-map the input file.
+    MappedTextFile inputFile(infileName);
+    bool validFile(inputFile.isReadable());
+    std::size_t failedLine(0);
+    if(validFile && inputFile.begin() != inputFile.end()){
+        const char * fileBegin = inputFile.begin();
+        const char * fileEnd = inputFile.end();
+        
+        // Find the first line that is neither empty nor a comment.
+        const char * lineBegin = findFirstDataLine(fileBegin, fileEnd);
+        const char * lineEnd = findLineEnd(lineBegin, fileEnd);
+        const char * firstField = lineBegin;
+        while(firstField != lineEnd && isBlank(*firstField)){
+            ++firstField;
+        }
+        
+        /* Determine the separator and whether the line is a header,
+         * i.e. whether it has a key that is not followed by a value.
+         */
+        char separator = (std::find(lineBegin, lineEnd, ',') != lineEnd) ? ',' : ' ';
+        const char * dataBegin = lineBegin;
+        std::string_view firstKey;
+        const char * valueBegin = (lineBegin != fileEnd) ?
+            splitKey(firstField, lineEnd, separator, firstKey) : 0;
+        double value(0.0);
+        if(valueBegin && valueBegin != lineEnd && !parseValue(valueBegin, lineEnd, value)){
+            keyName = std::string(firstKey);
+            dataBegin = (lineEnd == fileEnd) ? fileEnd : lineEnd + 1;
+        }
+        
+        // Divide the lines into line-aligned ranges, one per worker thread.
+        std::vector<const char *> rangeBegins = divideIntoLineRanges(dataBegin, fileEnd,
+                                                                     threadCount);
+        std::size_t rangeCount = rangeBegins.size() - 1;
+        
+        /* Parse each range on its own worker thread into its own table,
+         * so that the threads share no mutable data. The first range is
+         * parsed directly into the table of this object.
+         */
+        std::vector<GroupHashTable> rangeGroups(rangeCount - 1);
+        std::vector<const char *> rangeStops(rangeCount);
+        std::vector<std::thread> workers;
+        for(std::size_t rangeIndex = 0; rangeIndex < rangeCount; ++rangeIndex){
+            GroupHashTable * table = (rangeIndex == 0) ? &groups : &rangeGroups[rangeIndex - 1];
+            workers.push_back(std::thread([&, rangeIndex, table](){
+                rangeStops[rangeIndex] = parseRows(rangeBegins[rangeIndex],
+                                                   rangeBegins[rangeIndex + 1],
+                                                   separator, *table);
+            }));
+        }
+        for(std::size_t rangeIndex = 0; rangeIndex < rangeCount; ++rangeIndex){
+            workers[rangeIndex].join();
+        }
+        
+        /* Merge the tables of the ranges in order, up to and including
+         * the first range that contains a malformed line, releasing the
+         * memory occupied by each table as soon as it has been merged.
+         */
+        validFile = rangeStops[0] == rangeBegins[1];
+        std::size_t rangeIndex(1);
+        for(; rangeIndex < rangeCount && validFile; ++rangeIndex){
+            groups.merge(rangeGroups[rangeIndex - 1]);
+            rangeGroups[rangeIndex - 1] = GroupHashTable();
+            validFile = rangeStops[rangeIndex] == rangeBegins[rangeIndex + 1];
+        }
+        if(!validFile){
+            const char * stop = rangeStops[rangeIndex - 1];
+            failedLine = std::count(fileBegin, stop, '\n') + 1;
+        }
+    }
+    
+    // Report a failure, even with QUIET_OUTPUT verbosity.
+    if(!validFile && failedLine == 0){
+        std::cout << "Unable to read the input file:\n\n" << infileName << std::endl;
+    }
+    else if(!validFile){
+        std::cout << "Unable to parse line " << failedLine << " of the input file:\n\n"
+        << infileName << std::endl;
+    }
+    else if(inputFile.getCompression() != UNCOMPRESSED_INPUT && verbosity != QUIET_OUTPUT){
+        std::cout << "\nThe input was decompressed from "
+        << getInputCompressionName(inputFile.getCompression()) << " format." << std::endl;
+    }
+    if(verbosity != QUIET_OUTPUT){
+        std::cout << "\nRead " << getValueCount() << " values with " << getGroupCount()
+        << " distinct keys.\n" << std::endl;
+    }
+    return validFile;
+}
+
+/** Public method returns the number of groups.
+ */
+std::size_t GroupedStats::getGroupCount() const {
+    return groups.getGroupCount();
+}
+
+/** Public method returns the total number of values in every group.
+ */
+std::size_t GroupedStats::getValueCount() const {
+    std::size_t valueCount(0);
+    for(std::size_t groupIndex = 0; groupIndex < getGroupCount(); ++groupIndex){
+        valueCount += groups.getGroupAccumulator(groupIndex).getCount();
+    }
+    return valueCount;
+}
+
+/** Public method returns the table that holds the running statistics of
+ * each group.
+ */
+const GroupHashTable & GroupedStats::getGroups() const {
+    return groups;
+}
+
+/** Public method that copies a summary of the statistical properties of the
+ * values with a key.
+ *
+ * \param key - The key.
+ * \param summary - Set to the summary of the group, if it exists.
+ *
+ * \return true if a group with that key exists, false otherwise.
+ */
+bool GroupedStats::getGroupSummary(const std::string & key, StatsSummary & summary) const {
+    std::size_t groupIndex = groups.findGroup(key);
+    if(groupIndex == getGroupCount()){
+        return false;
+    }
+    summary = groups.getGroupAccumulator(groupIndex).getSummary();
+    return true;
+}
+
+/** Public method that prints the statistics of the first few groups, in the
+ * order in which they are written by writeStats(), to the terminal.
+ */
+void GroupedStats::printStats() const {
+    writeGroups(std::cout, printedGroupCount);
+}
+
+/** Public method that writes the statistics of every group to a text file.
+ *
+ * \param outfileName - A string specifying the path of the text file. If
+ * the file exists it is overwritten.
+ */
+void GroupedStats::writeStats(const std::string & outfileName) const {
+    std::ofstream outputFile(outfileName.c_str());
+    if(outputFile.is_open() && outputFile.good()){
+        writeGroups(outputFile, getGroupCount());
+        outputFile.close();
+    }
+    if(!outputFile){
+        std::cout << "Unable to write the grouped statistics to:\n\n"
+        << outfileName << std::endl;
+    }
+    else if(verbosity != QUIET_OUTPUT){
+        std::cout << "The grouped statistics have been saved to:\n\n"
+        << outfileName << std::endl;
+    }
+}
@@ -0,0 +1,424 @@
+// IMPLEMENTATION file for the Histogram class
+
+// STL HEADER FILES
+
+/* The <charconv> header is included to provide the std::to_chars(...)
+ * function.
+ */
+#include <charconv>
+// The <cmath> header is included to provide the std::log(...), std::exp(...) and std::ilogb(...) functions.
+#include <cmath>
+// The <cstring> header is included to provide the std::memcpy(...) function.
+#include <cstring>
+// The <ostream> header is included to provide the write(...) method of std::ostream.
+#include <ostream>
+
+// LOCAL HEADER FILES
+
+/* The "Histogram.h" header is included to provide a definition of the
+ * Histogram class.
+ */
+#include "Histogram.h"
+
+// HELPER FUNCTIONS
+
+/** Helper function that corrects an estimate of the bin that contains a
+ * value, so that the value lies between the stored edges of the bin.
+ *
+ * \param value - The value, which must lie between the lower edge of the
+ * first bin and the upper edge of the last bin, inclusive.
+ * \param bin - The estimated index of the bin, which may exceed that of the
+ * last bin.
+ * \param edges - A pointer to the first edge of the bins.
+ * \param lastBin - The index of the last bin.
+ *
+ * \return The index of the bin that contains the value.
+ *
+ * An estimate that is obtained by scaling the value may be rounded
+ * differently from the stored edges, so a value that lies close to an edge
+ * may be assigned to the adjacent bin.
+ * Comparing the value with the edges of the estimated bin corrects this, so
+ * every value is counted in exactly the bin that the written edges
+ * describe. The edges of the estimated bin are almost always in the cache,
+ * and the loops almost never repeat.
+ */
+static inline std::size_t correctBin(double value, std::size_t bin, const double * edges,
+                                     std::size_t lastBin){
+    if(bin > lastBin){
+        bin = lastBin;
+    }
+    // The value is no less than edges[0], so this loop stops at the first bin.
+    while(value < edges[bin]){
+        --bin;
+    }
+    while(bin < lastBin && value >= edges[bin + 1]){
+        ++bin;
+    }
+    return bin;
+}
+
+/** Helper function that corrects an estimate of the bin that contains a
+ * value that either is correct or precedes the correct bin by one.
+ *
+ * \param value - The value, which must lie between the lower edge of the
+ * first bin and the upper edge of the last bin, inclusive.
+ * \param bin - The estimated index of the bin.
+ * \param edges - A pointer to the first edge of the bins.
+ * \param lastBin - The index of the last bin.
+ *
+ * \return The index of the bin that contains the value.
+ *
+ * This is used for logarithmically spaced bins, where a value lies in the
+ * bin that follows its estimate a substantial fraction of the time. The
+ * comparisons are therefore combined arithmetically, rather than by
+ * branches that the processor could not predict.
+ */
+static inline std::size_t advanceBin(double value, std::size_t bin, const double * edges,
+                                     std::size_t lastBin){
+    return bin + static_cast<std::size_t>((bin < lastBin) & (value >= edges[bin + 1]));
+}
+
+/** Helper function that returns the bit pattern of a double-precision
+ * value.
+ *
+ * \param value - The value.
+ *
+ * \return The bit pattern as an unsigned integer. For positive values the
+ * bit patterns increase with the values, because the exponent occupies the
+ * bits above the mantissa.
+ */
+static inline std::uint64_t getBits(double value){
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+/** Helper function that writes a double-precision value to a text stream
+ * using the shortest representation that reads back as the same value.
+ *
+ * \param stream - The stream to which the value is written.
+ * \param value - The value to be written.
+ */
+static void writeShortest(std::ostream & stream, double value){
+    char buffer[32];
+    std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    stream.write(buffer, result.ptr - buffer);
+}
+
+// PUBLIC METHODS OF HISTOGRAM
+
+/** Default constructor for the Histogram class.
+ *
+ * Creates a histogram with no bins. Any values that are added to it are
+ * ignored, so it serves only as a placeholder that can be assigned a
+ * histogram with bins.
+ */
+Histogram::Histogram() : scale(LINEAR_SCALE), binEdges(), binCounts(),
+                         underflowCount(0), overflowCount(0), origin(0.0),
+                         binsPerUnit(0.0), lookupShift(0), lookupOrigin(0),
+                         binLookup() {
+    // No further initialization operations are required.
+}
+
+/** Constructor for the Histogram class.
+ *
+ * \param newScale - The spacing of the bins.
+ * \param binCount - The number of bins, which must be positive.
+ * \param lowerEdge - The lower edge of the first bin.
+ * \param upperEdge - The upper edge of the last bin, which must be greater
+ * than "lowerEdge". For logarithmically spaced bins both edges must be
+ * positive.
+ *
+ * The edges of linearly spaced bins are
+ * \f$ e_{i} = (e_{0} (N - i) + e_{N} i)/N \f$, which is rounded to the
+ * nearest representable value more often than the equivalent
+ * \f$ e_{0} + i (e_{N} - e_{0})/N \f$, and those of logarithmically
+ * spaced bins are \f$ e_{i} = e_{0} (e_{N}/e_{0})^{i/N} \f$. They are
+ * computed once and stored, and the upper edge of the last bin is stored
+ * exactly as specified.
+ *
+ * Evaluating a logarithm for every value would limit the rate at which
+ * values can be added to logarithmically spaced bins to a fraction of that
+ * for linearly spaced bins. Instead, the bit pattern of a positive value,
+ * whose high-order bits hold its exponent and the leading bits of its
+ * mantissa, is shortened by discarding "lookupShift" low-order bits. This
+ * divides the positive values into "sub-bins", each narrower than half of
+ * the narrowest bin relative to its own values, so each sub-bin overlaps at
+ * most two bins. A lookup table records the first bin that each sub-bin
+ * overlaps, and advanceBin() moves to the second if necessary. The table
+ * has between three and six entries per bin.
+ */
+Histogram::Histogram(HistogramScale newScale, std::size_t binCount, double lowerEdge,
+                     double upperEdge) : scale(newScale), binEdges(binCount + 1),
+                                         binCounts(binCount, 0), underflowCount(0),
+                                         overflowCount(0), origin(lowerEdge),
+                                         binsPerUnit(binCount/(upperEdge - lowerEdge)),
+                                         lookupShift(0), lookupOrigin(0), binLookup() {
+    
+    // Compute the edges.
+    double logLowerEdge = std::log(lowerEdge);
+    double logRange = std::log(upperEdge) - logLowerEdge;
+    for(std::size_t edgeIndex = 0; edgeIndex < binCount; ++edgeIndex){
+        binEdges[edgeIndex] = (scale == LOGARITHMIC_SCALE) ?
+            std::exp(logLowerEdge + edgeIndex*logRange/binCount) :
+            (lowerEdge*(binCount - edgeIndex) + upperEdge*edgeIndex)/binCount;
+    }
+    binEdges[0] = lowerEdge;
+    binEdges[binCount] = upperEdge;
+    
+    if(scale != LOGARITHMIC_SCALE){
+        return;
+    }
+    
+    /* Find the narrowest bin relative to its lower edge. A sub-bin spans
+     * \f$ 2^{s-52} \f$ of the values in its binade relative to its lowest
+     * value, so choose the largest shift, "s", for which this does not
+     * exceed half of the narrowest bin, which leaves a margin for rounding
+     * errors in the edges. At most 52 bits are discarded, leaving one
+     * sub-bin per binade.
+     */
+    double narrowestWidth(1.0);
+    for(std::size_t binIndex = 0; binIndex < binCount; ++binIndex){
+        double width = binEdges[binIndex + 1]/binEdges[binIndex] - 1.0;
+        if(width < narrowestWidth){
+            narrowestWidth = width;
+        }
+    }
+    int shift = 51 + std::ilogb(narrowestWidth);
+    if(shift > 52){
+        shift = 52;
+    }
+    lookupShift = (shift < 0) ? 0 : static_cast<unsigned int>(shift);
+    
+    // Record the first bin that each sub-bin overlaps.
+    lookupOrigin = getBits(lowerEdge) >> lookupShift;
+    std::uint64_t subBinCount = (getBits(upperEdge) >> lookupShift) - lookupOrigin + 1;
+    binLookup.resize(subBinCount);
+    std::size_t bin(0);
+    for(std::uint64_t subBin = 0; subBin < subBinCount; ++subBin){
+        std::uint64_t firstBits = (lookupOrigin + subBin) << lookupShift;
+        double firstValue;
+        std::memcpy(&firstValue, &firstBits, sizeof(firstValue));
+        while(bin + 1 < binCount && firstValue >= binEdges[bin + 1]){
+            ++bin;
+        }
+        binLookup[subBin] = bin;
+    }
+}
+
+/** Public method that adds a single value to the histogram.
+ *
+ * \param value - The value to be added. NaN is ignored.
+ */
+void Histogram::addValue(double value){
+    addValues(&value, 1);
+}
+
+/** Private method that adds an array of values of any supported type to the
+ * histogram.
+ *
+ * \param values - A pointer to the first element of the array.
+ * \param valueCount - The number of elements in the array.
+ *
+ * The type of the elements is a template parameter, and each element is
+ * converted to double precision as it is read, so the same bins are chosen
+ * whatever the type in which the values are stored.
+ *
+ * The bin that contains each value is estimated by scaling its offset from
+ * the lower edge by the number of bins per unit or, for logarithmically
+ * spaced bins, by looking up its shortened bit pattern, and then corrected
+ * by correctBin() or advanceBin() respectively. The counts of underflow and overflow are accumulated in
+ * local variables, and the spacing of the bins is tested once per array
+ * rather than once per value, so either loop performs only a few integer or
+ * floating-point operations and comparisons per value.
+ *
+ * NaN compares false with every edge, so it is counted neither in a bin
+ * nor as underflow or overflow.
+ */
+template<typename Element>
+void Histogram::addElements(const Element * values, std::size_t valueCount){
+    
+    // Values are ignored by a histogram with no bins.
+    if(binCounts.empty()){
+        return;
+    }
+    
+    // Copy the members that are used for every value into local variables.
+    const double * edges = binEdges.data();
+    std::uint64_t * counts = binCounts.data();
+    std::size_t lastBin = binCounts.size() - 1;
+    double lowerEdge = edges[0];
+    double upperEdge = edges[lastBin + 1];
+    std::uint64_t underflow(0);
+    std::uint64_t overflow(0);
+    
+    if(scale == LOGARITHMIC_SCALE){
+        const std::size_t * lookup = binLookup.data();
+        for(std::size_t valueIndex = 0; valueIndex < valueCount; ++valueIndex){
+            double value = static_cast<double>(values[valueIndex]);
+            if(value >= lowerEdge && value <= upperEdge){
+                std::size_t bin = lookup[(getBits(value) >> lookupShift) - lookupOrigin];
+                ++counts[advanceBin(value, bin, edges, lastBin)];
+            }
+            else if(value < lowerEdge){
+                ++underflow;
+            }
+            else if(value > upperEdge){
+                ++overflow;
+            }
+        }
+    }
+    else{
+        for(std::size_t valueIndex = 0; valueIndex < valueCount; ++valueIndex){
+            double value = static_cast<double>(values[valueIndex]);
+            if(value >= lowerEdge && value <= upperEdge){
+                std::size_t bin = static_cast<std::size_t>((value - origin)*binsPerUnit);
+                ++counts[correctBin(value, bin, edges, lastBin)];
+            }
+            else if(value < lowerEdge){
+                ++underflow;
+            }
+            else if(value > upperEdge){
+                ++overflow;
+            }
+        }
+    }
+    
+    underflowCount += underflow;
+    overflowCount += overflow;
+}
+
+/** Public method that adds an array of values to the histogram.
+ *
+ * \param values - A pointer to the first element of the array.
+ * \param valueCount - The number of elements in the array.
+ */
+void Histogram::addValues(const double * values, std::size_t valueCount){
+    addElements(values, valueCount);
+}
+
+/** Public method that adds an array of single precision values to the
+ * histogram.
+ *
+ * \param values - A pointer to the first element of the array.
+ * \param valueCount - The number of elements in the array.
+ */
+void Histogram::addValues(const float * values, std::size_t valueCount){
+    addElements(values, valueCount);
+}
+
+/** Public method that adds an array of 64-bit integers to the histogram.
+ *
+ * \param values - A pointer to the first element of the array.
+ * \param valueCount - The number of elements in the array.
+ */
+void Histogram::addValues(const std::int64_t * values, std::size_t valueCount){
+    addElements(values, valueCount);
+}
+
+/** Public method that adds the counts of another histogram to those of this
+ * histogram.
+ *
+ * \param other - The histogram whose counts should be added.
+ *
+ * \return true if the histograms have identical bins, in which case the
+ * counts of every bin, the underflow and the overflow are added. Otherwise
+ * false is returned and this histogram is unchanged.
+ */
+bool Histogram::merge(const Histogram & other){
+    if(other.scale != scale || other.binEdges != binEdges){
+        return false;
+    }
+    for(std::size_t binIndex = 0; binIndex < binCounts.size(); ++binIndex){
+        binCounts[binIndex] += other.binCounts[binIndex];
+    }
+    underflowCount += other.underflowCount;
+    overflowCount += other.overflowCount;
+    return true;
+}
+
+/** Public method returns the spacing of the bins.
+ *
+ * \return LINEAR_SCALE or LOGARITHMIC_SCALE.
+ */
+HistogramScale Histogram::getScale() const {
+    return scale;
+}
+
+/** Public method returns the number of bins.
+ *
+ * \return The number of bins, which is zero for a default-constructed
+ * histogram.
+ */
+std::size_t Histogram::getBinCount() const {
+    return binCounts.size();
+}
+
+/** Public method returns an edge of the bins.
+ *
+ * \param edgeIndex - The index of the edge, from zero for the lower edge of
+ * the first bin to the number of bins for the upper edge of the last bin.
+ *
+ * \return The edge as a double-precision value.
+ */
+double Histogram::getBinEdge(std::size_t edgeIndex) const {
+    return binEdges[edgeIndex];
+}
+
+/** Public method returns the count of values in a bin.
+ *
+ * \param binIndex - The index of the bin, from zero for the first bin.
+ *
+ * \return The count as an unsigned integer.
+ */
+std::uint64_t Histogram::getBinValueCount(std::size_t binIndex) const {
+    return binCounts[binIndex];
+}
+
+/** Public method returns the count of values below the lower edge of the
+ * first bin.
+ *
+ * \return The count as an unsigned integer.
+ */
+std::uint64_t Histogram::getUnderflowCount() const {
+    return underflowCount;
+}
+
+/** Public method returns the count of values above the upper edge of the
+ * last bin.
+ *
+ * \return The count as an unsigned integer.
+ */
+std::uint64_t Histogram::getOverflowCount() const {
+    return overflowCount;
+}
+
+/** Public method that writes the histogram to a text stream.
+ *
+ * \param stream - The stream to which the histogram is written.
+ *
+ * \return true if the histogram was written successfully, false otherwise.
+ *
+ * A header of comment lines, each beginning with "#", states the spacing
+ * and number of bins and the counts of underflow and overflow. It is
+ * followed by one line per bin, containing its lower edge, upper edge and
+ * count separated by spaces. The edges are written using the shortest
+ * representation that reads back exactly, so the file can be read directly
+ * by plotting programs and by numerical libraries that skip comments.
+ */
+bool Histogram::write(std::ostream & stream) const {
+    stream << "# Histogram with " << binCounts.size()
+    << ((scale == LOGARITHMIC_SCALE) ? " logarithmically" : " linearly")
+    << " spaced bins\n"
+    << "# Underflow = " << underflowCount << "\n"
+    << "# Overflow = " << overflowCount << "\n"
+    << "# Lower_Edge Upper_Edge Count\n";
+    for(std::size_t binIndex = 0; binIndex < binCounts.size(); ++binIndex){
+        writeShortest(stream, binEdges[binIndex]);
+        stream << " ";
+        writeShortest(stream, binEdges[binIndex + 1]);
+        stream << " " << binCounts[binIndex] << "\n";
+    }
+    stream.flush();
+    return stream.good();
+}
@@ -0,0 +1,55 @@
+// IMPLEMENTATION file for the large page allocation functions
+
+// POSIX HEADER FILES
+
+// The <sys/mman.h> header is included to provide the mmap(...) and madvise(...) functions.
+#include <sys/mman.h>
+
+// LOCAL HEADER FILES
+
+/* The "LargePageAllocator.h" header is included to provide declarations of
+ * the functions that are defined in this file.
+ */
+#include "LargePageAllocator.h"
+
+// PUBLIC FUNCTIONS
+
+/** Function that maps a block of anonymous memory directly from the
+ * operating system.
+ *
+ * \param byteCount - The number of bytes in the block.
+ *
+ * \return A pointer to the first byte of the block, or a null pointer if it
+ * could not be mapped.
+ *
+ * The block is mapped with MAP_NORESERVE, so the operating system does not
+ * set aside swap space for pages that may never be written, and a generous
+ * reservation does not fail merely because it exceeds the memory that is
+ * currently free. Where the operating system supports transparent huge
+ * pages, it is then advised using madvise(...) to back the block with them.
+ * This is only a hint, which is ignored if huge pages are disabled or none
+ * are available, so the block is usable either way.
+ */
+void * allocateLargePages(std::size_t byteCount){
+    void * block = mmap(0, byteCount, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if(block == MAP_FAILED){
+        return 0;
+    }
+#ifdef MADV_HUGEPAGE
+    madvise(block, byteCount, MADV_HUGEPAGE);
+#endif
+    return block;
+}
+
+/** Function that returns a block mapped by allocateLargePages() to the
+ * operating system.
+ *
+ * \param block - A pointer to the first byte of the block.
+ * \param byteCount - The number of bytes that were requested for the block.
+ *
+ * Unmapping the block releases every physical page that backs it at once.
+ */
+void releaseLargePages(void * block, std::size_t byteCount){
+    munmap(block, byteCount);
+}
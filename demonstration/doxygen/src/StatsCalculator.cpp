@@ -2,333 +2,2785 @@
 
 // STL HEADER FILES
 
-// The <cmath> header is included to provide the std::sqrt(...) function.
+// The <algorithm> header is included to provide the std::copy(...) function.
+#include <algorithm>
+// The <atomic> header is included to provide the STL std::atomic type.
+#include <atomic>
+/* The <charconv> header is included to provide the std::from_chars(...) and
+ * std::to_chars(...) functions.
+ */
+#include <charconv>
+// The <cerrno> header is included to provide the errno macro.
+#include <cerrno>
+/* The <cmath> header is included to provide the std::cbrt(...), std::ceil(...),
+ * std::fabs(...), std::isfinite(...) and std::trunc(...) functions.
+ */
 #include <cmath>
+/* The <cstdint> header is included to provide the std::uintptr_t and
+ * std::int64_t types.
+ */
+#include <cstdint>
+// The <deque> header is included to provide the STL std::deque type.
+#include <deque>
 // The <fstream> header is included to enable input from and output to files.
 #include <fstream>
 // The <iostream> header is included to enable textual terminal output.
 #include <iostream>
+// The <limits> header is included to provide the std::numeric_limits type.
+#include <limits>
+// The <string> header is included to provide the STL std::string type.
+#include <string>
+// The <thread> header is included to provide the std::thread class.
+#include <thread>
+/* The <type_traits> header is included to provide the std::is_same and
+ * std::is_integral types.
+ */
+#include <type_traits>
+
+// POSIX HEADER FILES
+
+// The <fcntl.h> header is included to provide the open(...) function.
+#include <fcntl.h>
+// The <sys/mman.h> header is included to provide the mmap(...) function.
+#include <sys/mman.h>
+// The <sys/stat.h> header is included to provide the fstat(...) function.
+#include <sys/stat.h>
+/* The <unistd.h> header is included to provide the read(...), pread(...),
+ * lseek(...) and close(...) functions and the STDIN_FILENO macro.
+ */
+#include <unistd.h>
+
+// LOCAL HEADER FILES
+
+/* The "StatsCalculator.h" header is included to provide a definition of the
+ * BasicStatsCalculator class template and the StatsCalculator type.
+ */
+#include "StatsCalculator.h"
+
+/* The "BinaryDataFile.h" header is included to provide functions that read
+ * and write binary data files.
+ */
+#include "BinaryDataFile.h"
+
+/* The "ByteOrder.h" header is included to provide functions that load values
+ * in little-endian byte order.
+ */
+#include "ByteOrder.h"
+
+/* The "OrderStatistics.h" header is included to provide functions that find
+ * exact quantiles and sort values using several threads.
+ */
+#include "OrderStatistics.h"
+
+/* The "BoundedQueue.h" header is included to provide the BoundedQueue class
+ * template, through which the stages of readPipelined() pass buffers.
+ */
+#include "BoundedQueue.h"
+
+/* The "CompressedInput.h" header is included to provide the InputDecompressor
+ * class, with which readPipelined() decompresses gzip or zstd input.
+ */
+#include "CompressedInput.h"
+
+// CONSTANTS
+
+/* The probabilities of the quantiles that are reported by printStats() and
+ * writeStats(), and the names with which they are labelled.
+ */
+static const std::size_t reportedQuantileCount = 4;
+static const double reportedQuantileProbabilities[reportedQuantileCount] = {
+    0.5, 0.9, 0.99, 0.999
+};
+static const char * const reportedQuantileNames[reportedQuantileCount] = {
+    "p50", "p90", "p99", "p99.9"
+};
+
+/* The largest number of bins that the automatic rules of the histogram may
+ * select. A few extreme outliers can otherwise require an enormous number
+ * of bins, almost all of them empty.
+ */
+static const std::size_t maximumAutomaticBinCount = 1 << 16;
+
+/* The smallest number of values that each worker thread bins when a
+ * histogram is computed. For fewer values the cost of starting a thread
+ * exceeds the time saved.
+ */
+static const std::size_t minimumHistogramRangeSize = 1 << 20;
+
+/* The number and size of the samples of an input file in which values are
+ * counted to estimate the number of values in the whole file.
+ */
+static const std::size_t valueDensitySampleCount = 16;
+static const std::size_t valueDensitySampleSize = 1 << 14;
+
+/* The fraction by which the storage reserved for the values of an input
+ * file exceeds the estimated number of values. Reserved elements that are
+ * not filled occupy no physical memory, so the margin is generous enough
+ * that the estimate is rarely exceeded.
+ */
+static const double reservedValueMargin = 0.05;
+
+/* The number of characters that a worker thread parses before it releases
+ * the pages of the memory-mapped input file that it has parsed.
+ */
+static const std::size_t mappedPageReleaseInterval = 1 << 24;
+
+/* The number of characters in each buffer that the reader stage of the
+ * input pipeline fills, and the number of buffers of each kind that belong
+ * to each parser stage. Two buffers per parser allow one to be filled while
+ * the other is parsed.
+ */
+static const std::size_t pipelineBufferSize = 1 << 22;
+static const std::size_t pipelineBuffersPerParser = 2;
+
+// HELPER FUNCTIONS
+
+/** Helper function that determines whether a character separates numeric
+ * tokens. The set of whitespace characters is identical to that recognized
+ * by the stream input operator (">>") in the default "C" locale.
+ *
+ * \param character - The character to be classified.
+ *
+ * \return true if the character is whitespace, false otherwise.
+ */
+static inline bool isWhitespace(char character){
+    return character == ' ' || character == '\n' || character == '\t' ||
+           character == '\r' || character == '\v' || character == '\f';
+}
+
+/** Helper function that interprets the numeric token that begins at a
+ * non-whitespace character.
+ *
+ * \param tokenBegin - A pointer to the first character of the token.
+ * \param bufferEnd - A pointer one past the last character of the range
+ * that contains the token.
+ * \param value - A reference to a variable of type double, float or
+ * std::int64_t that receives the parsed value.
+ *
+ * \return A pointer to the first character that is not part of the value,
+ * or a null pointer if the token cannot be interpreted as a numeric value.
+ *
+ * \note The token is converted using std::from_chars, which neither
+ * consults the global locale nor copies the characters into a stream
+ * buffer. Like the stream input operator (">>"), it produces the correctly
+ * rounded value of the storage type for every token, so the parsed values
+ * are identical to those that a std::ifstream would extract.
+ *
+ * \note If the storage type is std::int64_t, a token is only accepted if it
+ * is an integer that std::int64_t can represent and is followed by
+ * whitespace or the end of the range. Parsing therefore stops at a token
+ * such as "1.5" or "1e3", exactly as at a value that cannot be interpreted,
+ * rather than truncating it.
+ */
+template<typename Element>
+static inline const char * parseValue(const char * tokenBegin, const char * bufferEnd,
+                                      Element & value){
+    
+    /* The stream input operator accepts an explicit leading "+" sign, but
+     * std::from_chars does not, so skip it here.
+     */
+    bool explicitPlusSign(false);
+    if(*tokenBegin == '+' && tokenBegin + 1 != bufferEnd){
+        ++tokenBegin;
+        explicitPlusSign = true;
+    }
+    
+    /* The stream input operator does not interpret textual tokens like
+     * "inf" or "nan", whereas std::from_chars does. A valid token must
+     * therefore begin with a digit or a decimal point after a single
+     * optional sign, so a token such as "+-3" is rejected as it is by the
+     * stream input operator.
+     */
+    const char * firstDigit = tokenBegin;
+    if(!explicitPlusSign && *firstDigit == '-' && firstDigit + 1 != bufferEnd){
+        ++firstDigit;
+    }
+    if(!((*firstDigit >= '0' && *firstDigit <= '9') || *firstDigit == '.')){
+        return 0;
+    }
+    
+    /* Interpret the characters as a value of the storage type. The "ptr"
+     * member of the result points to the first character that was not part
+     * of the numeric value. A token that could not be interpreted is
+     * rejected, exactly as the stream input operator enters a failed state.
+     */
+    std::from_chars_result result = std::from_chars(tokenBegin, bufferEnd, value);
+    if(result.ec != std::errc()){
+        return 0;
+    }
+    
+    // An integer must not be the leading part of a non-integer token.
+    if(std::is_integral<Element>::value && result.ptr != bufferEnd &&
+       !isWhitespace(*result.ptr)){
+        return 0;
+    }
+    
+    return result.ptr;
+}
+
+/** Helper function that establishes whether a double-precision value, such
+ * as one read from a binary data file, can be converted to the storage type.
+ *
+ * \param value - The value.
+ *
+ * \return true if the value can be stored, false otherwise.
+ *
+ * \note Converting a floating-point value that an integer type cannot
+ * represent, such as a NaN, an infinity or a value outside its range, has
+ * undefined behaviour. If the storage type is std::int64_t, a value is
+ * therefore only accepted if it is an integer within the range of
+ * std::int64_t, exactly as parseValue() only accepts integral tokens. The
+ * largest std::int64_t value, 2^63 - 1, cannot be represented as a double,
+ * so the range is bounded by -2^63 and 2^63 instead. Similarly, a finite
+ * value whose magnitude exceeds the largest float is not accepted if the
+ * storage type is float, while infinities and NaNs are.
+ */
+template<typename Element>
+static inline bool isStorableValue(double value){
+    if(std::is_integral<Element>::value){
+        double lowestValue = static_cast<double>(std::numeric_limits<Element>::min());
+        return std::isfinite(value) && std::trunc(value) == value &&
+               value >= lowestValue && value < -lowestValue;
+    }
+    return !std::isfinite(value) ||
+           std::fabs(value) <= static_cast<double>(std::numeric_limits<Element>::max());
+}
+
+/** Helper function that estimates the number of whitespace-separated tokens
+ * per character of a range of characters, by counting the tokens in a few
+ * evenly spaced samples of it.
+ *
+ * \param bufferBegin - A pointer to the first character of the range.
+ * \param bufferEnd - A pointer one past the last character of the range.
+ *
+ * \return The estimated number of tokens per character, or zero if the
+ * range is empty.
+ *
+ * A range that is no longer than the samples together is counted in full.
+ * Otherwise "valueDensitySampleCount" samples of "valueDensitySampleSize"
+ * characters are counted, the first at the beginning of the range and the
+ * last at its end, so only a few pages of a large memory-mapped file are
+ * read. A token that straddles the beginning of a sample is counted as
+ * though it began there.
+ */
+static double estimateValueDensity(const char * bufferBegin, const char * bufferEnd){
+    std::size_t bufferSize = bufferEnd - bufferBegin;
+    if(bufferSize == 0){
+        return 0.0;
+    }
+    std::size_t sampleCount = valueDensitySampleCount;
+    std::size_t sampleSize = valueDensitySampleSize;
+    if(bufferSize <= sampleCount*sampleSize){
+        sampleCount = 1;
+        sampleSize = bufferSize;
+    }
+    
+    // Count the characters that begin a token in each sample.
+    std::size_t tokenCount(0);
+    for(std::size_t sampleIndex = 0; sampleIndex < sampleCount; ++sampleIndex){
+        const char * sampleBegin = bufferBegin;
+        if(sampleCount > 1){
+            sampleBegin += sampleIndex*((bufferSize - sampleSize)/(sampleCount - 1));
+        }
+        bool previousIsWhitespace(true);
+        for(const char * character = sampleBegin; character != sampleBegin + sampleSize;
+            ++character){
+            bool currentIsWhitespace = isWhitespace(*character);
+            if(previousIsWhitespace && !currentIsWhitespace){
+                ++tokenCount;
+            }
+            previousIsWhitespace = currentIsWhitespace;
+        }
+    }
+    return static_cast<double>(tokenCount)/static_cast<double>(sampleCount*sampleSize);
+}
+
+/** Helper function that releases the physical memory pages backing part of
+ * a read-only memory-mapped file, so that the resident memory of a program
+ * that scans a file sequentially does not grow with the size of the file.
+ *
+ * \param rangeBegin - A pointer to the first character of the range.
+ * \param rangeEnd - A pointer one past the last character of the range.
+ *
+ * \return A pointer to the end of the range that was actually released,
+ * which is "rangeEnd" rounded down to a whole number of memory pages.
+ *
+ * \note Only whole pages can be released, so the range is rounded down to
+ * page boundaries. If any released page is subsequently accessed, it is
+ * simply read from the file again.
+ */
+static const char * releaseMappedPages(const char * rangeBegin, const char * rangeEnd){
+    
+    // Query the size of a memory page using the POSIX sysconf() function.
+    static const std::uintptr_t pageSize = sysconf(_SC_PAGESIZE);
+    
+    // Round both addresses down to the beginning of a page.
+    std::uintptr_t releaseBegin = reinterpret_cast<std::uintptr_t>(rangeBegin);
+    std::uintptr_t releaseEnd = reinterpret_cast<std::uintptr_t>(rangeEnd);
+    releaseBegin -= releaseBegin % pageSize;
+    releaseEnd -= releaseEnd % pageSize;
+    
+    if(releaseEnd > releaseBegin){
+        madvise(reinterpret_cast<void *>(releaseBegin), releaseEnd - releaseBegin,
+                MADV_DONTNEED);
+    }
+    
+    return reinterpret_cast<const char *>(releaseEnd);
+}
+
+/** Helper function that formats a floating-point value as characters.
+ *
+ * \param first - A pointer to the first character of the buffer.
+ * \param last - A pointer one past the last character of the buffer.
+ * \param value - The value, of type double or float.
+ * \param precision - The number of significant digits.
+ *
+ * \return A pointer one past the last character written.
+ *
+ * The "general" format with a given precision matches the default format
+ * of the stream output operator.
+ */
+template<typename Element>
+static char * formatValue(char * first, char * last, Element value, int precision){
+    return std::to_chars(first, last, value, std::chars_format::general, precision).ptr;
+}
+
+/** Helper function that formats an integer value as characters.
+ *
+ * \param first - A pointer to the first character of the buffer.
+ * \param last - A pointer one past the last character of the buffer.
+ * \param value - The value.
+ *
+ * \return A pointer one past the last character written. Every digit is
+ * written, whatever the precision of the stream, just as by the stream
+ * output operator.
+ */
+static char * formatValue(char * first, char * last, std::int64_t value, int){
+    return std::to_chars(first, last, value).ptr;
+}
+
+/** Helper function that writes a comma-separated list of values to an
+ * output stream.
+ *
+ * \param stream - The stream to which the values are written. The values
+ * are formatted with the precision of the stream in the same way as the
+ * stream output operator ("<<") formats them with its default flags.
+ * \param values - A pointer to the first value, of type double, float or
+ * std::int64_t.
+ * \param valueCount - The number of values.
+ *
+ * The values are converted to characters by formatValue() using
+ * std::to_chars, which is independent of the locale and much faster than
+ * the stream output operator, and the characters are written to the stream
+ * in large blocks. This matters when many millions of values are written.
+ */
+template<typename Element>
+static void printValues(std::ostream & stream, const Element * values,
+                        std::size_t valueCount){
+    
+    // The number of significant digits used by the stream output operator.
+    int precision = static_cast<int>(stream.precision());
+    
+    /* Accumulate the formatted values in a buffer, which is written to the
+     * stream whenever it may not have room for another value.
+     */
+    std::string buffer(1 << 16, ' ');
+    std::size_t bufferUsed = 0;
+    
+    for(std::size_t valueIndex = 0; valueIndex < valueCount; ++valueIndex){
+        
+        // A formatted value and separator never exceed 64 characters.
+        if(bufferUsed + 64 > buffer.size()){
+            stream.write(buffer.data(), bufferUsed);
+            bufferUsed = 0;
+        }
+        if(valueIndex > 0){
+            buffer[bufferUsed++] = ',';
+            buffer[bufferUsed++] = ' ';
+        }
+        bufferUsed = formatValue(&buffer[bufferUsed], &buffer[0] + buffer.size(),
+                                 values[valueIndex], precision) - &buffer[0];
+    }
+    stream.write(buffer.data(), bufferUsed);
+}
+
+/** A structure that holds a buffer of characters read from an input file by
+ * the reader stage of readPipelined(), which passes it to a parser stage.
+ */
+struct TextBlock {
+    
+    /* The buffer, which holds "pipelineBufferSize" characters. */
+    std::vector<char> characters;
+    
+    /* The number of characters of the buffer that are to be parsed, which
+     * always end with a complete token. */
+    std::size_t size;
+    
+    /* Flag indicating that the block holds no characters and instead marks
+     * the end of the input. */
+    bool endOfInput;
+};
+
+/** A structure that holds the values parsed from a TextBlock by a parser
+ * stage of readPipelined(), which passes it to the reducer stage.
+ */
+template<typename Element>
+struct ParsedBlock {
+    
+    /* The parsed values, in their original order. */
+    std::vector<Element> values;
+    
+    /* The number of characters from which the values were parsed. */
+    std::size_t characterCount;
+    
+    /* Flag indicating that every character of the TextBlock was parsed, i.e.
+     * that no invalid token was encountered. */
+    bool complete;
+    
+    /* Flag indicating that the block holds no values and instead marks the
+     * end of the input. */
+    bool endOfInput;
+};
+
+/** Helper function that provides the elements of a vector of double
+ * precision values.
+ *
+ * \param values - The vector.
+ *
+ * \return A pointer to the first element of "values", which is not copied.
+ */
+template<typename Allocator>
+static const double * getDoubleValues(const std::vector<double, Allocator> & values,
+                                      std::vector<double> &){
+    return values.data();
+}
+
+/** Helper function that converts the elements of a vector of values of
+ * another type to double precision.
+ *
+ * \param values - The vector of values, of type float or std::int64_t.
+ * \param convertedValues - A vector that receives the converted values.
+ *
+ * \return A pointer to the first element of "convertedValues".
+ */
+template<typename Element, typename Allocator>
+static const double * getDoubleValues(const std::vector<Element, Allocator> & values,
+                                      std::vector<double> & convertedValues){
+    convertedValues.assign(values.begin(), values.end());
+    return convertedValues.data();
+}
+
+// PUBLIC METHODS OF STATSCALCULATOR
+
+/** Private method that computes the running statistics of the stored
+ * numeric values in a single pass over the "numericValues" member datum.
+ *
+ * \return A StatsAccumulator from which the number of values, their sum,
+ * mean, variance and standard deviation can be obtained.
+ *
+ * The sum of the values, their mean and the sum of their squared deviations
+ * from the mean are accumulated together as each element is visited, so
+ * every element is loaded from memory only once. The accumulation is
+ * performed by the addValues() method of a StatsAccumulator, which uses an
+ * explicitly vectorized kernel that is selected at run time, and remains
+ * accurate even when the standard deviation is many orders of magnitude
+ * smaller than the mean.
+ *
+ * \note Any values that were parsed in streaming mode are included by
+ * starting from a copy of the "streamedStatistics" member datum, which also
+ * holds any statistics merged from state files by mergeState().
+ */
+template<typename Element>
+StatsAccumulator BasicStatsCalculator<Element>::computeStatistics() const {
+    
+    /* Copy the running statistics of the streamed values, then add the
+     * stored values to them. The data() method of std::vector returns a
+     * pointer to its first element, and StatsAccumulator converts values of
+     * every storage type to double precision as it loads them.
+     */
+    StatsAccumulator statistics(streamedStatistics);
+    statistics.addValues(numericValues.data(), numericValues.size());
+    
+    return statistics;
+}
+
+/** Private method that actually computes the sum of the stored numeric
+ * values.
+ *
+ * \return The computed sum is returned as a double-precision value.
+ *
+ * \note The computation is delegated to the computeStatistics() method via
+ * getSummary(), which caches its result.
+ */
+template<typename Element>
+double BasicStatsCalculator<Element>::computeSum() const {
+    return getSummary().sum;
+}
+
+/** Private method that actually computes the mean of the stored numeric
+ * values.
+ *
+ * \return The computed mean is returned as a double-precision value.
+ * 
+ * The mean of a sequence of numbers is equal to their sum divided
+ * by their multiplicity.
+ *
+ * \note The computation is delegated to the computeStatistics() method via
+ * getSummary(), which caches its result. computeStatistics() accumulates
+ * the required sum and obtains the number of elements in the sequence from
+ * the size() method of the std::vector-type member datum
+ * "numericValues".
+ */
+template<typename Element>
+double BasicStatsCalculator<Element>::computeMean() const {
+    return getSummary().mean;
+}
+
+/** Private method that actually computes the standard deviation of the
+ * stored numeric values.
+ *
+ * \return The computed standard deviation is returned as a double-precision value.
+ *
+ * The standard deviation of a sequence of numbers is can be computed
+ * as the square root of the difference between the mean of the squares
+ * of the numbers and the square of the mean of the numbers.
+ * 
+ * \f[ \sigma = \sqrt{\langle X^{2} \rangle - \langle X \rangle^{2}} \f]
+ *
+ * \note The computation is delegated to the computeStatistics() method via
+ * getSummary(), which caches its result. computeStatistics() accumulates the
+ * squared deviations of the numbers from their running mean in a single
+ * pass, which is mathematically equivalent to this formula but does not
+ * suffer from cancellation when the two terms are almost equal.
+ */
+template<typename Element>
+double BasicStatsCalculator<Element>::computeStandardDeviation() const {
+    return getSummary().standardDeviation;
+}
+
+/** Private static method that parses whitespace-separated numeric values
+ * directly from a range of characters in memory.
+ *
+ * \param bufferBegin - A pointer to the first character of the range.
+ * \param bufferEnd - A pointer one past the last character of the range.
+ * \param values - An STL vector to which every parsed value is appended.
+ *
+ * \return A pointer to the first character that was not consumed. This is
+ * equal to bufferEnd unless a token that cannot be interpreted as a numeric
+ * value was encountered, in which case parsing stops at that token.
+ *
+ * \note Each token is converted by parseValue(), which produces exactly the
+ * values that a std::ifstream would extract.
+ */
+template<typename Element>
+const char * BasicStatsCalculator<Element>::parseBuffer(const char * bufferBegin,
+                                                        const char * bufferEnd,
+                                                        std::vector<Element> & values){
+    
+    // The current parsing position within the character range.
+    const char * position = bufferBegin;
+    
+    /* Begin a while loop that will iterate until every character in the
+     * range has been consumed.
+     */
+    while(position != bufferEnd){
+        
+        // Skip any whitespace characters that precede the next token.
+        if(isWhitespace(*position)){
+            ++position;
+            continue;
+        }
+        
+        // Stop parsing if the token could not be interpreted.
+        Element numericValue(0);
+        const char * tokenEnd = parseValue(position, bufferEnd, numericValue);
+        if(!tokenEnd){
+            break;
+        }
+        
+        // Append the parsed value and advance past the consumed characters.
+        values.push_back(numericValue);
+        position = tokenEnd;
+    }
+    
+    return position;
+}
+
+/** Private static method that parses whitespace-separated numeric values
+ * from a range of characters in memory into an array of fixed capacity.
+ *
+ * \param bufferBegin - A pointer to the first character of the range.
+ * \param bufferEnd - A pointer one past the last character of the range.
+ * \param values - A pointer to the first element of the array.
+ * \param capacity - The number of elements in the array.
+ * \param valueCount - The number of elements of the array that are already
+ * filled, which is increased by the number of values parsed.
+ *
+ * \return A pointer to the first character that was not consumed. This is
+ * equal to bufferEnd unless a token that cannot be interpreted as a numeric
+ * value was encountered, or the array became full, in which case parsing
+ * stops at that token. The two cases are distinguished by comparing
+ * "valueCount" with "capacity".
+ *
+ * Writing into a preallocated array, rather than appending to a vector,
+ * allows several worker threads to parse directly into disjoint parts of a
+ * single array, so that their values need never be copied.
+ */
+template<typename Element>
+const char * BasicStatsCalculator<Element>::parseBuffer(const char * bufferBegin,
+                                                        const char * bufferEnd,
+                                                        Element * values,
+                                                        std::size_t capacity,
+                                                        std::size_t & valueCount){
+    
+    // The current parsing position within the character range.
+    const char * position = bufferBegin;
+    
+    while(position != bufferEnd){
+        
+        // Skip any whitespace characters that precede the next token.
+        if(isWhitespace(*position)){
+            ++position;
+            continue;
+        }
+        
+        // Stop parsing if the array is full or the token is invalid.
+        if(valueCount == capacity){
+            break;
+        }
+        const char * tokenEnd = parseValue(position, bufferEnd, values[valueCount]);
+        if(!tokenEnd){
+            break;
+        }
+        
+        // Count the parsed value and advance past the consumed characters.
+        ++valueCount;
+        position = tokenEnd;
+    }
+    
+    return position;
+}
+
+/** Private static method that parses whitespace-separated numeric values
+ * from a range of characters in memory without storing them.
+ *
+ * \param bufferBegin - A pointer to the first character of the range.
+ * \param bufferEnd - A pointer one past the last character of the range.
+ * \param statistics - A StatsAccumulator to which every parsed value is added.
+ * \param quantiles - A pointer to a QuantileSketch to which every parsed
+ * value is added, or a null pointer if quantiles are not estimated.
+ * \param histogram - A pointer to a Histogram to which every parsed value is
+ * added, or a null pointer if the values are not binned.
+ * \param releaseMappedPages - If true, the range must lie within a read-only
+ * memory-mapped file, and the pages that have been parsed are periodically
+ * released.
+ *
+ * \return A pointer to the first character that was not consumed. This is
+ * equal to bufferEnd unless an invalid token was encountered.
+ *
+ * The range is divided into slices of 64 KiB, each extended to the next
+ * whitespace character. Each slice is parsed by parseBuffer() into a small
+ * reusable vector, whose values are added to "statistics" before the vector
+ * is cleared for the next slice. The vector therefore remains resident in
+ * the processor cache and its size never depends on the size of the range.
+ */
+template<typename Element>
+const char * BasicStatsCalculator<Element>::streamBuffer(const char * bufferBegin,
+                                                         const char * bufferEnd,
+                                                         StatsAccumulator & statistics,
+                                                         QuantileSketch * quantiles,
+                                                         Histogram * histogram,
+                                                         bool releaseMappedPages){
+    
+    // The nominal number of characters in each slice.
+    const std::size_t sliceSize(1 << 16);
+    
+    /* Declare a vector to hold the values parsed from a single slice. Every
+     * value occupies at least two characters, including its separator, so
+     * reserving half the slice size ensures that it never reallocates.
+     */
+    std::vector<Element> sliceValues;
+    sliceValues.reserve(sliceSize/2 + 1);
+    
+    // The first character of the current slice and of the unreleased pages.
+    const char * sliceBegin = bufferBegin;
+    const char * unreleasedBegin = bufferBegin;
+    
+    while(sliceBegin != bufferEnd){
+        
+        // Determine the nominal end of the slice...
+        const char * sliceEnd = bufferEnd;
+        if(static_cast<std::size_t>(bufferEnd - sliceBegin) > sliceSize){
+            sliceEnd = sliceBegin + sliceSize;
+        }
+        
+        // ...and advance it until it lies on a whitespace character.
+        while(sliceEnd != bufferEnd && !isWhitespace(*sliceEnd)){
+            ++sliceEnd;
+        }
+        
+        // Parse the slice, accumulate its values and discard them.
+        sliceValues.clear();
+        const char * sliceStop = parseBuffer(sliceBegin, sliceEnd, sliceValues);
+        statistics.addValues(sliceValues.data(), sliceValues.size());
+        if(quantiles){
+            quantiles->addValues(sliceValues.data(), sliceValues.size());
+        }
+        if(histogram){
+            histogram->addValues(sliceValues.data(), sliceValues.size());
+        }
+        
+        // Stop if the slice contained an invalid token.
+        if(sliceStop != sliceEnd){
+            return sliceStop;
+        }
+        sliceBegin = sliceEnd;
+        
+        // Periodically release the mapped pages that have been parsed.
+        if(releaseMappedPages &&
+           static_cast<std::size_t>(sliceBegin - unreleasedBegin) >= mappedPageReleaseInterval){
+            unreleasedBegin = ::releaseMappedPages(unreleasedBegin, sliceBegin);
+        }
+    }
+    
+    return bufferEnd;
+}
+
+/** Private method that parses a memory-mapped input file and appends the
+ * parsed values to the "numericValues" member datum.
+ *
+ * \param fileBegin - A pointer to the first character of the mapped file.
+ * \param fileEnd - A pointer one past the last character of the mapped file.
+ *
+ * The file is divided into "threadCount" byte ranges of approximately equal
+ * size. The boundary between adjacent ranges is advanced to the next
+ * whitespace character so that no numeric token is split between two
+ * ranges. The values of the ranges are stored by storeRanges(), which
+ * parses each range on its own worker thread directly into its own part of
+ * the "numericValues" member datum.
+ *
+ * In streaming mode each range is instead parsed by streamBuffer() into a
+ * separate StatsAccumulator, QuantileSketch and Histogram, which are then
+ * merged into the "streamedStatistics", "streamedQuantiles" and
+ * "streamedHistogram" member data in order.
+ *
+ * \note If parsing of some range stops early because it encountered an
+ * invalid token, the values in all subsequent ranges are discarded. This
+ * reproduces the behaviour of a single sequential parse, which stops at the
+ * first invalid token in the file.
+ */
+template<typename Element>
+void BasicStatsCalculator<Element>::parseMappedFile(const char * fileBegin, const char * fileEnd){
+    
+    // The number of characters in the mapped file.
+    std::size_t fileSize = fileEnd - fileBegin;
+    
+    /* Each worker thread should receive at least this many characters.
+     * For smaller ranges the cost of starting a thread exceeds the time
+     * saved by parsing in parallel.
+     */
+    const std::size_t minimumRangeSize(1 << 20);
+    
+    // Determine the number of ranges into which the file will be divided.
+    std::size_t rangeCount = threadCount;
+    if(rangeCount > fileSize/minimumRangeSize){
+        rangeCount = fileSize/minimumRangeSize;
+    }
+    if(rangeCount == 0){
+        rangeCount = 1;
+    }
+    
+    /* Quantiles are only sketched if they are estimated, and values are
+     * only binned if the bins of the streamed histogram are known.
+     */
+    bool sketchQuantiles = quantileAccuracy > 0.0;
+    bool binValues = streamedHistogram.getBinCount() > 0;
+    
+    // Stream small files sequentially on the calling thread.
+    if(rangeCount == 1 && streamingMode){
+        streamBuffer(fileBegin, fileEnd, streamedStatistics,
+                     sketchQuantiles ? &streamedQuantiles : 0,
+                     binValues ? &streamedHistogram : 0, true);
+        return;
+    }
+    
+    /* Compute the first character of each range. The final element of
+     * "rangeBegins" marks the end of the file.
+     */
+    std::vector<const char *> rangeBegins(rangeCount + 1, fileEnd);
+    rangeBegins[0] = fileBegin;
+    for(std::size_t rangeIndex = 1; rangeIndex < rangeCount; ++rangeIndex){
+        
+        // Start from the nominal boundary, but never before the previous one.
+        const char * boundary = fileBegin + rangeIndex*(fileSize/rangeCount);
+        if(boundary < rangeBegins[rangeIndex - 1]){
+            boundary = rangeBegins[rangeIndex - 1];
+        }
+        
+        // Advance the boundary until it lies on a whitespace character.
+        while(boundary != fileEnd && !isWhitespace(*boundary)){
+            ++boundary;
+        }
+        rangeBegins[rangeIndex] = boundary;
+    }
+    
+    // Store the values of the ranges, unless they are streamed.
+    if(!streamingMode){
+        storeRanges(rangeBegins);
+        return;
+    }
+    
+    /* Declare one StatsAccumulator, one QuantileSketch, one Histogram and
+     * one end-of-parsing pointer for each range. Each worker thread writes
+     * only to its own elements, so the histograms are filled without any
+     * locking and merged afterwards.
+     */
+    std::vector<StatsAccumulator> rangeStatistics(rangeCount);
+    std::vector<QuantileSketch> rangeQuantiles(rangeCount,
+        QuantileSketch(streamedQuantiles.getRelativeAccuracy()));
+    std::vector<Histogram> rangeHistograms(rangeCount, binValues ?
+        createHistogram() : Histogram());
+    std::vector<const char *> rangeStops(rangeCount);
+    
+    /* Launch one worker thread per range. Each thread invokes streamBuffer()
+     * on its own range using a "lambda expression" that captures the range
+     * index by value and everything else by reference.
+     */
+    std::vector<std::thread> workers;
+    for(std::size_t rangeIndex = 0; rangeIndex < rangeCount; ++rangeIndex){
+        workers.push_back(std::thread([&, rangeIndex](){
+            rangeStops[rangeIndex] = streamBuffer(rangeBegins[rangeIndex],
+                                                  rangeBegins[rangeIndex + 1],
+                                                  rangeStatistics[rangeIndex],
+                                                  sketchQuantiles ?
+                                                  &rangeQuantiles[rangeIndex] : 0,
+                                                  binValues ?
+                                                  &rangeHistograms[rangeIndex] : 0,
+                                                  true);
+        }));
+    }
+    
+    /* Wait for every worker thread to finish, and merge the statistics,
+     * quantile sketches and histograms of each range in order. All the
+     * ranges that follow a range that stopped early are discarded.
+     */
+    bool rangesRetained(true);
+    for(std::size_t rangeIndex = 0; rangeIndex < rangeCount; ++rangeIndex){
+        workers[rangeIndex].join();
+        if(rangesRetained){
+            streamedStatistics.merge(rangeStatistics[rangeIndex]);
+            streamedQuantiles.merge(rangeQuantiles[rangeIndex]);
+            streamedHistogram.merge(rangeHistograms[rangeIndex]);
+            rangesRetained = rangeStops[rangeIndex] == rangeBegins[rangeIndex + 1];
+        }
+    }
+}
+
+/** Private method that parses ranges of a memory-mapped input file, each on
+ * its own worker thread, and appends their values to the "numericValues"
+ * member datum in order.
+ *
+ * \param rangeBegins - Pointers to the first character of each range,
+ * followed by a pointer one past the last character of the final range. The
+ * boundaries between ranges must lie on whitespace characters.
+ *
+ * Appending values one at a time to a vector enlarges it repeatedly, and
+ * each enlargement copies every stored value while both the old and the new
+ * arrays are resident, briefly doubling the memory occupied. Parsing each
+ * range into a separate vector and concatenating the vectors afterwards has
+ * the same cost. Instead, the number of values in each range is estimated
+ * from the number of characters that it contains and the density of values
+ * in a sample of the file, found by estimateValueDensity(). The vector is
+ * enlarged once, by the estimated number of values plus a margin of
+ * "reservedValueMargin", and each range is assigned a "slot" of consecutive
+ * elements into which its worker thread parses directly. Since the vector
+ * uses a LargePageAllocator, the elements are not initialized and the
+ * reserved elements that are never filled occupy no physical memory.
+ *
+ * When every thread has finished, the values of each slot are moved down to
+ * follow those of the previous slot, which closes the gaps that unused
+ * elements leave between them without any additional memory. If a range
+ * contains more values than its slot can hold, the excess values are
+ * appended to a separate vector and copied into place after the slot. In
+ * the rare event that there is insufficient room to do so without
+ * overwriting the values of the next slot, every value is instead copied
+ * into a new vector.
+ *
+ * Each worker thread also releases the pages of the mapped file that it has
+ * parsed, in intervals of "mappedPageReleaseInterval" characters, so that
+ * the resident memory of the program is dominated by the stored values
+ * rather than by the text from which they were parsed.
+ *
+ * \note If parsing of some range stops early because it encountered an
+ * invalid token, the values in all subsequent ranges are discarded.
+ */
+template<typename Element>
+void BasicStatsCalculator<Element>::storeRanges(const std::vector<const char *> & rangeBegins){
+    std::size_t rangeCount = rangeBegins.size() - 1;
+    
+    /* Compute the first element of the slot of each range. The final
+     * element of "slotBegins" marks the end of the enlarged vector.
+     */
+    double valueDensity = estimateValueDensity(rangeBegins.front(), rangeBegins.back());
+    std::vector<std::size_t> slotBegins(rangeCount + 1, numericValues.size());
+    for(std::size_t rangeIndex = 0; rangeIndex < rangeCount; ++rangeIndex){
+        double rangeSize = static_cast<double>(rangeBegins[rangeIndex + 1] -
+                                               rangeBegins[rangeIndex]);
+        slotBegins[rangeIndex + 1] = slotBegins[rangeIndex] + 1 +
+            static_cast<std::size_t>(rangeSize*valueDensity*(1.0 + reservedValueMargin));
+    }
+    numericValues.resize(slotBegins[rangeCount]);
+    
+    /* Declare, for each range, the number of values in its slot, a vector of
+     * any values that did not fit in it, and a pointer to the end of parsing.
+     */
+    std::vector<std::size_t> slotCounts(rangeCount, 0);
+    std::vector<std::vector<Element> > excessValues(rangeCount);
+    std::vector<const char *> rangeStops(rangeCount);
+    
+    /* Declare a "lambda expression" that parses one range in slices,
+     * releasing the mapped pages of each slice once it has been parsed.
+     */
+    auto parseRange = [&](std::size_t rangeIndex){
+        const char * sliceBegin = rangeBegins[rangeIndex];
+        const char * rangeEnd = rangeBegins[rangeIndex + 1];
+        Element * slot = numericValues.data() + slotBegins[rangeIndex];
+        std::size_t slotSize = slotBegins[rangeIndex + 1] - slotBegins[rangeIndex];
+        while(sliceBegin != rangeEnd){
+            
+            // End the slice on a whitespace character.
+            const char * sliceEnd = rangeEnd;
+            if(static_cast<std::size_t>(rangeEnd - sliceBegin) > mappedPageReleaseInterval){
+                sliceEnd = sliceBegin + mappedPageReleaseInterval;
+            }
+            while(sliceEnd != rangeEnd && !isWhitespace(*sliceEnd)){
+                ++sliceEnd;
+            }
+            
+            // Parse into the slot and, once it is full, into the excess values.
+            const char * sliceStop = parseBuffer(sliceBegin, sliceEnd, slot, slotSize,
+                                                 slotCounts[rangeIndex]);
+            if(sliceStop != sliceEnd && slotCounts[rangeIndex] == slotSize){
+                sliceStop = parseBuffer(sliceStop, sliceEnd, excessValues[rangeIndex]);
+            }
+            if(sliceStop != sliceEnd){
+                rangeStops[rangeIndex] = sliceStop;
+                return;
+            }
+            ::releaseMappedPages(sliceBegin, sliceEnd);
+            sliceBegin = sliceEnd;
+        }
+        rangeStops[rangeIndex] = rangeEnd;
+    };
+    
+    // Parse a single range on the calling thread, or each on its own thread.
+    if(rangeCount == 1){
+        parseRange(0);
+    }
+    else{
+        std::vector<std::thread> workers;
+        for(std::size_t rangeIndex = 0; rangeIndex < rangeCount; ++rangeIndex){
+            workers.push_back(std::thread(parseRange, rangeIndex));
+        }
+        for(std::size_t rangeIndex = 0; rangeIndex < rangeCount; ++rangeIndex){
+            workers[rangeIndex].join();
+        }
+    }
+    
+    /* Count the ranges whose values will be retained, and determine whether
+     * the values of each can be moved into place before the slot of the
+     * next range, which has not yet been moved.
+     */
+    std::size_t retainedRangeCount(0);
+    std::size_t valueEnd = slotBegins[0];
+    bool compactInPlace(true);
+    while(retainedRangeCount < rangeCount){
+        valueEnd += slotCounts[retainedRangeCount] + excessValues[retainedRangeCount].size();
+        ++retainedRangeCount;
+        // Discard all subsequent ranges if this one stopped early.
+        if(rangeStops[retainedRangeCount - 1] != rangeBegins[retainedRangeCount]){
+            break;
+        }
+        if(retainedRangeCount < rangeCount && valueEnd > slotBegins[retainedRangeCount]){
+            compactInPlace = false;
+        }
+    }
+    
+    // The excess values of the final retained range may need more room.
+    if(compactInPlace && valueEnd > numericValues.size()){
+        numericValues.resize(valueEnd);
+    }
+    
+    /* Move or copy the values of each retained range into place, after the
+     * values that were stored before the file was read.
+     */
+    ValueVector compactedValues;
+    if(!compactInPlace){
+        compactedValues.reserve(valueEnd);
+        compactedValues.insert(compactedValues.end(), numericValues.begin(),
+                               numericValues.begin() + slotBegins[0]);
+    }
+    Element * values = numericValues.data();
+    std::size_t valueIndex = slotBegins[0];
+    for(std::size_t rangeIndex = 0; rangeIndex < retainedRangeCount; ++rangeIndex){
+        const Element * slot = values + slotBegins[rangeIndex];
+        const std::vector<Element> & excess = excessValues[rangeIndex];
+        if(compactInPlace){
+            /* The slot never begins before the destination, so the values
+             * can be moved towards the beginning of the vector in order.
+             */
+            std::copy(slot, slot + slotCounts[rangeIndex], values + valueIndex);
+            std::copy(excess.begin(), excess.end(), values + valueIndex + slotCounts[rangeIndex]);
+        }
+        else{
+            compactedValues.insert(compactedValues.end(), slot, slot + slotCounts[rangeIndex]);
+            compactedValues.insert(compactedValues.end(), excess.begin(), excess.end());
+        }
+        valueIndex += slotCounts[rangeIndex] + excess.size();
+    }
+    if(compactInPlace){
+        numericValues.resize(valueIndex);
+    }
+    else{
+        numericValues.swap(compactedValues);
+    }
+}
+
+/** Private method that reads an input file through a pipeline of
+ * concurrent stages.
+ *
+ * \param fileDescriptor - A file descriptor open for reading, which may
+ * refer to a regular file, a pipe or any other source of characters. It is
+ * read until the end of the input, but is not closed.
+ * \param fileSize - The number of characters in the input, if it is known,
+ * or zero otherwise.
+ *
+ * The pipeline has three stages, which run concurrently:
+ *
+ * 1) A reader thread reads the input using the POSIX read() function into
+ *    TextBlock buffers of "pipelineBufferSize" characters. The partial
+ *    token at the end of each buffer is carried over to the beginning of
+ *    the next, so every buffer ends with a complete token. If the input
+ *    begins with the magic number of a gzip or zstd compressed file, the
+ *    reader instead decompresses it, using an InputDecompressor, directly
+ *    into the buffers, so decompression overlaps with parsing and the
+ *    uncompressed contents of the file are never stored in full.
+ * 2) "threadCount" parser threads each parse the buffers that they receive
+ *    into ParsedBlock vectors of values using parseBuffer().
+ * 3) The calling thread, which acts as the reducer, appends the values of
+ *    each ParsedBlock to the "numericValues" member datum or, in streaming
+ *    mode, adds them to "streamedStatistics", "streamedQuantiles" and
+ *    "streamedHistogram".
+ *
+ * Each stage passes its blocks to the next through a BoundedQueue, which
+ * needs no locks, and the next stage returns each block through another
+ * BoundedQueue once it has finished with it, so that the buffers are
+ * recycled. Successive buffers are dealt to the parsers in turn, and the
+ * reducer collects them from the parsers in the same turn, so the values
+ * are reduced in their original order without any sequence numbers. Each
+ * parser has "pipelineBuffersPerParser" buffers of each kind, so that one
+ * can be filled while another is parsed. The memory that the pipeline
+ * occupies is therefore bounded, independently of the size of the input,
+ * and its throughput approaches that of its slowest stage rather than the
+ * sum of the times taken by all three.
+ *
+ * If the size of the input is known, storage for the values is reserved
+ * once the first block has been parsed, from the number of values per
+ * character in that block, so that the stored values are rarely
+ * reallocated.
+ *
+ * \note If a buffer contains an invalid token, its values up to that token
+ * are retained, every subsequent value is discarded, and the reader stops
+ * reading, reproducing the behaviour of a single sequential parse. If the
+ * input cannot be read or decompressed, the values read before the error
+ * are retained and the error is reported to the terminal.
+ *
+ * \return true if the whole of the input was read, or false if it could not
+ * be read or decompressed.
+ */
+template<typename Element>
+bool BasicStatsCalculator<Element>::readPipelined(int fileDescriptor, std::size_t fileSize){
+    std::size_t parserCount = (threadCount > 0) ? threadCount : 1;
+    
+    /* Allocate the buffers of every parser, and the queues through which
+     * the buffers are passed between the stages. Every queue can hold all
+     * the buffers of its parser, so a stage that holds a buffer can always
+     * push it without waiting.
+     */
+    std::size_t blockCount = parserCount*pipelineBuffersPerParser;
+    std::vector<TextBlock> textBlocks(blockCount);
+    std::vector<ParsedBlock<Element> > parsedBlocks(blockCount);
+    std::deque<BoundedQueue<TextBlock *> > textQueues;
+    std::deque<BoundedQueue<TextBlock *> > freeTextQueues;
+    std::deque<BoundedQueue<ParsedBlock<Element> *> > parsedQueues;
+    std::deque<BoundedQueue<ParsedBlock<Element> *> > freeParsedQueues;
+    for(std::size_t parserIndex = 0; parserIndex < parserCount; ++parserIndex){
+        textQueues.emplace_back(pipelineBuffersPerParser);
+        freeTextQueues.emplace_back(pipelineBuffersPerParser);
+        parsedQueues.emplace_back(pipelineBuffersPerParser);
+        freeParsedQueues.emplace_back(pipelineBuffersPerParser);
+    }
+    for(std::size_t blockIndex = 0; blockIndex < blockCount; ++blockIndex){
+        textBlocks[blockIndex].characters.resize(pipelineBufferSize);
+        freeTextQueues[blockIndex % parserCount].push(&textBlocks[blockIndex]);
+        freeParsedQueues[blockIndex % parserCount].push(&parsedBlocks[blockIndex]);
+    }
+    
+    // A flag with which the reducer asks the reader to stop reading.
+    std::atomic<bool> stopReading(false);
+    
+    /* The format in which the input is compressed, and a flag indicating
+     * that it could not be read or decompressed, which are set by the
+     * reader and examined once it has finished.
+     */
+    InputCompression inputCompression(UNCOMPRESSED_INPUT);
+    bool inputFailed(false);
+    
+    /* Launch the reader thread. Block number n is sent to the parser with
+     * index n modulo "parserCount". After the final block, one end-of-input
+     * marker is sent to each parser, in turn.
+     */
+    std::thread reader([&](){
+        std::vector<char> carriedCharacters;
+        std::size_t blockNumber(0);
+        bool endOfInput(false);
+        
+        /* Read the leading characters of the input, and identify the format
+         * in which it is compressed from them. Uncompressed characters are
+         * carried over to the first block. Compressed ones are passed to the
+         * decompressor instead, which then provides the characters of every
+         * block.
+         */
+        char leadingBytes[compressionMagicSize];
+        std::size_t leadingByteCount(0);
+        while(leadingByteCount < compressionMagicSize){
+            ssize_t readSize = read(fileDescriptor, leadingBytes + leadingByteCount,
+                                    compressionMagicSize - leadingByteCount);
+            if(readSize < 0 && errno == EINTR){
+                continue;
+            }
+            if(readSize <= 0){
+                inputFailed = readSize < 0;
+                endOfInput = true;
+                break;
+            }
+            leadingByteCount += readSize;
+        }
+        inputCompression = detectInputCompression(leadingBytes, leadingByteCount);
+        InputDecompressor decompressor;
+        if(inputCompression == UNCOMPRESSED_INPUT){
+            carriedCharacters.assign(leadingBytes, leadingBytes + leadingByteCount);
+        }
+        else if(!decompressor.start(inputCompression, fileDescriptor,
+                                    leadingBytes, leadingByteCount)){
+            inputFailed = true;
+            endOfInput = true;
+        }
+        else{
+            // The end of the compressed input is not the end of the characters.
+            endOfInput = false;
+        }
+        bool decompressing = inputCompression != UNCOMPRESSED_INPUT;
+        
+        while(!endOfInput || !carriedCharacters.empty()){
+            std::size_t parserIndex = blockNumber % parserCount;
+            TextBlock * block = freeTextQueues[parserIndex].pop();
+            char * characters = block->characters.data();
+            
+            // Begin with the partial token carried over from the previous block.
+            std::copy(carriedCharacters.begin(), carriedCharacters.end(), characters);
+            std::size_t filledSize = carriedCharacters.size();
+            
+            /* Fill the rest of the buffer, by reading or decompressing the
+             * input, unless the input ends first.
+             */
+            while(filledSize < pipelineBufferSize && !endOfInput){
+                std::size_t capacity = pipelineBufferSize - filledSize;
+                ssize_t readSize = decompressing ?
+                    decompressor.read(characters + filledSize, capacity) :
+                    read(fileDescriptor, characters + filledSize, capacity);
+                if(!decompressing && readSize < 0 && errno == EINTR){
+                    continue;
+                }
+                if(readSize <= 0 || stopReading.load(std::memory_order_relaxed)){
+                    inputFailed = readSize < 0;
+                    endOfInput = true;
+                    break;
+                }
+                filledSize += readSize;
+            }
+            
+            /* Unless the input has ended, end the block after its last
+             * whitespace character and carry the remaining characters over.
+             * A token that fills the whole buffer cannot be divided, and is
+             * left to be rejected by the parser. If the input could not be
+             * read to its end, its final token may be incomplete, so it is
+             * discarded.
+             */
+            std::size_t blockSize = filledSize;
+            if(!endOfInput || inputFailed){
+                while(blockSize > 0 && !isWhitespace(characters[blockSize - 1])){
+                    --blockSize;
+                }
+                if(blockSize == 0 && !inputFailed){
+                    blockSize = filledSize;
+                }
+            }
+            carriedCharacters.assign(characters + blockSize, characters + filledSize);
+            if(endOfInput){
+                carriedCharacters.clear();
+            }
+            block->size = blockSize;
+            block->endOfInput = false;
+            textQueues[parserIndex].push(block);
+            ++blockNumber;
+        }
+        for(std::size_t markerIndex = 0; markerIndex < parserCount; ++markerIndex){
+            std::size_t parserIndex = blockNumber % parserCount;
+            TextBlock * block = freeTextQueues[parserIndex].pop();
+            block->size = 0;
+            block->endOfInput = true;
+            textQueues[parserIndex].push(block);
+            ++blockNumber;
+        }
+    });
+    
+    /* Launch the parser threads, each of which parses its buffers until it
+     * receives an end-of-input marker, which it forwards to the reducer.
+     */
+    std::vector<std::thread> parsers;
+    for(std::size_t parserIndex = 0; parserIndex < parserCount; ++parserIndex){
+        parsers.push_back(std::thread([&, parserIndex](){
+            bool endOfInput(false);
+            while(!endOfInput){
+                TextBlock * textBlock = textQueues[parserIndex].pop();
+                ParsedBlock<Element> * parsedBlock = freeParsedQueues[parserIndex].pop();
+                const char * textBegin = textBlock->characters.data();
+                const char * textEnd = textBegin + textBlock->size;
+                parsedBlock->values.clear();
+                parsedBlock->complete = parseBuffer(textBegin, textEnd,
+                                                    parsedBlock->values) == textEnd;
+                parsedBlock->characterCount = textBlock->size;
+                parsedBlock->endOfInput = endOfInput = textBlock->endOfInput;
+                freeTextQueues[parserIndex].push(textBlock);
+                parsedQueues[parserIndex].push(parsedBlock);
+            }
+        }));
+    }
+    
+    /* Reduce the parsed blocks in their original order on the calling
+     * thread, until the first end-of-input marker. After an invalid token,
+     * the remaining blocks are collected and discarded.
+     */
+    bool sketchQuantiles = quantileAccuracy > 0.0;
+    bool binValues = streamedHistogram.getBinCount() > 0;
+    bool retainValues(true);
+    bool storageReserved(fileSize == 0);
+    for(std::size_t blockNumber = 0; ; ++blockNumber){
+        std::size_t parserIndex = blockNumber % parserCount;
+        ParsedBlock<Element> * parsedBlock = parsedQueues[parserIndex].pop();
+        if(parsedBlock->endOfInput){
+            break;
+        }
+        const std::vector<Element> & values = parsedBlock->values;
+        if(retainValues && streamingMode){
+            streamedStatistics.addValues(values.data(), values.size());
+            if(sketchQuantiles){
+                streamedQuantiles.addValues(values.data(), values.size());
+            }
+            if(binValues){
+                streamedHistogram.addValues(values.data(), values.size());
+            }
+        }
+        else if(retainValues){
+            // Reserve storage for the estimated number of values in the file.
+            if(!storageReserved && parsedBlock->characterCount > 0){
+                double valueDensity = static_cast<double>(values.size())/
+                    static_cast<double>(parsedBlock->characterCount);
+                numericValues.reserve(numericValues.size() + static_cast<std::size_t>(
+                    static_cast<double>(fileSize)*valueDensity*(1.0 + reservedValueMargin)));
+                storageReserved = true;
+            }
+            numericValues.insert(numericValues.end(), values.begin(), values.end());
+        }
+        if(retainValues && !parsedBlock->complete){
+            retainValues = false;
+            stopReading.store(true, std::memory_order_relaxed);
+        }
+        freeParsedQueues[parserIndex].push(parsedBlock);
+    }
+    
+    // Wait for the reader and every parser to finish.
+    reader.join();
+    for(std::size_t parserIndex = 0; parserIndex < parserCount; ++parserIndex){
+        parsers[parserIndex].join();
+    }
+    
+    // Report how the input was decompressed, or why it could not be read.
+    if(inputFailed && !isInputCompressionSupported(inputCompression)){
+        std::cout << "Unable to decompress the " << getInputCompressionName(inputCompression)
+        << " compressed input, since this program was compiled without support for it."
+        << std::endl;
+    }
+    else if(inputFailed && inputCompression != UNCOMPRESSED_INPUT){
+        std::cout << "Unable to decompress the whole of the "
+        << getInputCompressionName(inputCompression)
+        << " compressed input, which is damaged or incomplete." << std::endl;
+    }
+    else if(inputFailed){
+        std::cout << "Unable to read the whole of the input." << std::endl;
+    }
+    else if(inputCompression != UNCOMPRESSED_INPUT && verbosity != QUIET_OUTPUT){
+        std::cout << "\nThe input was decompressed from "
+        << getInputCompressionName(inputCompression) << " format." << std::endl;
+    }
+    
+    return !inputFailed;
+}
+
+/** Private method returns the running statistics of the stored numeric
+ * values.
+ *
+ * \note The method delegates the computation of the statistics to the
+ * private computeStatistics() method, which traverses the stored values
+ * once. The result is stored in the "cachedStatistics" member datum, and the
+ * summary derived from it in the "cachedSummary" member datum, and both are
+ * reused by subsequent calls until invalidateSummary() is invoked.
+ *
+ * \return A reference to the cached StatsAccumulator.
+ */
+template<typename Element>
+const StatsAccumulator & BasicStatsCalculator<Element>::getStatistics() const {
+    
+    // Recompute the statistics only if the cached copy is out of date.
+    if(!cachedSummaryIsValid){
+        cachedStatistics = computeStatistics();
+        cachedSummary = cachedStatistics.getSummary();
+        
+        /* If quantiles are estimated, add the stored values to a copy of the
+         * sketch of the streamed values.
+         */
+        if(quantileAccuracy > 0.0){
+            cachedQuantiles = streamedQuantiles;
+            cachedQuantiles.addValues(numericValues.data(), numericValues.size());
+        }
+        cachedSummaryIsValid = true;
+    }
+    
+    return cachedStatistics;
+}
+
+/** Private method returns a sketch of the distribution of all values.
+ *
+ * \return A reference to the cached QuantileSketch, which is updated by
+ * getStatistics() whenever the values change. It is empty unless quantiles
+ * are estimated.
+ */
+template<typename Element>
+const QuantileSketch & BasicStatsCalculator<Element>::getQuantileSketch() const {
+    getStatistics();
+    return cachedQuantiles;
+}
+
+/** Private method that writes the estimated and exact quantiles to an
+ * output stream.
+ *
+ * \param stream - The stream to which the quantiles are written.
+ *
+ * The median (p50) and the 90th, 99th and 99.9th percentiles are written in
+ * the format "Statistic_Name = Statistic_Value". The estimated quantiles are
+ * preceded by a header that states their relative accuracy, and are written
+ * only if quantiles are estimated. If the statistics of other values were
+ * merged without a compatible sketch, the reason is stated and every
+ * estimated quantile is written as NaN. Similarly, if the values spanned so
+ * many buckets of the sketch that its lowest buckets were merged, the
+ * reason is stated and the quantiles drawn from the merged buckets, which
+ * would not be within the relative accuracy, are written as NaN. The exact
+ * quantiles are written only if
+ * they have been enabled using setExactQuantiles(), and are cached so that
+ * they are found only once by printStats() and writeStats().
+ */
+template<typename Element>
+void BasicStatsCalculator<Element>::writeQuantiles(std::ostream & stream) const {
+    
+    // Write the estimated quantiles, if they are estimated.
+    if(quantileAccuracy > 0.0){
+        stream << "Quantiles (relative accuracy " << quantileAccuracy << "):\n\n";
+        if(quantilesIncomplete){
+            stream << "Unable to estimate the quantiles, since statistics were merged "
+            << "from a state file, which holds no quantile sketch, or from values "
+            << "without a quantile sketch of the same accuracy.\n\n";
+        }
+        else{
+            bool collapsedQuantiles(false);
+            for(std::size_t quantileIndex = 0; quantileIndex < reportedQuantileCount;
+                ++quantileIndex){
+                collapsedQuantiles = collapsedQuantiles ||
+                    (getQuantileSketch().getCount() > 0 &&
+                     !getQuantileSketch().isWithinAccuracy(
+                         reportedQuantileProbabilities[quantileIndex]));
+            }
+            if(collapsedQuantiles){
+                stream << "Unable to estimate some quantiles within the relative "
+                << "accuracy, since the values spanned too many buckets of the "
+                << "quantile sketch and its lowest buckets were merged. Use a "
+                << "larger accuracy.\n\n";
+            }
+        }
+        for(std::size_t quantileIndex = 0; quantileIndex < reportedQuantileCount;
+            ++quantileIndex){
+            stream << reportedQuantileNames[quantileIndex] << " = "
+            << getQuantile(reportedQuantileProbabilities[quantileIndex]) << "\n";
+        }
+        stream << std::endl;
+    }
+    
+    // Write the exact quantiles, if they are enabled.
+    if(exactQuantilesEnabled){
+        if(cachedExactQuantiles.empty()){
+            cachedExactQuantiles = getExactQuantiles(std::vector<double>(
+                reportedQuantileProbabilities,
+                reportedQuantileProbabilities + reportedQuantileCount));
+        }
+        stream << "Exact quantiles:\n\n";
+        for(std::size_t quantileIndex = 0; quantileIndex < reportedQuantileCount;
+            ++quantileIndex){
+            stream << reportedQuantileNames[quantileIndex] << " = "
+            << cachedExactQuantiles[quantileIndex] << "\n";
+        }
+        stream << std::endl;
+    }
+}
+
+/** Private method returns an empty histogram with the bins selected by
+ * setHistogram().
+ *
+ * \return A Histogram with no values, or with no bins if no histogram was
+ * requested or its bins cannot be determined.
+ *
+ * If the edges of the bins were not specified, the smallest and largest
+ * values are used, obtained from getSummary(). If these are equal, the
+ * edges are moved apart so that the single bin has a non-zero width.
+ *
+ * The automatic rules choose the width of the bins from the number of
+ * values, \f$ n \f$. The rule of Freedman and Diaconis chooses
+ * \f$ 2 \, \mathrm{IQR} / n^{1/3} \f$, where the interquartile range is
+ * found exactly by getExactQuantiles(), and the rule of Scott chooses
+ * \f$ 3.49 \, \sigma / n^{1/3} \f$. The number of bins is the range of the
+ * values divided by this width, rounded up, and is at least one and at most
+ * "maximumAutomaticBinCount".
+ *
+ * Values that were read in streaming mode, or merged from another instance
+ * or a state file, are only included in "streamedHistogram". Since the
+ * edges and width of the bins must be known before the first of them is
+ * binned, no bins can be determined for such values unless both the number
+ * of bins and their edges were specified.
+ */
+template<typename Element>
+Histogram BasicStatsCalculator<Element>::createHistogram() const {
+    
+    // Determine whether the number of bins or their edges were specified.
+    bool specifiedBinCount = (histogramBinning == FIXED_BINS ||
+                              histogramBinning == LOGARITHMIC_BINS);
+    bool specifiedEdges = histogramLowerEdge < histogramUpperEdge;
+    if(histogramBinning == NO_HISTOGRAM ||
+       (streamedStatistics.getCount() > 0 && !(specifiedBinCount && specifiedEdges))){
+        return Histogram();
+    }
+    
+    // Otherwise use the extreme values as the edges, if necessary.
+    double lowerEdge(histogramLowerEdge);
+    double upperEdge(histogramUpperEdge);
+    if(!specifiedEdges){
+        const StatsSummary & summary = getSummary();
+        if(summary.count == 0){
+            return Histogram();
+        }
+        lowerEdge = summary.minimum;
+        upperEdge = summary.maximum;
+        if(lowerEdge == upperEdge){
+            lowerEdge = (histogramBinning == LOGARITHMIC_BINS) ? lowerEdge/2.0 : lowerEdge - 0.5;
+            upperEdge = (histogramBinning == LOGARITHMIC_BINS) ? upperEdge*2.0 : upperEdge + 0.5;
+        }
+    }
+    
+    // Logarithmically spaced bins require positive edges.
+    if(histogramBinning == LOGARITHMIC_BINS){
+        return (lowerEdge > 0.0) ?
+            Histogram(LOGARITHMIC_SCALE, histogramBinCount, lowerEdge, upperEdge) : Histogram();
+    }
+    if(histogramBinning == FIXED_BINS){
+        return Histogram(LINEAR_SCALE, histogramBinCount, lowerEdge, upperEdge);
+    }
+    
+    // Apply the automatic rule to select the width of the bins.
+    double scaledCount = std::cbrt(static_cast<double>(numericValues.size()));
+    double binWidth(0.0);
+    if(histogramBinning == FREEDMAN_DIACONIS_BINS){
+        std::vector<double> probabilities(2);
+        probabilities[0] = 0.25;
+        probabilities[1] = 0.75;
+        std::vector<double> quartiles = getExactQuantiles(probabilities);
+        binWidth = 2.0*(quartiles[1] - quartiles[0])/scaledCount;
+    }
+    else{
+        binWidth = 3.49*getSummary().standardDeviation/scaledCount;
+    }
+    
+    /* Divide the range into bins of that width. A width of zero, for example
+     * if more than half the values are equal, yields a single bin.
+     */
+    double binCount = std::ceil((upperEdge - lowerEdge)/binWidth);
+    if(!(binCount >= 1.0)){
+        binCount = 1.0;
+    }
+    if(binCount > maximumAutomaticBinCount){
+        binCount = maximumAutomaticBinCount;
+    }
+    return Histogram(LINEAR_SCALE, static_cast<std::size_t>(binCount), lowerEdge, upperEdge);
+}
+
+/** Private method that writes the histogram of the values to a text file.
+ *
+ * \param histogramFileName - A string specifying the path of the file.
+ *
+ * The histogram is obtained from getHistogram() and written by the
+ * write(...) method of the Histogram class. A histogram that cannot be
+ * computed, or a file that cannot be written, is reported on the terminal
+ * even with QUIET_OUTPUT verbosity, since the file that the caller expects
+ * will be missing.
+ *
+ * \return true if the histogram was written, false otherwise.
+ */
+template<typename Element>
+bool BasicStatsCalculator<Element>::writeHistogram(const std::string & histogramFileName) const {
+    const Histogram & histogram = getHistogram();
+    if(histogram.getBinCount() == 0){
+        std::cout << "Unable to compute the requested histogram of the values, which would have been saved to:\n\n"
+        << histogramFileName << std::endl;
+        return false;
+    }
+    std::ofstream histogramFile(histogramFileName.c_str());
+    if(!histogramFile.is_open() || !histogram.write(histogramFile)){
+        std::cout << "Unable to write the histogram file:\n\n"
+        << histogramFileName << std::endl;
+        return false;
+    }
+    if(verbosity != QUIET_OUTPUT){
+        std::cout << "A histogram has been saved to:\n\n"
+        << histogramFileName << std::endl;
+    }
+    return true;
+}
+
+/** Private method that marks the cached statistical summary as out of date.
+ *
+ * \note Every method that modifies the "numericValues" or
+ * "streamedStatistics" member data must invoke this method, so that the next call to getSummary() recomputes the
+ * summary from the modified values.
+ */
+template<typename Element>
+void BasicStatsCalculator<Element>::invalidateSummary(){
+    cachedSummaryIsValid = false;
+    cachedExactQuantiles.clear();
+    cachedHistogramIsValid = false;
+}
+
+/** Private method that prints the stored numeric values to the terminal.
+ *
+ * Nothing is printed with QUIET_OUTPUT verbosity. In streaming mode the
+ * values are not stored, so only their number is printed. Otherwise, the
+ * values are printed in the format
+ * "Data (N values) = [ value1, value2, ..., valueN ]". With SUMMARY_OUTPUT
+ * verbosity only the first and last "echoCount" values are printed, with an
+ * ellipsis in place of the rest, so the time taken is independent of the
+ * number of values. With FULL_OUTPUT verbosity every value is printed.
+ */
+template<typename Element>
+void BasicStatsCalculator<Element>::printData() const {
+    
+    // Nothing is printed with QUIET_OUTPUT verbosity.
+    if(verbosity == QUIET_OUTPUT){
+        return;
+    }
+    
+    /* In streaming mode the parsed values were not stored, so only their
+     * number can be reported.
+     */
+    if(streamingMode){
+        std::cout << "Streamed " << streamedStatistics.getCount()
+        << " values without storing them.\n" << std::endl;
+        return;
+    }
+    
+    // Nothing is printed if no numeric values were successfully parsed.
+    if(numericValues.empty()){
+        return;
+    }
+    
+    std::size_t valueCount = numericValues.size();
+    const Element * values = numericValues.data();
+    
+    // Output some preamble
+    std::cout << "Data (" << valueCount << " values) = [ ";
+    
+    if(verbosity == FULL_OUTPUT || valueCount <= 2*echoCount){
+        printValues(std::cout, values, valueCount);
+    }
+    else{
+        // Output the leading values, an ellipsis and the trailing values.
+        if(echoCount > 0){
+            printValues(std::cout, values, echoCount);
+            std::cout << ", ";
+        }
+        std::cout << "...";
+        if(echoCount > 0){
+            std::cout << ", ";
+            printValues(std::cout, values + valueCount - echoCount, echoCount);
+        }
+    }
+    
+    // Output a square bracket and two newlines. Flush the output buffer.
+    std::cout << " ]\n" << std::endl;
+}
+
+// PUBLIC METHODS OF STATSCALCULATOR
+
+/** Default constructor for the BasicStatsCalculator class template.
+ *
+ * Initializes the "threadCount" member datum so that input files are
+ * parsed sequentially on the calling thread unless setThreadCount() is
+ * subsequently invoked, disables streaming mode and the reading pipeline,
+ * selects an abbreviated
+ * echo of the parsed values, disables the estimation and exact computation
+ * of quantiles and the histogram, and marks the (empty) cached summary as
+ * out of date.
+ */
+template<typename Element>
+BasicStatsCalculator<Element>::BasicStatsCalculator() : threadCount(1), streamingMode(false),
+                                                        pipelinedReading(false),
+                                                        verbosity(SUMMARY_OUTPUT), echoCount(5),
+                                                        streamedStatistics(), cachedSummary(),
+                                                        cachedStatistics(),
+                                                        cachedSummaryIsValid(false), blockIndex(),
+                                                        quantileAccuracy(0.0), streamedQuantiles(),
+                                                        cachedQuantiles(), quantilesIncomplete(false),
+                                                        exactQuantilesEnabled(false),
+                                                        valuesAreSorted(false), cachedExactQuantiles(),
+                                                        histogramBinning(NO_HISTOGRAM), histogramBinCount(0),
+                                                        histogramLowerEdge(0.0), histogramUpperEdge(0.0),
+                                                        streamedHistogram(), cachedHistogram(),
+                                                        cachedHistogramIsValid(false) {
+    // No further initialization operations are required.
+}
+
+/** Destructor for the BasicStatsCalculator class template, which is not
+ * required to perform any operations.
+ *
+ * \note Technically an identical definition would be provided by the
+ * C++ compiler if its delcaration were also omitted from the class
+ * definition in the StatsCalculator.h header file.
+ *
+ * \note The explicit declaration and (no-operation) definition are
+ * provided for clarity.
+ */
+template<typename Element>
+BasicStatsCalculator<Element>::~BasicStatsCalculator(){
+  // No deallocation operations are required.
+}
+
+/** Public method returns the sum of the internally stored numeric values.
+ *
+ * \note The method delegates the computation of the required sum to the private
+ * computeSum() method.
+ *
+ * \return The computed sum is returned as a double-precision value.
+ */
+template<typename Element>
+double BasicStatsCalculator<Element>::getSum() const {
+    return computeSum();
+}
+
+
+/** Public method returns the mean of the internally stored numeric values.
+ *
+ * \note The method delegates the computation of the required mean to the private
+ * computeMean() method.
+ *
+ * \return The computed mean is returned as a double-precision value.
+ */
+template<typename Element>
+double BasicStatsCalculator<Element>::getMean() const {
+    return computeMean();
+}
+
+
+/** Public method returns the standard deviation of the internally stored
+ * numeric values.
+ *
+ * \note The method delegates the computation of the required standard deviation
+ * to the private computeSum() method.
+ *
+ * \return The computed standard deviation is returned as a double-precision value.
+ */
+template<typename Element>
+double BasicStatsCalculator<Element>::getStandardDeviation() const {
+    return computeStandardDeviation();
+}
+
+
+/** Public method returns a summary of the statistical properties of the
+ * internally stored numeric values.
+ *
+ * \note The method obtains the required summary from the private
+ * getStatistics() method, which traverses the stored values once. The result
+ * is stored in the "cachedSummary" member datum and returned directly by
+ * subsequent calls until invalidateSummary() is invoked, so repeated calls
+ * cost O(1).
+ *
+ * \note Because the cache is updated from a const method, concurrent calls
+ * on the same instance from several threads must be synchronized by the
+ * caller.
+ *
+ * \return A reference to a StatsSummary structure containing the number of
+ * values, their sum, mean, variance, standard deviation, minimum, maximum,
+ * skewness and excess kurtosis.
+ */
+template<typename Element>
+const StatsSummary & BasicStatsCalculator<Element>::getSummary() const {
+    
+    // Ensure that the cached summary is up to date.
+    getStatistics();
+    
+    return cachedSummary;
+}
+
+
+/** Public method returns an estimate of a quantile of the values.
+ *
+ * \param probability - The fraction of the values that lie below the
+ * quantile, between zero and one.
+ *
+ * \return The estimated quantile, which lies within the relative accuracy
+ * set using setQuantileAccuracy() of the true quantile, or NaN if quantiles
+ * are not estimated, no values have been read, the statistics of other
+ * values were merged without a compatible quantile sketch, or the values
+ * spanned too many buckets of the sketch for this quantile to be estimated
+ * within the relative accuracy.
+ */
+template<typename Element>
+double BasicStatsCalculator<Element>::getQuantile(double probability) const {
+    if(quantileAccuracy <= 0.0 || quantilesIncomplete ||
+       !getQuantileSketch().isWithinAccuracy(probability)){
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    return getQuantileSketch().getQuantile(probability);
+}
+
+
+/** Public method returns the exact values of several quantiles of the
+ * stored numeric values.
+ *
+ * \param probabilities - The fractions of the values that lie below each
+ * quantile, between zero and one.
+ *
+ * \return The quantiles in the same order as "probabilities". NaN is
+ * returned for every quantile if no values are stored, or if any values
+ * were read in streaming mode or merged from another instance, since those
+ * values are not available.
+ *
+ * The quantiles are found by computeExactQuantiles(), which interpolates
+ * linearly between the two values adjacent to each quantile. Unless the
+ * values have been sorted using sortValues(), all the required values are
+ * found together in a single pass by "threadCount" worker threads, each of
+ * which copies only the few of its values that lie close to a quantile.
+ * This is much faster than sorting the values, and requires little
+ * additional memory, so the stored values are never reordered.
+ *
+ * \note The stored values must not include NaN.
+ */
+template<typename Element>
+std::vector<double> BasicStatsCalculator<Element>::getExactQuantiles(const std::vector<double> & probabilities) const {
+    if(streamedStatistics.getCount() > 0){
+        return std::vector<double>(probabilities.size(),
+                                   std::numeric_limits<double>::quiet_NaN());
+    }
+    return computeExactQuantiles(numericValues.data(), numericValues.size(),
+                                 probabilities, threadCount, valuesAreSorted);
+}
+
+
+/** Public method returns a histogram of the values.
+ *
+ * \return A reference to the cached Histogram, which has no bins if no
+ * histogram was requested using setHistogram() or its bins cannot be
+ * determined. See createHistogram() for the way in which they are chosen.
+ *
+ * The stored values are divided into "threadCount" contiguous ranges of
+ * approximately equal size. Each range is binned on its own worker thread
+ * into its own copy of the empty histogram, so the threads share no mutable
+ * data and need no locks, and the copies are then merged. Binning each
+ * value costs only a few operations, so the rate is limited by the
+ * bandwidth of memory rather than by arithmetic. Any streamed values are
+ * included by merging "streamedHistogram".
+ */
+template<typename Element>
+const Histogram & BasicStatsCalculator<Element>::getHistogram() const {
+    
+    // Recompute the histogram only if the cached copy is out of date.
+    if(!cachedHistogramIsValid){
+        cachedHistogram = createHistogram();
+        
+        // Determine the number of ranges into which the values are divided.
+        std::size_t valueCount = numericValues.size();
+        std::size_t rangeCount = threadCount;
+        if(rangeCount > valueCount/minimumHistogramRangeSize){
+            rangeCount = valueCount/minimumHistogramRangeSize;
+        }
+        
+        if(cachedHistogram.getBinCount() == 0){
+            // No bins could be determined, so there is nothing to do.
+        }
+        else if(rangeCount <= 1){
+            cachedHistogram.addValues(numericValues.data(), valueCount);
+        }
+        else{
+            /* Launch one worker thread per range, each of which bins its
+             * range into its own empty histogram.
+             */
+            std::vector<Histogram> rangeHistograms(rangeCount, cachedHistogram);
+            std::vector<std::thread> workers;
+            for(std::size_t rangeIndex = 0; rangeIndex < rangeCount; ++rangeIndex){
+                workers.push_back(std::thread([&, rangeIndex](){
+                    std::size_t firstIndex = rangeIndex*valueCount/rangeCount;
+                    std::size_t lastIndex = (rangeIndex + 1)*valueCount/rangeCount;
+                    rangeHistograms[rangeIndex].addValues(numericValues.data() + firstIndex,
+                                                          lastIndex - firstIndex);
+                }));
+            }
+            for(std::size_t rangeIndex = 0; rangeIndex < rangeCount; ++rangeIndex){
+                workers[rangeIndex].join();
+                cachedHistogram.merge(rangeHistograms[rangeIndex]);
+            }
+        }
+        
+        /* Include the streamed values. If they could not be binned, for
+         * example because some were merged from a state file, no histogram
+         * can describe every value.
+         */
+        if(streamedStatistics.getCount() > 0 && !cachedHistogram.merge(streamedHistogram)){
+            cachedHistogram = Histogram();
+        }
+        cachedHistogramIsValid = true;
+    }
+    
+    return cachedHistogram;
+}
+
+
+/** Public method that sets the number of worker threads among which
+ * readFile() divides the parsing of a single input file.
+ *
+ * \param newThreadCount - The number of worker threads. A value of zero
+ * selects the number of hardware threads available on the current machine.
+ */
+template<typename Element>
+void BasicStatsCalculator<Element>::setThreadCount(unsigned int newThreadCount){
+    
+    // Query the hardware if the caller requested automatic selection.
+    if(newThreadCount == 0){
+        newThreadCount = std::thread::hardware_concurrency();
+    }
+    
+    /* std::thread::hardware_concurrency() may return zero if the number
+     * of hardware threads cannot be determined. Always use at least one.
+     */
+    threadCount = (newThreadCount > 0) ? newThreadCount : 1;
+}
+
+
+/** Public method that enables or disables streaming mode.
+ *
+ * \param enableStreaming - true to enable streaming mode, false to store
+ * parsed values in the "numericValues" member datum.
+ *
+ * In streaming mode readFile() adds each parsed value to the running
+ * statistics held by the "streamedStatistics" member datum and then
+ * discards it. The memory required is therefore independent of the size of
+ * the input file. Statistics of values read in either mode are combined by
+ * getSummary().
+ *
+ * \note The streamed statistics are accumulated in a different order from
+ * those of stored values, so the reported sum, mean and standard deviation
+ * may differ from those obtained without streaming mode in their last few
+ * significant digits. The relative difference of the sum and mean is
+ * bounded by approximately N times the machine epsilon (2.2e-16) for N
+ * values, and is typically far smaller.
+ */
+template<typename Element>
+void BasicStatsCalculator<Element>::setStreamingMode(bool enableStreaming){
+    streamingMode = enableStreaming;
+}
+
+
+/** Public method that selects whether regular files are read through the
+ * pipeline of concurrent stages implemented by readPipelined().
+ *
+ * \param enablePipeline - true to read regular files through the pipeline,
+ * false to memory-map them.
+ *
+ * A memory-mapped file is parsed by worker threads that fault its pages in
+ * as they reach them, relying on the read-ahead of the operating system to
+ * overlap reading with parsing. This is fastest for files that are already
+ * in the page cache. The pipeline instead overlaps reading and parsing
+ * explicitly, on separate threads, which benefits files that must be read
+ * from a slow device or over a network, whose pages would otherwise stall
+ * the parsers.
+ */
+template<typename Element>
+void BasicStatsCalculator<Element>::setPipelinedReading(bool enablePipeline){
+    pipelinedReading = enablePipeline;
+}
+
+
+/** Public method that sets the amount of information that readFile(),
+ * writeStats() and writeState() print to the terminal.
+ *
+ * \param newVerbosity - One of the following values.
+ * - QUIET_OUTPUT prints nothing.
+ * - SUMMARY_OUTPUT prints progress messages, the number of values read by
+ *   readFile() and the first and last few of those values. The number of
+ *   values printed is set using setEchoCount().
+ * - FULL_OUTPUT prints progress messages and every value read.
+ *
+ * The verbosity does not affect printStats(), whose only purpose is to
+ * print to the terminal, or messages that report a failure.
+ *
+ * \note Formatting every value of a large input file can take far longer
+ * than computing its statistics, so FULL_OUTPUT should be reserved for
+ * small files or debugging.
+ */
+template<typename Element>
+void BasicStatsCalculator<Element>::setVerbosity(OutputVerbosity newVerbosity){
+    verbosity = newVerbosity;
+}
+
+
+/** Public method that sets the number of values at each end of the data
+ * that readFile() prints with SUMMARY_OUTPUT verbosity.
+ *
+ * \param newEchoCount - The number of leading and of trailing values to
+ * print. If the data contain no more than twice this number of values, all
+ * of them are printed.
+ */
+template<typename Element>
+void BasicStatsCalculator<Element>::setEchoCount(std::size_t newEchoCount){
+    echoCount = newEchoCount;
+}
+
+
+/** Public method that enables or disables the estimation of quantiles.
+ *
+ * \param relativeAccuracy - The relative accuracy of the estimated
+ * quantiles, which must be supported, as reported by
+ * QuantileSketch::isSupportedAccuracy(), or zero to disable their
+ * estimation.
+ *
+ * \return true if the accuracy is supported or zero, false otherwise. Any
+ * other accuracy, including one of at least one, which would make every
+ * estimate NaN, disables the estimation of quantiles.
+ *
+ * The quantiles are estimated using a QuantileSketch, which counts the
+ * values in logarithmically spaced buckets. Its memory is bounded to a few
+ * kilobytes however many values are read, and in streaming mode each
+ * worker thread of readFile() maintains its own sketch, which is merged
+ * when the thread finishes.
+ *
+ * \note Any existing sketch of streamed values is discarded, so this method
+ * should be called before any values are read. Sketching adds a logarithm
+ * per value to the cost of reading, so it is disabled by default.
+ */
+template<typename Element>
+bool BasicStatsCalculator<Element>::setQuantileAccuracy(double relativeAccuracy){
+    bool supportedAccuracy = relativeAccuracy == 0.0 ||
+                             QuantileSketch::isSupportedAccuracy(relativeAccuracy);
+    quantileAccuracy = (supportedAccuracy && relativeAccuracy > 0.0) ? relativeAccuracy : 0.0;
+    streamedQuantiles = (quantileAccuracy > 0.0) ?
+        QuantileSketch(quantileAccuracy) : QuantileSketch();
+    cachedQuantiles = streamedQuantiles;
+    
+    // The cached sketch must be rebuilt with the new accuracy.
+    invalidateSummary();
+    return supportedAccuracy;
+}
+
 
-// LOCAL HEADER FILES
+/** Public method that enables or disables the reporting of the exact
+ * quantiles of the stored values by printStats() and writeStats().
+ *
+ * \param enableExactQuantiles - true to report the exact median and 90th,
+ * 99th and 99.9th percentiles, false not to.
+ *
+ * See getExactQuantiles() for the method by which they are found.
+ */
+template<typename Element>
+void BasicStatsCalculator<Element>::setExactQuantiles(bool enableExactQuantiles){
+    exactQuantilesEnabled = enableExactQuantiles;
+}
 
-/* The "StatsCalculator.h" header is included to provide a definition of the
- * StatsCalculator class.
+
+/** Public method that selects the bins of the histogram that writeStats()
+ * writes alongside the summary.
+ *
+ * \param binning - The rule by which the bins are chosen.
+ * \param binCount - The number of bins for FIXED_BINS and LOGARITHMIC_BINS,
+ * which is increased to one if it is zero.
+ * \param lowerEdge - The lower edge of the first bin.
+ * \param upperEdge - The upper edge of the last bin, or "lowerEdge" to use
+ * the smallest and largest values.
+ *
+ * If both the number of bins and their edges are specified, the bins are
+ * known before any value is read, so values that are read in streaming
+ * mode are binned as they are parsed, into the "streamedHistogram" member
+ * datum. Any existing histogram of streamed values is discarded, so this
+ * method should be called before any values are read.
  */
-#include "StatsCalculator.h"
+template<typename Element>
+void BasicStatsCalculator<Element>::setHistogram(HistogramBinning binning, std::size_t binCount,
+                                                 double lowerEdge, double upperEdge){
+    histogramBinning = binning;
+    histogramBinCount = (binCount > 0) ? binCount : 1;
+    histogramLowerEdge = lowerEdge;
+    histogramUpperEdge = upperEdge;
+    
+    /* Streamed values can only be binned if the bins are specified, in which
+     * case createHistogram() does not depend on any values.
+     */
+    bool specifiedBins = (binning == FIXED_BINS || binning == LOGARITHMIC_BINS) &&
+        lowerEdge < upperEdge;
+    streamedHistogram = specifiedBins ? createHistogram() : Histogram();
+    
+    // The cached histogram must be rebuilt with the new bins.
+    invalidateSummary();
+}
 
-// PUBLIC METHODS OF STATSCALCULATOR
 
-/** Private method that actually computes the sum of the stored numeric
- * values.
+/** Private method that reads a list of whitespace-separated numeric values
+ * from an open file descriptor, appending them to the "numericValues"
+ * member datum or, in streaming mode, adding them to "streamedStatistics".
  *
- * \return The computed sum is returned as a double-precision value.
+ * \param fileDescriptor - A file descriptor open for reading. It is read
+ * until the end of the input, but is not closed.
+ *
+ * The POSIX fstat() function establishes whether the descriptor refers to a
+ * regular file, which is memory-mapped and parsed in place by
+ * parseMappedFile(), or to a pipe, terminal or socket, whose contents are
+ * only available as a stream and are read in large blocks by
+ * readPipelined(). The same method is used for regular files if it has been
+ * selected using setPipelinedReading(), and for gzip or zstd compressed
+ * regular files, which readPipelined() decompresses as they are parsed.
+ *
+ * \return true if the whole of the input was read, or false if its size and
+ * type could not be established, it could not be memory-mapped, or it could
+ * not be read or decompressed by readPipelined().
  */
-double StatsCalculator::computeSum(){
+template<typename Element>
+bool BasicStatsCalculator<Element>::readOpenFile(int fileDescriptor){
     
-    // If any numeric values were successfully parsed from the input file...
-    if(numericValues.size() > 0){
+    // Flag that is cleared if any part of the input cannot be read.
+    bool readable(false);
+    
+    /* The following if clause ensures that the size and type of the input
+     * file could be established using the POSIX fstat() function.
+     */
+    struct stat fileStatus;
+    if(fstat(fileDescriptor, &fileStatus) == 0){
         
-        /* Declare and zero-initialize a double precision variable with
-         * identifier "sum" store the computed sum
+        // The number of bytes in the input file.
+        std::size_t fileSize = static_cast<std::size_t>(fileStatus.st_size);
+        
+        /* Establish the position from which a regular file will be read.
+         * It is only nonzero if the caller has already read part of the
+         * file, for example from a standard input redirected from a file.
          */
-        double sum(0.0);
+        bool regularFile = S_ISREG(fileStatus.st_mode);
+        off_t position = regularFile ? lseek(fileDescriptor, 0, SEEK_CUR) : 0;
         
-        /* Use the range-based for-loop syntax to iterate over all elements
-         * of the "numericValues" member datum.
-         *
-         * The value of the current element of "numericValues" will be
-         * accessible within the for-loop body using the identifier
-         * "numericValue".
+        /* Examine the leading characters of a regular file, without
+         * consuming them, to establish whether it is compressed. The
+         * characters of a compressed file can only be parsed once they have
+         * been decompressed, so it cannot be parsed in place.
          */
-        for(double numericValue : numericValues){
-            /* Update the value of "sum" by adding the value of the current
-             * element of "numericValues"
+        bool compressedFile(false);
+        if(regularFile && position >= 0){
+            char leadingBytes[compressionMagicSize];
+            ssize_t leadingByteCount = pread(fileDescriptor, leadingBytes,
+                                             compressionMagicSize, position);
+            compressedFile = leadingByteCount > 0 &&
+                detectInputCompression(leadingBytes, leadingByteCount) != UNCOMPRESSED_INPUT;
+        }
+        
+        /* Read a pipe or other input that is not a regular file, whose
+         * size is unknown, through the reading pipeline, as well as any
+         * regular file if the pipeline has been selected, the file must be
+         * read from its current position or it must be decompressed.
+         */
+        if(pipelinedReading || !regularFile || position != 0 || compressedFile){
+            /* The number of characters that remain to be read, if known.
+             * The size of a compressed file says little about the number of
+             * characters that it decompresses to, so it is not used.
+             */
+            std::size_t remainingSize = 0;
+            if(regularFile && !compressedFile && position >= 0 &&
+               static_cast<std::size_t>(position) < fileSize){
+                remainingSize = fileSize - static_cast<std::size_t>(position);
+            }
+            readable = readPipelined(fileDescriptor, remainingSize);
+            
+            /* The stored values have changed, so discard the cached
+             * summary. The appended values may also be out of order.
              */
-            sum += numericValue;
+            invalidateSummary();
+            valuesAreSorted = false;
+        }
+        
+        /* Otherwise, memory-map the entire input file. Rather than copying
+         * the file contents through a stream buffer, the operating system
+         * makes the file's pages directly addressable within the program's
+         * memory, so the parser can read the characters in place.
+         *
+         * An empty file cannot be mapped, but contains no values anyway.
+         */
+        else if(fileSize == 0){
+            readable = true;
+        }
+        else{
+            void * mappedFile = mmap(0, fileSize, PROT_READ, MAP_PRIVATE,
+                                     fileDescriptor, 0);
+            
+            // mmap() returns the special value MAP_FAILED on failure.
+            if(mappedFile != MAP_FAILED){
+                readable = true;
+                
+                /* Advise the operating system that the file will be read
+                 * from beginning to end, which allows it to read ahead
+                 * aggressively.
+                 */
+                madvise(mappedFile, fileSize, MADV_SEQUENTIAL);
+                
+                /* Delegate parsing of the mapped characters to the private
+                 * parseMappedFile() method, which appends every value it
+                 * extracts to the "numericValues" member datum or, in
+                 * streaming mode, adds it to "streamedStatistics".
+                 */
+                const char * fileBegin = static_cast<const char *>(mappedFile);
+                parseMappedFile(fileBegin, fileBegin + fileSize);
+                
+                /* The stored values have changed, so discard the cached
+                 * summary. The appended values may also be out of order.
+                 */
+                invalidateSummary();
+                valuesAreSorted = false;
+                
+                /* Unmap the file, releasing the address range that it
+                 * occupied.
+                 */
+                munmap(mappedFile, fileSize);
+            }
         }
-        // return the computed sum of all elements of "numericValues"
-        return sum;
-    }
-    else{ // No numeric values were successfully parsed from the input file
-        return 0.0;
     }
     
+    return readable;
 }
 
-/** Private method that actually computes the mean of the stored numeric
- * values.
+/** Public method that reads a list of whitespace-separated numeric
+ * values from a text file. It appends those values to the "numericValues"
+ * member datum.
  *
- * \return The computed mean is returned as a double-precision value.
- * 
- * The mean of a sequence of numbers is equal to their sum divided
- * by their multiplicity.
+ * The file is memory-mapped and its contents are parsed in place by the
+ * private parseBuffer() method, avoiding the per-token overhead of
+ * formatted stream extraction. Large files are divided among the number
+ * of worker threads specified using setThreadCount(). In streaming mode,
+ * enabled using setStreamingMode(), the values are discarded after they
+ * have been added to running statistics.
+ *
+ * If the input is not a regular file, for example if it is a pipe, it
+ * cannot be memory-mapped, and it is instead read in large blocks by the
+ * private readPipelined() method. The same method is used for regular files
+ * if it has been selected using setPipelinedReading(). A file compressed
+ * using gzip or zstd, which is recognized from its leading characters
+ * rather than its name, is also read by readPipelined(), which decompresses
+ * it while earlier blocks are parsed.
+ *
+ * A file that cannot be opened or read is reported on the terminal, even
+ * with QUIET_OUTPUT verbosity, and any values read before the error are
+ * retained.
+ *
+ * Requires one argument:
+ * \param infileName - A string specifying to the path of a text file containing
+ *    a whitespace-separated list of numeric values, or "-" to read the
+ *    values from the standard input of the program.
  *
- * \note Computation of the required sum can be delegated
- * to the computeSum() method of StatsCalculator, while the 
- * number of elements in the sequence is provided by the size() method 
- * of the std::vector<double>-type member datum "numericValues".
+ * \return true if the whole of the file was read, or false otherwise.
  */
-double StatsCalculator::computeMean(){
+template<typename Element>
+bool BasicStatsCalculator<Element>::readFile(const std::string & infileName){
     
-    // If any numeric values were successfully parsed from the input file...
-    if(numericValues.size() > 0){
-        
-        // compute and return the mean of the elements of "numericValues"
-        return computeSum()/numericValues.size();
+    // The standard input is read directly, rather than opened by name.
+    if(infileName == "-"){
+        return readDescriptor(STDIN_FILENO);
     }
-    else{ // No numeric values were successfully parsed from the input file
-        return 0.0;
+    
+    // Print an informative message to inform the caller of progress.
+    if(verbosity != QUIET_OUTPUT){
+        std::cout << "Reading data from:\n\n" << infileName << std::endl;
+    }
+    
+    /* Open the input file using the low-level POSIX open() function. The
+     * returned "file descriptor" is a small non-negative integer that
+     * identifies the open file, or -1 if the file could not be opened.
+     *
+     * Note that open() requires a C-String as its argument and the c_str()
+     * method of std::string must be called to extract the required type
+     * from the std::string instance.
+     */
+    int fileDescriptor = open(infileName.c_str(), O_RDONLY);
+    
+    /* If the input file was successfully opened, delegate reading it to the
+     * private readOpenFile() method, and then explicitly close it, freeing
+     * any resources it acquired when it was opened.
+     */
+    bool readable(false);
+    if(fileDescriptor >= 0){
+        readable = readOpenFile(fileDescriptor);
+        close(fileDescriptor);
+    }
+    
+    // Report an unreadable file, even with QUIET_OUTPUT verbosity.
+    if(!readable){
+        std::cout << "Unable to read the input file:\n\n"
+        << infileName << std::endl;
     }
+    
+    // Print the parsed values, or the first and last few of them.
+    printData();
+    
+    return readable;
 }
 
-/** Private method that actually computes the standard deviation of the
- * stored numeric values.
+/** Public method that reads a list of whitespace-separated numeric values
+ * from a file descriptor that is already open, such as the standard input
+ * of the program or one end of a pipe. It appends those values to the
+ * "numericValues" member datum.
  *
- * \return The computed standard deviation is returned as a double-precision value.
+ * \param fileDescriptor - A file descriptor open for reading. It is read
+ * until the end of the input, but is not closed, since it belongs to the
+ * caller.
  *
- * The standard deviation of a sequence of numbers is can be computed
- * as the square root of the difference between the mean of the squares
- * of the numbers and the square of the mean of the numbers.
- * 
- * \f[ \sigma = \sqrt{\langle X^{2} \rangle - \langle X \rangle^{2}} \f]
+ * A descriptor that refers to a regular file is read exactly as by
+ * readFile(). Any other descriptor is read in large blocks by the private
+ * readPipelined() method while earlier blocks are parsed, so the data need
+ * never be written to a temporary file first. In streaming mode, enabled
+ * using setStreamingMode(), the memory that is used is then bounded
+ * independently of the length of the input, and the statistics are
+ * complete once the producer closes its end of the input.
+ *
+ * \return true if the whole of the input was read, or false otherwise.
  */
-double StatsCalculator::computeStandardDeviation(){
+template<typename Element>
+bool BasicStatsCalculator<Element>::readDescriptor(int fileDescriptor){
     
-    // If any numeric values were successfully parsed from the input file...
-    if(numericValues.size() > 0){
-        
-        /* Declare and zero-initialize a double precision variable with
-         * identifier "meanOfSquaredValues" that will ultimately contain
-         * the mean of the squares of the elements of the "numericValues"
-         * member datum.
-         */
-        double meanOfSquaredValues(0.0);
-        
-        /* Use the range-based for-loop syntax to iterate over all elements
-         * of the "numericValues" member datum.
-         *
-         * The value of the current element of "numericValues" will be
-         * accessible within the for-loop body using the identifier
-         * "numericValue".
-         */
-        for(double numericValue : numericValues){
-            /* Update the value of "meanOfSquaredValues" by adding the square
-             * of the value of the current element of "numericValues"
+    // Print an informative message to inform the caller of progress.
+    if(verbosity != QUIET_OUTPUT){
+        std::cout << "Reading data from:\n\n";
+        if(fileDescriptor == STDIN_FILENO){
+            std::cout << "the standard input" << std::endl;
+        }
+        else{
+            std::cout << "file descriptor " << fileDescriptor << std::endl;
+        }
+    }
+    
+    bool readable = readOpenFile(fileDescriptor);
+    
+    // Print the parsed values, or the first and last few of them.
+    printData();
+    
+    return readable;
+}
+
+/** Public method that reads numeric values from a binary data file written
+ * by writeBinary() or by the text-to-binary conversion tool. It appends
+ * those values to the "numericValues" member datum.
+ *
+ * Requires one argument:
+ * \param infileName - A string specifying the path of a binary data file.
+ *
+ * The file is memory-mapped and validated by parseBinaryDataHeader(). Since
+ * the values are stored as raw little-endian double-precision numbers, no
+ * parsing is required: on a little-endian processor they are copied into
+ * "numericValues" with a single bulk copy, so reading the file is limited
+ * by the bandwidth of memory or of the storage device rather than by the
+ * conversion of text to numbers. If no values were stored previously, the
+ * block summaries in the header of the file also become the index used by
+ * getRangeSummary(), so buildIndex() need not be called.
+ *
+ * If the storage type is not double, every value is converted to it as it
+ * is copied. The block summaries then describe the unconverted values, so
+ * they are not used as an index. Every value is first checked by
+ * isStorableValue(), and if any value cannot be converted, for example if
+ * the storage type is std::int64_t and the file holds a value that is not
+ * an integer, the file is reported and no values are added.
+ *
+ * In streaming mode the values are not read at all. Instead, the summaries
+ * of the blocks of values that are stored in the header of the file are
+ * merged with the "streamedStatistics" member datum, so only a few bytes
+ * per 65536 values are touched. The values must still be read if quantiles
+ * are estimated or a histogram with specified bins is requested.
+ *
+ * A file that cannot be read or is not a valid binary data file is
+ * reported on the terminal, and no values are added.
+ *
+ * \return true if the file was read, or false otherwise.
+ */
+template<typename Element>
+bool BasicStatsCalculator<Element>::readBinary(const std::string & infileName){
+    
+    // Print an informative message to inform the caller of progress.
+    if(verbosity != QUIET_OUTPUT){
+        std::cout << "Reading binary data from:\n\n" << infileName << std::endl;
+    }
+    
+    /* Open and memory-map the input file as in readFile(). The header is
+     * validated before any value is used.
+     */
+    bool validFile(false);
+    bool storableValues(true);
+    int fileDescriptor = open(infileName.c_str(), O_RDONLY);
+    struct stat fileStatus;
+    if(fileDescriptor >= 0 && fstat(fileDescriptor, &fileStatus) == 0 &&
+       fileStatus.st_size > 0){
+        std::size_t fileSize = static_cast<std::size_t>(fileStatus.st_size);
+        void * mappedFile = mmap(0, fileSize, PROT_READ, MAP_PRIVATE,
+                                 fileDescriptor, 0);
+        if(mappedFile != MAP_FAILED){
+            const unsigned char * fileBegin = static_cast<const unsigned char *>(mappedFile);
+            BinaryDataHeader header;
+            validFile = parseBinaryDataHeader(fileBegin, fileSize, header);
+            
+            if(validFile && streamingMode){
+                /* Merge the block summaries into a separate accumulator, so
+                 * that an invalid summary leaves the statistics unchanged.
+                 */
+                StatsAccumulator fileStatistics;
+                for(std::size_t blockNumber = 0; blockNumber < header.blockCount;
+                    ++blockNumber){
+                    StatsAccumulator blockStatistics;
+                    validFile = validFile &&
+                        loadBlockStatistics(fileBegin, header, blockNumber, blockStatistics);
+                    fileStatistics.merge(blockStatistics);
+                }
+                if(validFile){
+                    streamedStatistics.merge(fileStatistics);
+                }
+                
+                /* The block summaries do not describe the distribution of the
+                 * values, so the values must be read to sketch their quantiles
+                 * or to bin them.
+                 */
+                bool sketchQuantiles = quantileAccuracy > 0.0;
+                bool binValues = streamedHistogram.getBinCount() > 0;
+                if(validFile && (sketchQuantiles || binValues)){
+                    const unsigned char * data = fileBegin + header.dataOffset;
+                    std::size_t valueCount = static_cast<std::size_t>(header.valueCount);
+                    if(isLittleEndianHost()){
+                        const double * dataValues = reinterpret_cast<const double *>(data);
+                        if(sketchQuantiles){
+                            streamedQuantiles.addValues(dataValues, valueCount);
+                        }
+                        if(binValues){
+                            streamedHistogram.addValues(dataValues, valueCount);
+                        }
+                    }
+                    else{
+                        for(std::size_t valueIndex = 0; valueIndex < valueCount; ++valueIndex){
+                            double value = loadDouble(data + 8*valueIndex);
+                            if(sketchQuantiles){
+                                streamedQuantiles.addValue(value);
+                            }
+                            if(binValues){
+                                streamedHistogram.addValue(value);
+                            }
+                        }
+                    }
+                }
+            }
+            else if(validFile){
+                /* Advise the operating system that the values will be read
+                 * from beginning to end.
+                 */
+                madvise(mappedFile, fileSize, MADV_SEQUENTIAL);
+                const unsigned char * data = fileBegin + header.dataOffset;
+                std::size_t valueCount = static_cast<std::size_t>(header.valueCount);
+                
+                /* Unless the storage type is double, establish that every
+                 * value can be converted to it before any value is stored.
+                 */
+                if(!std::is_same<Element, double>::value){
+                    for(std::size_t valueIndex = 0; valueIndex < valueCount &&
+                        storableValues; ++valueIndex){
+                        storableValues = isStorableValue<Element>(
+                            loadDouble(data + 8*valueIndex));
+                    }
+                    validFile = storableValues;
+                }
+                
+                if(validFile){
+                    /* If no values are stored yet, the blocks of the file
+                     * coincide with the blocks of the stored values, so the
+                     * summaries of its complete blocks form a ready-made index.
+                     */
+                    if(numericValues.empty() && std::is_same<Element, double>::value){
+                        std::vector<StatsAccumulator> fileIndex(valueCount/binaryDataBlockSize);
+                        bool validIndex(true);
+                        for(std::size_t blockNumber = 0; blockNumber < fileIndex.size(); ++blockNumber){
+                            validIndex = validIndex &&
+                                loadBlockStatistics(fileBegin, header, blockNumber,
+                                                    fileIndex[blockNumber]);
+                        }
+                        if(validIndex){
+                            blockIndex.swap(fileIndex);
+                        }
+                    }
+                    
+                    /* On a little-endian processor the stored bytes are already
+                     * in the native representation, so they are appended with a
+                     * bulk copy. The insert(...) method copies, converting to the
+                     * storage type if necessary, directly into the new elements,
+                     * without first initializing them.
+                     */
+                    if(isLittleEndianHost()){
+                        const double * dataValues = reinterpret_cast<const double *>(data);
+                        numericValues.insert(numericValues.end(), dataValues,
+                                             dataValues + valueCount);
+                    }
+                    // Otherwise, each value must be converted individually.
+                    else{
+                        numericValues.reserve(numericValues.size() + valueCount);
+                        for(std::size_t valueIndex = 0; valueIndex < valueCount; ++valueIndex){
+                            numericValues.push_back(static_cast<Element>(
+                                loadDouble(data + 8*valueIndex)));
+                        }
+                    }
+                }
+            }
+            
+            /* The stored values have changed, so discard the cached summary.
+             * The appended values may also be out of order.
              */
-            meanOfSquaredValues += numericValue*numericValue;
+            invalidateSummary();
+            valuesAreSorted = false;
+            
+            munmap(mappedFile, fileSize);
         }
-        
-        /* The current value of "meanOfSquaredValues" corresponds to the SUM
-         * of the squares of the elements of "numericValues". The required mean
-         * can be obtained by dividing by the number of elements comprising
-         * numericValues. This number is returned by the  size() method
-         * of the std::vector<double>-type member datum "numericValues".
-         */
-        meanOfSquaredValues /= numericValues.size();
-        
-        /* Compute and return the required standard deviation. The square
-         * of the mean of the elements of "numericValues" is computed
-         * by delegating computation of the mean to getMean() and squaring
-         * the result.
-         *
-         * Technical note: It would be more efficient to call getMean() once,
-         * then store and square the result. In reality, almost all modern
-         * optimizing compilers will recognize this and produce equivalent
-         * machine code from the subsequent statement.
-         *
-         * The STL function std::sqrt provided by the <cmath> header file is
-         * used to compute the square root.
-         */
-        return std::sqrt(meanOfSquaredValues - getMean()*getMean());
     }
-    else{ // No numeric values were successfully parsed from the input file
-        return 0.0;
+    if(fileDescriptor >= 0){
+        close(fileDescriptor);
+    }
+    
+    // Report an invalid file, even with QUIET_OUTPUT verbosity.
+    if(!storableValues){
+        std::cout << "Unable to store the values of the binary data file:\n\n"
+        << infileName << "\n\nsince it holds a value that the storage type cannot "
+        << "represent, such as a value that is not an integer." << std::endl;
+        return false;
     }
+    if(!validFile){
+        std::cout << "Unable to read the binary data file:\n\n"
+        << infileName << std::endl;
+        return false;
+    }
+    
+    // Print the values that were read, or the first and last few of them.
+    printData();
+    
+    return true;
 }
 
-
-// PUBLIC METHODS OF STATSCALCULATOR
-
-/** Default constructor for the StatsCalculator class, which is not
- * required to perform any operations.
+/** Public method that writes the internally stored numeric values to a
+ * binary data file, which can subsequently be read much faster than a text
+ * file using readBinary().
  *
- * \note Technically an identical definition would be provided by the
- * C++ compiler if its delcaration were also omitted from the class 
- * definition in the StatsCalculator.h header file. 
+ * Requires one argument:
+ * \param outfileName - A string specifying the path of the binary data file
+ * to be written.
  *
- * \note The explicit declaration and (no-operation) definition are
- * provided for clarity.
+ * See writeBinaryDataFile() for a description of the layout of the file.
+ *
+ * \note Only the values stored in the "numericValues" member datum are
+ * written. Values that were read in streaming mode, or merged from state
+ * files, are not stored and cannot be written. Binary data files always hold
+ * double precision values, so values of another storage type are first
+ * converted by getDoubleValues().
  */
-StatsCalculator::StatsCalculator(){
-    // No initialization operations are required.
+template<typename Element>
+void BasicStatsCalculator<Element>::writeBinary(const std::string & outfileName) const {
+    std::vector<double> convertedValues;
+    if(writeBinaryDataFile(outfileName, getDoubleValues(numericValues, convertedValues),
+                           numericValues.size())){
+        if(verbosity != QUIET_OUTPUT){
+            std::cout << numericValues.size()
+            << " values have been saved in binary form to:\n\n"
+            << outfileName << std::endl;
+        }
+    }
+    else{
+        std::cout << "Unable to save the values in binary form to:\n\n"
+        << outfileName << std::endl;
+    }
 }
 
-/** Destructor for the StatsCalculator class, which is not
- * required to perform any operations.
+/** Public method that builds an index of the statistics of each complete
+ * block of consecutive stored values.
  *
- * \note Technically an identical definition would be provided by the
- * C++ compiler if its delcaration were also omitted from the class
- * definition in the StatsCalculator.h header file.
+ * The stored values are divided into blocks of "binaryDataBlockSize"
+ * (65536) values, beginning with the first, and the statistics of each
+ * complete block are accumulated in the "blockIndex" member datum. Range
+ * queries using getRangeSummary() can then combine the statistics of whole
+ * blocks instead of scanning their values.
  *
- * \note The explicit declaration and (no-operation) definition are
- * provided for clarity.
+ * Since values are only ever appended to the "numericValues" member datum,
+ * the statistics of blocks that are already indexed remain valid. Only the
+ * complete blocks that follow them are indexed, so the index can be
+ * extended cheaply after further files have been read.
+ *
+ * \note The index is built automatically when a binary data file is read
+ * into an instance that stores no values, using the block summaries in the
+ * header of the file.
  */
-StatsCalculator::~StatsCalculator(){
-  // No deallocation operations are required.
+template<typename Element>
+void BasicStatsCalculator<Element>::buildIndex(){
+    std::size_t blockCount = numericValues.size()/binaryDataBlockSize;
+    for(std::size_t blockNumber = blockIndex.size(); blockNumber < blockCount;
+        ++blockNumber){
+        StatsAccumulator blockStatistics;
+        blockStatistics.addValues(numericValues.data() + blockNumber*binaryDataBlockSize,
+                                  binaryDataBlockSize);
+        blockIndex.push_back(blockStatistics);
+    }
 }
 
-/** Public method returns the sum of the internally stored numeric values.
+/** Public method that sorts the stored numeric values into ascending order.
  *
- * \note The method delegates the computation of the required sum to the private
- * computeSum() method.
+ * The values are sorted by sortValuesInParallel(), which sorts one part of
+ * the values per worker thread and then merges the parts. Sorting is never
+ * performed implicitly, since it takes much longer than finding a few
+ * quantiles using getExactQuantiles() and destroys the original order of
+ * the values. Once sorted, however, any number of exact quantiles can be
+ * read directly.
  *
- * \return The computed sum is returned as a double-precision value.
+ * \note The order in which the values are summed changes, so the summary is
+ * recomputed and may differ in its last few significant digits. The index
+ * of block statistics no longer describes the stored values, so it is
+ * discarded.
  */
-double StatsCalculator::getSum(){
-    return computeSum();
+template<typename Element>
+void BasicStatsCalculator<Element>::sortValues(){
+    sortValuesInParallel(numericValues.data(), numericValues.size(), threadCount);
+    blockIndex.clear();
+    invalidateSummary();
+    valuesAreSorted = true;
 }
 
-
-/** Public method returns the mean of the internally stored numeric values.
+/** Public method that writes the index of block statistics to a binary
+ * index file, so that later runs can read it using readIndex() instead of
+ * building it again.
  *
- * \note The method delegates the computation of the required mean to the private
- * computeMean() method.
+ * Requires one argument:
+ * \param indexFileName - A string specifying the path of the index file.
  *
- * \return The computed mean is returned as a double-precision value.
+ * See writeBlockIndexFile() for a description of the layout of the file.
  */
-double StatsCalculator::getMean(){
-    return computeMean();
+template<typename Element>
+void BasicStatsCalculator<Element>::writeIndex(const std::string & indexFileName) const {
+    if(writeBlockIndexFile(indexFileName, blockIndex, numericValues.size())){
+        if(verbosity != QUIET_OUTPUT){
+            std::cout << "The block index has been saved to:\n\n"
+            << indexFileName << std::endl;
+        }
+    }
+    else{
+        std::cout << "Unable to save the block index to:\n\n"
+        << indexFileName << std::endl;
+    }
 }
 
-
-/** Public method returns the standard deviation of the internally stored
- * numeric values.
+/** Public method that reads an index of block statistics from a binary
+ * index file written by writeIndex().
  *
- * \note The method delegates the computation of the required standard deviation
- * to the private computeSum() method.
+ * Requires one argument:
+ * \param indexFileName - A string specifying the path of the index file.
  *
- * \return The computed standard deviation is returned as a double-precision value.
+ * \return true if the index was read and replaced the existing index, false
+ * if the file could not be read, is not a valid index file, or describes a
+ * different number of values from the number that are stored.
+ *
+ * \note The index file records the number of values that were indexed, but
+ * not the values themselves. It is the caller's responsibility to ensure
+ * that the index file belongs to the data that were read.
  */
-double StatsCalculator::getStandardDeviation(){
-    return computeStandardDeviation();
+template<typename Element>
+bool BasicStatsCalculator<Element>::readIndex(const std::string & indexFileName){
+    std::vector<StatsAccumulator> fileIndex;
+    std::uint64_t indexedValueCount(0);
+    if(!readBlockIndexFile(indexFileName, fileIndex, indexedValueCount) ||
+       indexedValueCount != numericValues.size()){
+        return false;
+    }
+    blockIndex.swap(fileIndex);
+    return true;
 }
 
-
-/** Public method that reads a list of whitespace-separated numeric
- * values from a text file. It appends those values to the "numericValues"
- * member datum.
+/** Public method returns a summary of the statistical properties of a
+ * contiguous range of the internally stored numeric values.
  *
- * Requires one argument:
- * \param infileName - A string specifying to the path of a text file containing
- *    a whitespace-separated list of numeric values.
+ * \param firstIndex - The index of the first value in the range.
+ * \param lastIndex - The index one past the last value in the range. It is
+ * reduced to the number of stored values if it exceeds it.
+ *
+ * \return A StatsSummary structure containing the number of values in the
+ * range, their sum, mean, variance and standard deviation. If the range is
+ * empty, every member is zero.
+ *
+ * The range is divided into a partial block at each end and a sequence of
+ * whole blocks between them. The values of the partial blocks are scanned,
+ * while the statistics of each whole block that has been indexed, using
+ * buildIndex() or readIndex(), are merged from the index. A query of a range
+ * of n values therefore costs O(n/B + B) operations for blocks of B values,
+ * rather than O(n). Without an index, every value in the range is scanned.
+ *
+ * \note Values read in streaming mode are not stored, and so cannot be
+ * queried. The merged statistics may differ from those of a direct scan of
+ * the same values in their last few significant digits.
  */
-void StatsCalculator::readFile(const std::string & infileName){
+template<typename Element>
+StatsSummary BasicStatsCalculator<Element>::getRangeSummary(std::size_t firstIndex,
+                                                            std::size_t lastIndex) const {
+    if(lastIndex > numericValues.size()){
+        lastIndex = numericValues.size();
+    }
     
-    // Print an informative message to inform the caller of progress.
-    std::cout << "Reading data from:\n\n" << infileName << std::endl;
+    StatsAccumulator statistics;
+    if(firstIndex >= lastIndex){
+        return statistics.getSummary();
+    }
+    const Element * values = numericValues.data();
     
-    /* Declare and zero-initialize a double precision variable with
-     * identifier "numericValue" to provide temporary storage for
-     * numeric values that are parsed from the input text file.
+    /* Find the first block that begins within the range and the end of the
+     * last indexed block that ends within it.
      */
-    double numericValue(0.0);
+    std::size_t firstBlock = (firstIndex + binaryDataBlockSize - 1)/binaryDataBlockSize;
+    std::size_t endBlock = lastIndex/binaryDataBlockSize;
+    if(endBlock > blockIndex.size()){
+        endBlock = blockIndex.size();
+    }
     
-    /* Instantiate a std::ifstream object that will be appropriately
-     * configured to read data from a file at the path specified by
-     * the method argument "infileName".
-     *
-     * Note that the constructor requires a C-String as its argument
-     * and the c_str() method of std::string must be called to extract
-     * the required type from the std::string instance.
-     */
-    std::ifstream inputFile(infileName.c_str());
+    // If no indexed block lies entirely within the range, scan every value.
+    if(firstBlock >= endBlock){
+        statistics.addValues(values + firstIndex, lastIndex - firstIndex);
+        return statistics.getSummary();
+    }
     
-    /* The following if clause ensures that the input file was
-     * successfully opened AND that the file is in a good state
-     * for reading. The former criterion is established if the
-     * to the is_open() method provided by std::ifstream returns
-     * true. The latter criterion is established if the good()
-     * method provided by std::ifstream returns true.
-     *
-     * Technical Note: In C++ the logical and "&&" operator uses
-     * "short-circuit" semantics. Since both operands MUST evaluate
-     * to true in order for the expression to be true, it is possible
-     * to determine the expression result by examining only one
-     * operand IF that operand evaluates to false. By convention
-     * C++ examines the left-hand operand first and does not evaluate
-     * the right-hand operand if the left-hand operand is false.
-     * This means that if the file is NOT open, then no attempt will
-     * be made to assess its readability state.
-     */
-    if(inputFile.is_open() && inputFile.good()){
-        /* Begin a while loop that will iterate until the end of the
-         * file is reached (inputFile.eof() == true) or the file
-         * becomes unreadable (inputFile.good() == false). Note the
-         * use of the "!" operator to invert the return value of
-         * inputFile.eof().
-         */
-        while(!inputFile.eof() && inputFile.good()){
-            /* The stream input operator (">>") extracts a whitespace-
-             * separated token (character sequence) from the input file
-             * and attempts to interpret the sequence as a double
-             * precision value. If successful, it assigns the interpretted
-             * value to the "numericValue" variable
-             */
-            inputFile >> numericValue;
-            /* The push_back() method provided by std::vector<double> is
-             * invoked to append the extracted numeric value to the end of
-             * the numericValues member datum.
-             */
-            numericValues.push_back(numericValue);
-        }
-        /* Explicitly close the input file, freeing any resources it acquired
-         * when it was constructed or during its operation.
-         */
-        inputFile.close();
+    // Scan the leading partial block, merge the whole blocks...
+    std::size_t blocksBegin = firstBlock*binaryDataBlockSize;
+    std::size_t blocksEnd = endBlock*binaryDataBlockSize;
+    statistics.addValues(values + firstIndex, blocksBegin - firstIndex);
+    for(std::size_t blockNumber = firstBlock; blockNumber < endBlock; ++blockNumber){
+        statistics.merge(blockIndex[blockNumber]);
     }
     
-    // If any numeric values were successfully parsed from the input file...
-    if(numericValues.size() > 0){
-        /* Print a summary of the extracted data to the terminal in the format
-         * "Data = [ value1, value2, ..., valueN ]".
-         */
-        
-        // Output some preamble
-        std::cout << "Data = [ ";
-        // Loop over all but the last element of the "numericValues" member datum
-        for(std::vector<double>::iterator numValIt = numericValues.begin();
-            numValIt != --numericValues.end();
-            ++numValIt){
-            /* Output the value of the current element of "numericValues", followed
-             * by a comma.
-             */
-            std::cout << *numValIt << ", ";
-        }
-        /* Output the value of the final element of "numericValues", followed
-         * by a square bracket and two newlines. Flush the output buffer.
-         */
-        std::cout << *(--numericValues.end())
-        << " ]\n" << std::endl;
+    // ...and scan the trailing partial block.
+    statistics.addValues(values + blocksEnd, lastIndex - blocksEnd);
+    
+    return statistics.getSummary();
+}
+
+/** Public method that merges the statistical properties of the numeric
+ * values of another BasicStatsCalculator with those of this one.
+ *
+ * \param other - The BasicStatsCalculator whose statistics should be merged.
+ *
+ * The running statistics of the other instance, obtained from its private
+ * getStatistics() method, are added to the "streamedStatistics" member
+ * datum, so that they contribute to the summary exactly as if the values
+ * that they describe had been read in streaming mode. The values stored by
+ * the other instance are not copied. If both instances estimate quantiles
+ * with the same accuracy, their quantile sketches are also merged, and if
+ * both compute histograms with the same specified bins, their histograms
+ * are also merged.
+ *
+ * If this instance estimates quantiles but the other instance has values
+ * and no sketch of the same accuracy, the merged sketch would describe
+ * only some of the values, so the quantiles are instead reported as NaN,
+ * just as the histogram is discarded if the bins differ.
+ */
+template<typename Element>
+void BasicStatsCalculator<Element>::merge(const BasicStatsCalculator & other){
+    const StatsAccumulator & otherStatistics = other.getStatistics();
+    streamedStatistics.merge(otherStatistics);
+    
+    /* Merge the quantile sketches if both instances estimate quantiles with
+     * the same accuracy. Otherwise the merged sketch would omit the other
+     * values, so the quantiles are marked as incomplete.
+     */
+    if(quantileAccuracy > 0.0 && other.quantileAccuracy == quantileAccuracy &&
+       !other.quantilesIncomplete){
+        streamedQuantiles.merge(other.getQuantileSketch());
+    }
+    else if(quantileAccuracy > 0.0 && otherStatistics.getCount() > 0){
+        quantilesIncomplete = true;
+    }
+    
+    /* Merge the histograms if their bins are identical. Otherwise the
+     * streamed histogram would omit the other values, so it is discarded.
+     */
+    if(!streamedHistogram.merge(other.getHistogram())){
+        streamedHistogram = Histogram();
     }
+    
+    // The statistics have changed, so discard the cached summary.
+    invalidateSummary();
 }
 
 /** Public method that prints a summary of the statistical properties that this
  * class computes to the terminal.
  */
-void StatsCalculator::printStats(){
+template<typename Element>
+void BasicStatsCalculator<Element>::printStats() const {
     /* Output a multiline formatted message to the terminal. The first line
-     * is a simple explanatory header. The next three lines output annotated
+     * is a simple explanatory header. The next eight lines output annotated
      * values of the statistical quantities that are computed by the class
      * using the format: "Statistic_Name = Statistic_Value"
      *
-     * The required statistical values are obtained using the public getter
-     * methods: getSum(), getMean() and getStandardDeviation()
+     * The required statistical values are all obtained from a single
+     * StatsSummary structure returned by the public getSummary() method, so
+     * the stored numeric values are traversed at most once, and not at all
+     * if the summary has already been cached.
      */
+    const StatsSummary & summary = getSummary();
     std::cout << "Simple statistical analysis of numeric data:\n\n"
-    << "Sum =  " << getSum() << "\n"
-    << "Mean = " << getMean() << "\n"
-    << "Standard Deviation = " << getStandardDeviation()
+    << "Sum =  " << summary.sum << "\n"
+    << "Mean = " << summary.mean << "\n"
+    << "Standard Deviation = " << summary.standardDeviation << "\n"
+    << "Count = " << summary.count << "\n"
+    << "Minimum = " << summary.minimum << "\n"
+    << "Maximum = " << summary.maximum << "\n"
+    << "Skewness = " << summary.skewness << "\n"
+    << "Excess Kurtosis = " << summary.excessKurtosis
     << "\n" << std::endl;
+    
+    // Output the estimated and exact quantiles, if they are enabled.
+    writeQuantiles(std::cout);
 }
 
 /** Public method that writes a summary of the statistical properties that this
@@ -337,8 +2789,14 @@ void StatsCalculator::printStats(){
  * Requires one argument:
  * \param outfileName - A string specifying to the path for a text file to which
  * the statistics summary should be written.
+ *
+ * A file that cannot be written is reported on the terminal, even with
+ * QUIET_OUTPUT verbosity, since the file that the caller expects will be
+ * missing. Returns true if the summary, and the histogram if one was
+ * requested, were written, and false otherwise.
  */
-void StatsCalculator::writeStats(const std::string & outfileName){
+template<typename Element>
+bool BasicStatsCalculator<Element>::writeStats(const std::string & outfileName) const {
     /* Instantiate a std::ofstream object that will be appropriately
      * configured to write data to a file at the path specified by
      * the method argument "outfileName". 
@@ -363,19 +2821,30 @@ void StatsCalculator::writeStats(const std::string & outfileName){
         /* Output a multiline formatted message to the sucessfully
          * opened output file. 
          *
-         * The first line is a simple explanatory header. The next three lines 
+         * The first line is a simple explanatory header. The next eight lines
          * output annotated values of the statistical quantities that are computed 
          * by the class using the format: "Statistic_Name = Statistic_Value"
          *
-         * The required statistical values are obtained using the public getter
-         * methods: getSum(), getMean() and getStandardDeviation()
+         * The required statistical values are all obtained from a single
+         * StatsSummary structure returned by the public getSummary() method,
+         * so the stored numeric values are traversed at most once, and not at
+         * all if the summary has already been cached.
          */
+        const StatsSummary & summary = getSummary();
         outputFile << "Simple statistical analysis of numeric data:\n\n"
-        << "Sum =  " << getSum() << "\n"
-        << "Mean = " << getMean() << "\n"
-        << "Standard Deviation = " << getStandardDeviation()
+        << "Sum =  " << summary.sum << "\n"
+        << "Mean = " << summary.mean << "\n"
+        << "Standard Deviation = " << summary.standardDeviation << "\n"
+        << "Count = " << summary.count << "\n"
+        << "Minimum = " << summary.minimum << "\n"
+        << "Maximum = " << summary.maximum << "\n"
+        << "Skewness = " << summary.skewness << "\n"
+        << "Excess Kurtosis = " << summary.excessKurtosis
         << "\n" << std::endl;
         
+        // Output the estimated and exact quantiles, if they are enabled.
+        writeQuantiles(outputFile);
+        
         /* Explicitly close the input file, freeing any resources it acquired
          * when it was constructed or during its operation.
          * 
@@ -384,10 +2853,142 @@ void StatsCalculator::writeStats(const std::string & outfileName){
          */
         outputFile.close();
     }
+    
+    /* If the file could not be opened, or an error occurred while it was
+     * written or closed, the stream is in a failed state. Report this even
+     * with QUIET_OUTPUT verbosity.
+     */
+    bool written = static_cast<bool>(outputFile);
+    if(!written){
+        std::cout << "Unable to write the statistical summary to:\n\n"
+        << outfileName << std::endl;
+    }
     /* Output an informative message to inform the caller of successful
      * operation of the method.
      */
-    std::cout << "A statistical summary has been saved to:\n\n"
-    << outfileName
-    << std::endl;
+    else if(verbosity != QUIET_OUTPUT){
+        std::cout << "A statistical summary has been saved to:\n\n"
+        << outfileName
+        << std::endl;
+    }
+    
+    /* If a histogram was requested, write it to a second file whose path is
+     * that of the summary with the suffix ".hist".
+     */
+    if(histogramBinning != NO_HISTOGRAM){
+        written = writeHistogram(outfileName + ".hist") && written;
+    }
+    
+    return written;
+}
+
+/** Public method that writes the running statistics of the internally
+ * stored numeric values to a compact binary state file.
+ *
+ * Requires one argument:
+ * \param stateFileName - A string specifying the path of the binary file to
+ * which the state should be written.
+ *
+ * The state file contains a single fixed-size record, described in the
+ * documentation of StatsAccumulator::writeState(), from which the exact
+ * statistics of the values can be recovered. A large data set can therefore
+ * be divided into shards that are processed independently, for example on
+ * different machines, and the state files of the shards merged using
+ * mergeState() without reading any of the values again.
+ *
+ * \note The running statistics are obtained from the private getStatistics()
+ * method, so writing the state after printing or writing the summary does
+ * not require another pass over the stored values. The state comprises the
+ * moments only, and does not include any quantile sketch.
+ */
+template<typename Element>
+void BasicStatsCalculator<Element>::writeState(const std::string & stateFileName) const {
+    
+    /* Open the state file for output in binary mode, so that no characters
+     * are translated on platforms that distinguish text and binary files.
+     */
+    std::ofstream stateFile(stateFileName.c_str(), std::ios::out | std::ios::binary);
+    
+    if(stateFile.is_open() && stateFile.good() &&
+       getStatistics().writeState(stateFile)){
+        stateFile.close();
+        
+        /* Output an informative message to inform the caller of successful
+         * operation of the method.
+         */
+        if(verbosity != QUIET_OUTPUT){
+            std::cout << "The aggregate state has been saved to:\n\n"
+            << stateFileName
+            << std::endl;
+        }
+    }
+    else{
+        std::cout << "Unable to save the aggregate state to:\n\n"
+        << stateFileName
+        << std::endl;
+    }
+}
+
+/** Public method that reads a binary state file and merges its running
+ * statistics with those of the internally stored numeric values.
+ *
+ * Requires one argument:
+ * \param stateFileName - A string specifying the path of a binary state file
+ * written by writeState().
+ *
+ * \return true if the state file was read and merged successfully, false if
+ * it could not be opened, was truncated or has an unexpected layout. In the
+ * latter case the statistics are unchanged.
+ *
+ * The merged statistics are added to the "streamedStatistics" member datum,
+ * so that they contribute to the summary exactly as if the values that they
+ * describe had been read in streaming mode. Merging the state files of the
+ * shards of a data set therefore yields the same summary as reading the
+ * whole data set, up to floating-point rounding, at a cost of a few
+ * arithmetic operations per file.
+ *
+ * \note A state record contains neither a quantile sketch nor a histogram.
+ * If quantiles are estimated, they are therefore reported as NaN once a
+ * non-empty state has been merged, together with a message that explains
+ * why, and no histogram is written.
+ */
+template<typename Element>
+bool BasicStatsCalculator<Element>::mergeState(const std::string & stateFileName){
+    
+    // Open the state file for input in binary mode.
+    std::ifstream stateFile(stateFileName.c_str(), std::ios::in | std::ios::binary);
+    
+    /* Read the record into a separate accumulator, so that an invalid file
+     * leaves the existing statistics unchanged.
+     */
+    StatsAccumulator stateStatistics;
+    if(!stateFile.is_open() || !stateStatistics.readState(stateFile)){
+        return false;
+    }
+    
+    streamedStatistics.merge(stateStatistics);
+    
+    /* A state record does not include a histogram, so no histogram can
+     * include the merged values. Nor does it include a quantile sketch, so
+     * any estimated quantiles would describe only some of the values, and
+     * are instead reported as NaN.
+     */
+    streamedHistogram = Histogram();
+    if(quantileAccuracy > 0.0 && stateStatistics.getCount() > 0){
+        quantilesIncomplete = true;
+    }
+    
+    // The statistics have changed, so discard the cached summary.
+    invalidateSummary();
+    
+    return true;
 }
+
+// EXPLICIT INSTANTIATIONS
+
+/* The class template is instantiated for each supported storage type, so
+ * that its methods can be defined in this file rather than in the header.
+ */
+template class BasicStatsCalculator<double>;
+template class BasicStatsCalculator<float>;
+template class BasicStatsCalculator<std::int64_t>;
@@ -1,13 +1,333 @@
 /// \file StatsCalculatorTest.cpp TEST FILE for StatsCalculator class
 
+// The <atomic> header is included to provide the STL std::atomic type.
+#include <atomic>
+// The <chrono> header is included to provide the std::chrono::steady_clock type.
+#include <chrono>
+// The <cstdint> header is included to provide the std::uint64_t type.
+#include <cstdint>
+// The <cstdlib> header is included to provide the std::strtoul(...) and std::strtod(...) functions.
+#include <cstdlib>
+// The <fstream> header is included to provide the std::ifstream type.
+#include <fstream>
 // The <iostream> header is included to enable textual terminal output.
 #include <iostream>
+// The <mutex> header is included to provide the std::mutex type.
+#include <mutex>
+// The <string> header is included to provide the STL std::string type.
+#include <string>
+// The <thread> header is included to provide the std::thread type.
+#include <thread>
+// The <utility> header is included to provide the STL std::pair type.
+#include <utility>
+// The <vector> header is included to provide the STL std::vector type.
+#include <vector>
+
+// The POSIX <glob.h> header is included to provide the glob(...) function.
+#include <glob.h>
+// The POSIX <sys/stat.h> header is included to provide the stat(...) function.
+#include <sys/stat.h>
 
 /* Include StatsCalculator.h to provide class definition of
  * StatsCalculator
  */
 #include "StatsCalculator.h"
 
+/* Include ColumnTable.h to provide class definition of ColumnTable
+ */
+#include "ColumnTable.h"
+
+/* Include GroupedStats.h to provide class definition of GroupedStats
+ */
+#include "GroupedStats.h"
+
+/* Include WeightedStats.h to provide class definition of WeightedStats
+ */
+#include "WeightedStats.h"
+
+// HELPER FUNCTIONS
+
+/** Helper function that appends the input files of a batch that match a
+ * path or wildcard pattern to a list.
+ *
+ * \param pattern - A file path, which may contain the wildcard characters
+ * "*", "?" and "[". Quoting a pattern on the command line prevents the
+ * shell from expanding it, which avoids the limit on the length of a
+ * command line when a batch contains very many files.
+ * \param inputs - The list to which the matching paths are appended, in
+ * lexicographic order.
+ *
+ * A path that contains no wildcard characters is appended unchanged, even
+ * if no such file exists, so that the failure is reported when the batch
+ * is processed.
+ */
+static void appendBatchInputs(const std::string & pattern,
+                              std::vector<std::string> & inputs){
+    
+    // A path without wildcard characters does not need to be expanded.
+    if(pattern.find_first_of("*?[") == std::string::npos){
+        inputs.push_back(pattern);
+        return;
+    }
+    
+    /* Expand the pattern using the POSIX glob() function, which fills the
+     * "gl_pathv" array of a glob_t structure with the matching paths.
+     */
+    glob_t matches;
+    if(glob(pattern.c_str(), 0, 0, &matches) == 0){
+        for(std::size_t matchIndex = 0; matchIndex < matches.gl_pathc; ++matchIndex){
+            inputs.push_back(matches.gl_pathv[matchIndex]);
+        }
+    }
+    
+    // Free the memory that glob() allocated to store the matching paths.
+    globfree(&matches);
+}
+
+/** Helper function that appends the input files of a batch listed in a
+ * manifest file to a list.
+ *
+ * \param manifestName - The path of a text file that contains one path or
+ * wildcard pattern per line. Empty lines are ignored.
+ * \param inputs - The list to which the paths are appended.
+ *
+ * \return true if the manifest file could be opened, false otherwise.
+ */
+static bool readManifest(const std::string & manifestName,
+                         std::vector<std::string> & inputs){
+    std::ifstream manifestFile(manifestName.c_str());
+    if(!manifestFile.is_open()){
+        return false;
+    }
+    
+    // Read the manifest one line at a time.
+    std::string line;
+    while(std::getline(manifestFile, line)){
+        if(!line.empty()){
+            appendBatchInputs(line, inputs);
+        }
+    }
+    return true;
+}
+
+/** Helper function that returns the path of the summary file to which the
+ * statistics of an input file of a batch are written.
+ *
+ * \param inputName - The path of the input file.
+ * \param outputDirectory - The directory in which the summary files should
+ * be written. If it is empty, each summary file is written alongside its
+ * input file.
+ *
+ * \return The path of the input file with the suffix ".stats" appended,
+ * relocated to "outputDirectory" if one was specified.
+ */
+static std::string batchOutputName(const std::string & inputName,
+                                   const std::string & outputDirectory){
+    if(outputDirectory.empty()){
+        return inputName + ".stats";
+    }
+    
+    // Remove any directories from the input path, leaving the file name.
+    std::string::size_type separator = inputName.find_last_of('/');
+    std::string fileName = (separator == std::string::npos) ?
+        inputName : inputName.substr(separator + 1);
+    return outputDirectory + "/" + fileName + ".stats";
+}
+
+/** Helper function that interprets the specification of the bins of a
+ * histogram given with the "--histogram" option.
+ *
+ * \param specification - "N" for N bins of equal width, "log:N" for N
+ * logarithmically spaced bins, "fd" for the rule of Freedman and Diaconis or
+ * "scott" for the rule of Scott.
+ * \param binning - Set to the rule by which the bins are chosen.
+ * \param binCount - Set to the number of bins, if it is specified.
+ *
+ * \return true if the specification is valid, false otherwise.
+ */
+static bool parseHistogramSpecification(const std::string & specification,
+                                        HistogramBinning & binning,
+                                        std::size_t & binCount){
+    if(specification == "fd"){
+        binning = FREEDMAN_DIACONIS_BINS;
+        return true;
+    }
+    if(specification == "scott"){
+        binning = SCOTT_BINS;
+        return true;
+    }
+    
+    // Otherwise the specification must end with a positive number of bins.
+    std::string countText(specification);
+    binning = FIXED_BINS;
+    if(specification.compare(0, 4, "log:") == 0){
+        countText = specification.substr(4);
+        binning = LOGARITHMIC_BINS;
+    }
+    char * countEnd(0);
+    binCount = std::strtoul(countText.c_str(), &countEnd, 10);
+    return !countText.empty() && *countEnd == '\0' && binCount > 0;
+}
+
+/** Helper function that computes the statistics of every input file of a
+ * batch concurrently, writing a summary of each to its own output file.
+ *
+ * \param inputs - The paths of the input files.
+ * \param outputDirectory - The directory in which the summary files should
+ * be written, or an empty string to write each alongside its input file.
+ * \param workerCount - The number of worker threads. A value of zero
+ * selects one thread per hardware thread.
+ * \param binaryInput - true if the input files are binary data files
+ * rather than text files.
+ * \param streamingMode - true if the values of each file should be
+ * discarded after they have been added to running statistics.
+ * \param quantileAccuracy - The relative accuracy of the quantiles
+ * estimated for each file, or zero if quantiles are not estimated.
+ * \param histogramBinning - The rule by which the bins of the histogram of
+ * each file are chosen, or NO_HISTOGRAM.
+ * \param histogramBinCount - The number of bins, if it is specified.
+ * \param histogramLowerEdge - The lower edge of the first bin.
+ * \param histogramUpperEdge - The upper edge of the last bin, or
+ * "histogramLowerEdge" to use the extreme values of each file.
+ * \param combined - A StatsCalculator with which the statistics of every
+ * input file are merged, to provide a combined summary of the batch.
+ *
+ * \return The number of input files that could not be read, or whose
+ * summaries could not be written.
+ *
+ * A fixed pool of worker threads is created once. Each worker repeatedly
+ * claims the next unprocessed file by incrementing a shared atomic index,
+ * so that the work is balanced dynamically however much the sizes of the
+ * files differ, and the cost of starting a process and warming its caches
+ * is paid once for the whole batch rather than once per file. Each file is
+ * parsed on a single thread by its own quiet StatsCalculator, so the
+ * workers share no mutable state except the index and the terminal.
+ *
+ * On completion the number of files that were successfully processed per
+ * second, and the aggregate throughput of those files in megabytes per
+ * second, are printed to the terminal.
+ */
+static std::size_t processBatch(const std::vector<std::string> & inputs,
+                                const std::string & outputDirectory,
+                                unsigned int workerCount, bool binaryInput,
+                                bool streamingMode, double quantileAccuracy,
+                                HistogramBinning histogramBinning,
+                                std::size_t histogramBinCount,
+                                double histogramLowerEdge, double histogramUpperEdge,
+                                StatsCalculator & combined){
+    
+    // Resolve the default number of workers, and never exceed one per file.
+    if(workerCount == 0){
+        workerCount = std::thread::hardware_concurrency();
+    }
+    if(workerCount == 0){
+        workerCount = 1;
+    }
+    if(workerCount > inputs.size()){
+        workerCount = static_cast<unsigned int>(inputs.size());
+    }
+    
+    /* The statistics of each file are retained, so that they can be merged
+     * into the combined summary in the order of the input files. This makes
+     * the combined summary independent of the order in which the workers
+     * happened to finish.
+     */
+    std::vector<StatsCalculator> fileStatistics(inputs.size());
+    for(std::size_t fileIndex = 0; fileIndex < fileStatistics.size(); ++fileIndex){
+        fileStatistics[fileIndex].setQuantileAccuracy(quantileAccuracy);
+        fileStatistics[fileIndex].setHistogram(histogramBinning, histogramBinCount,
+                                               histogramLowerEdge, histogramUpperEdge);
+    }
+    
+    // The index of the next file to be claimed by a worker.
+    std::atomic<std::size_t> nextFileIndex(0);
+    
+    // Totals that are updated by every worker.
+    std::atomic<std::uint64_t> totalBytes(0);
+    std::atomic<std::size_t> failedFileCount(0);
+    std::atomic<std::size_t> processedFileCount(0);
+    
+    // A mutex that prevents the messages of different workers interleaving.
+    std::mutex terminalMutex;
+    
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+    
+    /* Define the task that each worker performs, as a lambda function that
+     * captures the variables above by reference.
+     */
+    auto worker = [&](){
+        for(std::size_t fileIndex = nextFileIndex++; fileIndex < inputs.size();
+            fileIndex = nextFileIndex++){
+            const std::string & inputName = inputs[fileIndex];
+            
+            /* Establish that the input file exists, and its size, using the
+             * POSIX stat() function.
+             */
+            struct stat fileStatus;
+            if(stat(inputName.c_str(), &fileStatus) != 0){
+                ++failedFileCount;
+                std::lock_guard<std::mutex> lock(terminalMutex);
+                std::cout << "Unable to read the input file: " << inputName << std::endl;
+                continue;
+            }
+            
+            /* Compute and write the statistics of the file, then release
+             * any stored values, retaining only the running statistics. A
+             * file that exists but cannot be read, which readFile() or
+             * readBinary() has already reported, is counted as failed and
+             * contributes nothing to the combined summary or the throughput.
+             * So is a file whose summary cannot be written, which
+             * writeStats() has already reported.
+             */
+            StatsCalculator statsCalculator;
+            statsCalculator.setVerbosity(QUIET_OUTPUT);
+            statsCalculator.setStreamingMode(streamingMode);
+            statsCalculator.setQuantileAccuracy(quantileAccuracy);
+            statsCalculator.setHistogram(histogramBinning, histogramBinCount,
+                                         histogramLowerEdge, histogramUpperEdge);
+            bool readable = binaryInput ? statsCalculator.readBinary(inputName)
+                                        : statsCalculator.readFile(inputName);
+            if(!readable){
+                ++failedFileCount;
+                continue;
+            }
+            if(!statsCalculator.writeStats(batchOutputName(inputName, outputDirectory))){
+                ++failedFileCount;
+                continue;
+            }
+            totalBytes += static_cast<std::uint64_t>(fileStatus.st_size);
+            ++processedFileCount;
+            fileStatistics[fileIndex].merge(statsCalculator);
+        }
+    };
+    
+    // Start the workers, and wait for all of them to finish.
+    std::vector<std::thread> workers;
+    for(unsigned int workerIndex = 0; workerIndex < workerCount; ++workerIndex){
+        workers.push_back(std::thread(worker));
+    }
+    for(std::size_t workerIndex = 0; workerIndex < workers.size(); ++workerIndex){
+        workers[workerIndex].join();
+    }
+    
+    // Merge the statistics of every file, in order.
+    for(std::size_t fileIndex = 0; fileIndex < fileStatistics.size(); ++fileIndex){
+        combined.merge(fileStatistics[fileIndex]);
+    }
+    
+    // Report the throughput of the batch.
+    double elapsedSeconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - startTime).count();
+    double megabytes = static_cast<double>(totalBytes)/1.0e6;
+    std::cout << "Processed " << processedFileCount << " files (" << megabytes
+    << " MB) using " << workerCount << " worker threads in " << elapsedSeconds
+    << " s:\n\n"
+    << "Files/s = " << processedFileCount/elapsedSeconds << "\n"
+    << "MB/s = " << megabytes/elapsedSeconds << "\n" << std::endl;
+    
+    return failedFileCount;
+}
+
 /** The main function is the entry point for the program. The program is designed
  * to be invoked with two command line arguments and will output an error message
  * if the incorrect number of command line arguments is not supplied.
@@ -21,6 +341,123 @@
  * path to which a file containing a statistical summary of the numeric values
  * provided by the input file.
  *
+ * The two paths may be preceded by the following options:
+ *
+ * - "--threads N" divides the parsing of the input file among N worker
+ *   threads. A value of zero selects one thread per hardware thread. In
+ *   batch mode, each input file is parsed by a single one of the N threads.
+ * - "--stream" computes the statistics while the input file is parsed,
+ *   without storing its values, so that files larger than the available
+ *   memory can be processed.
+ * - An input file named "-" is the standard input of the program, so the
+ *   output of another program, such as zcat or ssh, can be piped into it
+ *   without first being written to a temporary file. Any other open file
+ *   descriptor N can be read as the file "/dev/fd/N". Unless "--binary" or
+ *   "--reduce" is given, the standard input is read in streaming mode, as
+ *   if "--stream" were also given, so that the memory that is used is
+ *   bounded however much data is piped in, and the summary is written once
+ *   the input ends. Since its values are not stored, the standard input
+ *   cannot be combined with "--exact-quantiles", "--sort" or "--range".
+ * - An input file, or the standard input, that is compressed using gzip
+ *   or zstd is recognized from its leading bytes and decompressed while it
+ *   is parsed, without being written to disk. Support for gzip requires the
+ *   program to be compiled with COMPRESSED_INPUT_GZIP defined and linked
+ *   with -lz, and support for zstd requires COMPRESSED_INPUT_ZSTD and -lzstd.
+ *   Otherwise a compressed input is reported as unsupported.
+ * - "--pipeline" reads the input file in large blocks through a pipeline
+ *   of concurrent stages, in which one thread reads the next block while
+ *   the "--threads N" parser threads parse the previous blocks and the
+ *   main thread stores or accumulates their values, instead of
+ *   memory-mapping it. An input that cannot be memory-mapped, such as a
+ *   pipe, is always read in this way.
+ * - "--binary" reads the input file as a binary data file, written by the
+ *   text-to-binary conversion tool, instead of a text file. No parsing is
+ *   required, and in combination with "--stream" only the block summaries
+ *   in the header of the file are read.
+ * - "--range FIRST LAST" prints a summary of the values with indices from
+ *   FIRST up to, but not including, LAST. The option may be repeated.
+ * - "--index FILE" reads an index of block summaries from FILE, which
+ *   allows each range to be summarized without scanning most of its values.
+ *   If FILE cannot be read, the index is built and written to FILE, so that
+ *   later runs can reuse it. A binary data file contains its own index.
+ * - "--quantiles ACCURACY" additionally estimates the median and the 90th,
+ *   99th and 99.9th percentiles of the values, each within a relative
+ *   error of ACCURACY (for example 0.01), using a fixed few kilobytes of
+ *   memory. This also works in streaming and batch modes. ACCURACY must be
+ *   at least 0.0001 and less than 1. If the values span too wide a range
+ *   for the sketch at that accuracy, the quantiles that cannot be
+ *   estimated within it are reported as NaN, with a message that explains
+ *   why.
+ * - "--exact-quantiles" additionally reports the exact values of the same
+ *   quantiles, which are found without sorting the values. They are only
+ *   available if the values are stored, i.e. without "--stream".
+ * - "--sort" sorts the stored values before the summary is printed, after
+ *   which the exact quantiles are read directly.
+ * - "--columns" reads the input file as rows of several numeric columns,
+ *   separated by commas or by whitespace and optionally preceded by a
+ *   header line that names them, and prints and writes a summary of each
+ *   column. Only "--threads", "--quiet" and "--covariance" also apply in
+ *   this mode. The input file may be compressed, but since it is parsed in
+ *   place by several threads, it cannot be the standard input, and the
+ *   same applies to "--group-by" and "--weighted".
+ * - "--covariance" additionally reports the covariance and Pearson
+ *   correlation matrices of the columns in "--columns" mode.
+ * - "--group-by" reads the input file as lines that each contain a key,
+ *   such as the name of a sensor, followed by a numeric value, separated by
+ *   a comma or by whitespace and optionally preceded by a header line, and
+ *   prints and writes a summary of the values of each distinct key. Only
+ *   "--threads", "--quiet" and "--sort-keys" also apply in this mode.
+ * - "--sort-keys" reports the groups of "--group-by" mode in order of their
+ *   keys, rather than in the order in which the keys first appear.
+ * - "--weighted" reads the input file as lines that each contain a value
+ *   followed by its weight, such as the number of events with that value,
+ *   and prints and writes the weighted sum, mean and variances of the
+ *   values without expanding them into repeated values. Only "--threads"
+ *   and "--quiet" also apply in this mode.
+ * - "--storage TYPE" stores the values as "double" (the default), as
+ *   "float", which halves the memory that they occupy but rounds each value
+ *   to about seven significant digits, or as "int64", which parses integer
+ *   counts exactly and stops at the first value that is not an integer.
+ *   The statistics are accumulated in double precision whatever the type.
+ * - "--histogram SPEC" additionally writes a histogram of the values to a
+ *   file whose path is that of the output file with the suffix ".hist".
+ *   SPEC is "N" for N bins of equal width, "log:N" for N logarithmically
+ *   spaced bins, "fd" for bins of the width chosen by the rule of Freedman
+ *   and Diaconis, or "scott" for the rule of Scott.
+ * - "--histogram-range LOWER UPPER" sets the edges of the histogram, which
+ *   are otherwise the smallest and largest values. With "--stream", or for
+ *   the combined histogram of a batch, a histogram can only be computed if
+ *   both N and its edges are specified.
+ * - "--quiet" suppresses the progress messages and the echo of the values
+ *   read from the input file.
+ * - "--echo N" prints only the first and last N values read from the input
+ *   file, together with their number. This is the default, with N = 5, so
+ *   that the time spent printing is independent of the size of the file.
+ * - "--full" prints every value read from the input file.
+ * - "--save-state FILE" additionally writes the aggregate state of the
+ *   values to the binary file FILE, so that it can later be merged with the
+ *   states of other shards of the same data set. If the input file cannot
+ *   be read, no state is written and the program returns a nonzero value,
+ *   so that the shard cannot be merged as though it held no values.
+ * - "--reduce" interprets every path except the last as a binary state file
+ *   written using "--save-state", and merges their aggregate states instead
+ *   of reading an input file. The last path is the output file, as usual.
+ *   Since only the states are read, a reduce over thousands of shards is
+ *   very fast. A state contains only the moments and extreme values, so
+ *   quantiles requested using "--quantiles" are reported as NaN, with a
+ *   message that explains why, and no histogram can be written.
+ * - "--batch" interprets every path as an input file, or as a wildcard
+ *   pattern that matches several input files, and processes all of them
+ *   concurrently using a pool of "--threads N" worker threads. The summary
+ *   of each input file is written to a file with the suffix ".stats".
+ * - "--manifest FILE" enables batch mode and reads additional input paths
+ *   or patterns from FILE, one per line.
+ * - "--output-dir DIR" writes the summary files of a batch to the
+ *   directory DIR instead of alongside the input files.
+ * - "--combined FILE" additionally prints a summary of all the input files
+ *   of a batch and writes it to FILE. In batch mode, "--save-state" writes
+ *   the combined aggregate state.
+ *
  * The program instantiates a StatsCalculator object and invokes its public methods
  * in order to:
  *
@@ -34,57 +471,526 @@
  * of the numeric values to the user-specified output file.
  *
  * \return The program returns zero on success and 1 if an incorrect number of command line
- * arguments was provided.
+ * arguments was provided, if a state file could not be merged in reduce mode,
+ * or if any input file of a batch could not be read.
  */
 int main(int argc, char * argv[]){
     
-    /* Verify that the program was invoked with TWO command line arguments.
-     * Recall that argc enumerates all the command line tokens, including
-     * the executable name itself.
+    /* Declare a variable to store the number of parsing threads requested
+     * using the "--threads" option. By default a single thread is used.
      */
-    if(argc == 3){
-        // Instantiate a StatsCalculator object with identifier "statsCalculator"
-        StatsCalculator statsCalculator;
+    unsigned int threadCount(1);
+    
+    /* Declare a flag that records whether streaming mode was requested
+     * using the "--stream" option.
+     */
+    bool streamingMode(false);
+    
+    /* Declare a flag that records whether the reading pipeline was
+     * requested using the "--pipeline" option.
+     */
+    bool pipelinedReading(false);
+    
+    /* Declare a flag that records whether the input files are binary data
+     * files, as requested using the "--binary" option.
+     */
+    bool binaryInput(false);
+    
+    /* Declare variables to store the verbosity and the number of values
+     * echoed at each end of the data, which are selected using the
+     * "--quiet", "--echo" and "--full" options.
+     */
+    OutputVerbosity verbosity(SUMMARY_OUTPUT);
+    std::size_t echoCount(5);
+    
+    /* Declare a flag that records whether reduce mode was requested using
+     * the "--reduce" option.
+     */
+    bool reduceMode(false);
+    
+    /* Declare a string to store the path of the state file requested using
+     * the "--save-state" option. It remains empty if no state is requested.
+     */
+    std::string stateFileName;
+    
+    /* Declare a vector to store the ranges of values requested using the
+     * "--range" option, and a string to store the path of the index file
+     * specified using the "--index" option.
+     */
+    std::vector<std::pair<std::size_t, std::size_t> > ranges;
+    std::string indexFileName;
+    
+    /* Declare a variable to store the relative accuracy of the quantiles
+     * requested using the "--quantiles" option. By default quantiles are not
+     * estimated.
+     */
+    double quantileAccuracy(0.0);
+    
+    /* Declare flags that record whether exact quantiles and sorting were
+     * requested using the "--exact-quantiles" and "--sort" options.
+     */
+    bool exactQuantiles(false);
+    bool sortValues(false);
+    
+    /* Declare a flag that records whether the input file should be read as
+     * several columns, as requested using the "--columns" option.
+     */
+    bool columnMode(false);
+    
+    /* Declare a flag that records whether the covariance and correlation
+     * matrices of the columns were requested using the "--covariance" option.
+     */
+    bool covarianceMatrices(false);
+    
+    /* Declare flags that record whether the values of the input file should
+     * be grouped by key, as requested using the "--group-by" option, and
+     * whether the groups should be sorted by key, as requested using the
+     * "--sort-keys" option.
+     */
+    bool groupMode(false);
+    bool sortKeys(false);
+    
+    /* Declare a flag that records whether the input file should be read as
+     * pairs of values and weights, as requested using the "--weighted"
+     * option.
+     */
+    bool weightedMode(false);
+    
+    /* Declare a string to store the type in which the values are stored, as
+     * selected using the "--storage" option. By default they are stored in
+     * double precision.
+     */
+    std::string storageType("double");
+    
+    /* Declare variables to store the bins of the histogram requested using
+     * the "--histogram" and "--histogram-range" options. By default no
+     * histogram is written, and its edges are the extreme values.
+     */
+    HistogramBinning histogramBinning(NO_HISTOGRAM);
+    std::size_t histogramBinCount(0);
+    double histogramLowerEdge(0.0);
+    double histogramUpperEdge(0.0);
+    
+    /* Declare a flag that records whether batch mode was requested using
+     * the "--batch" or "--manifest" options.
+     */
+    bool batchMode(false);
+    
+    /* Declare strings to store the paths specified using the "--manifest",
+     * "--output-dir" and "--combined" options, which remain empty if the
+     * options are not used.
+     */
+    std::string manifestName;
+    std::string outputDirectory;
+    std::string combinedFileName;
+    
+    /* Declare an STL vector of strings to store the command line arguments
+     * that are not options, i.e. the input and output file paths.
+     */
+    std::vector<std::string> paths;
+    
+    /* Declare a flag that records whether an unrecognized or incomplete
+     * option was encountered.
+     */
+    bool invalidOption(false);
+    
+    /* Loop over all command line tokens except the executable name itself,
+     * which is stored in "argv[0]".
+     */
+    for(int argIndex = 1; argIndex < argc; ++argIndex){
+        
+        // Convert the current token to a std::string for convenient comparison.
+        std::string argument(argv[argIndex]);
         
-        /* Call the readFile method provided by StatsCalculator, passing the 
-         * FIRST command line argument stored in the character-array "argv[1]".
-         *
-         * This will attempt to read a sequence of whitespace-spearated numeric
-         * values from a text file at the file-system path specified by "argv[1]".
-         *
-         * Technical Note: The readFile(...) method requires a reference to a 
-         * std::string as its argument. C++ is able to implicitly convert 
-         * "argv[1]" (which has type "char *" to the required type because 
-         * std::string provides a constructor that accepts a "char *" as its 
-         * single argument. This is known as a "Converting Constructor".
+        if(argument == "--threads" && argIndex + 1 < argc){
+            /* The "--threads" option consumes the subsequent token, which is
+             * converted to an unsigned integer by std::strtoul.
+             */
+            threadCount = std::strtoul(argv[++argIndex], 0, 10);
+        }
+        else if(argument == "--stream"){
+            streamingMode = true;
+        }
+        else if(argument == "--pipeline"){
+            pipelinedReading = true;
+        }
+        else if(argument == "--binary"){
+            binaryInput = true;
+        }
+        else if(argument == "--range" && argIndex + 2 < argc){
+            // The "--range" option consumes the two subsequent tokens.
+            std::size_t firstIndex = std::strtoul(argv[++argIndex], 0, 10);
+            std::size_t lastIndex = std::strtoul(argv[++argIndex], 0, 10);
+            ranges.push_back(std::make_pair(firstIndex, lastIndex));
+        }
+        else if(argument == "--index" && argIndex + 1 < argc){
+            indexFileName = argv[++argIndex];
+        }
+        else if(argument == "--quantiles" && argIndex + 1 < argc){
+            /* The accuracy is converted to a double by std::strtod, and must
+             * be a number that the quantile sketch supports.
+             */
+            char * accuracyEnd(0);
+            quantileAccuracy = std::strtod(argv[++argIndex], &accuracyEnd);
+            invalidOption = invalidOption || accuracyEnd == argv[argIndex] ||
+                *accuracyEnd != '\0' || !QuantileSketch::isSupportedAccuracy(quantileAccuracy);
+        }
+        else if(argument == "--exact-quantiles"){
+            exactQuantiles = true;
+        }
+        else if(argument == "--sort"){
+            sortValues = true;
+        }
+        else if(argument == "--columns"){
+            columnMode = true;
+        }
+        else if(argument == "--covariance"){
+            covarianceMatrices = true;
+        }
+        else if(argument == "--group-by"){
+            groupMode = true;
+        }
+        else if(argument == "--sort-keys"){
+            sortKeys = true;
+        }
+        else if(argument == "--weighted"){
+            weightedMode = true;
+        }
+        else if(argument == "--storage" && argIndex + 1 < argc){
+            // The "--storage" option consumes the subsequent token.
+            storageType = argv[++argIndex];
+            invalidOption = invalidOption ||
+                (storageType != "double" && storageType != "float" && storageType != "int64");
+        }
+        else if(argument == "--histogram" && argIndex + 1 < argc){
+            invalidOption = invalidOption ||
+                !parseHistogramSpecification(argv[++argIndex], histogramBinning,
+                                             histogramBinCount);
+        }
+        else if(argument == "--histogram-range" && argIndex + 2 < argc){
+            // The "--histogram-range" option consumes the two subsequent tokens.
+            histogramLowerEdge = std::strtod(argv[++argIndex], 0);
+            histogramUpperEdge = std::strtod(argv[++argIndex], 0);
+        }
+        else if(argument == "--quiet"){
+            verbosity = QUIET_OUTPUT;
+        }
+        else if(argument == "--echo" && argIndex + 1 < argc){
+            verbosity = SUMMARY_OUTPUT;
+            echoCount = std::strtoul(argv[++argIndex], 0, 10);
+        }
+        else if(argument == "--full"){
+            verbosity = FULL_OUTPUT;
+        }
+        else if(argument == "--save-state" && argIndex + 1 < argc){
+            // The "--save-state" option consumes the subsequent token.
+            stateFileName = argv[++argIndex];
+        }
+        else if(argument == "--reduce"){
+            reduceMode = true;
+        }
+        else if(argument == "--batch"){
+            batchMode = true;
+        }
+        else if(argument == "--manifest" && argIndex + 1 < argc){
+            batchMode = true;
+            manifestName = argv[++argIndex];
+        }
+        else if(argument == "--output-dir" && argIndex + 1 < argc){
+            outputDirectory = argv[++argIndex];
+        }
+        else if(argument == "--combined" && argIndex + 1 < argc){
+            combinedFileName = argv[++argIndex];
+        }
+        else if(argument.size() > 2 && argument.compare(0, 2, "--") == 0){
+            // Any other token beginning with "--" is not a recognized option.
+            invalidOption = true;
+        }
+        else{
+            // Any other token is interpreted as a file path.
+            paths.push_back(argument);
+        }
+    }
+    
+    // Batch mode is handled separately, and cannot be combined with reduce mode.
+    if(batchMode && !reduceMode && !invalidOption){
+        
+        // Expand the paths and patterns of the input files.
+        std::vector<std::string> inputs;
+        for(std::size_t pathIndex = 0; pathIndex < paths.size(); ++pathIndex){
+            appendBatchInputs(paths[pathIndex], inputs);
+        }
+        if(!manifestName.empty() && !readManifest(manifestName, inputs)){
+            std::cout << "Unable to read the manifest file: " << manifestName << std::endl;
+            return 1;
+        }
+        if(inputs.empty()){
+            std::cout << "No input files were found." << std::endl;
+            return 1;
+        }
+        
+        /* Process the batch, merging the statistics of every file into
+         * "combined".
          */
-        statsCalculator.readFile(argv[1]);
+        StatsCalculator combined;
+        combined.setQuantileAccuracy(quantileAccuracy);
+        combined.setHistogram(histogramBinning, histogramBinCount,
+                              histogramLowerEdge, histogramUpperEdge);
+        std::size_t failedFileCount = processBatch(inputs, outputDirectory, threadCount,
+                                                   binaryInput, streamingMode,
+                                                   quantileAccuracy, histogramBinning,
+                                                   histogramBinCount, histogramLowerEdge,
+                                                   histogramUpperEdge, combined);
+        
+        // Output the combined summary and state, if requested.
+        bool combinedWritten(true);
+        if(!combinedFileName.empty()){
+            combined.printStats();
+            combinedWritten = combined.writeStats(combinedFileName);
+        }
+        if(!stateFileName.empty()){
+            combined.writeState(stateFileName);
+        }
         
-        /* Call the printStats() method provided by StatsCalculator. This 
-         * outputs a formatted summary of the statistical properties of the 
-         * numerical values that were extracted from the input file to the
-         * terminal.
+        /* Return a non-zero value if any input file could not be read or
+         * any summary could not be written.
          */
-        statsCalculator.printStats();
+        return (failedFileCount == 0 && combinedWritten) ? 0 : 1;
+    }
+    /* Column, group-by and weighted modes parse the input file in place,
+     * so they cannot read the standard input.
+     */
+    else if((columnMode || groupMode || weightedMode) && !reduceMode && paths.size() == 2 &&
+            !invalidOption && paths[0] == "-"){
+        std::cout << "Unable to read the standard input in --columns, --group-by or "
+        << "--weighted mode, which require an input file." << std::endl;
+        return 1;
+    }
+    /* Column mode is also handled separately, and requires exactly TWO
+     * file paths.
+     */
+    else if(columnMode && !reduceMode && paths.size() == 2 && !invalidOption){
+        
+        // Read the columns of the input file, using the requested threads.
+        ColumnTable columnTable;
+        columnTable.setThreadCount(threadCount);
+        columnTable.setVerbosity(verbosity);
+        columnTable.setCovarianceMatrices(covarianceMatrices);
+        bool validFile = columnTable.readFile(paths[0]);
         
-        /* Individually call the getter methods for each of the computable
-         * statistics and output their values to the terminal.
+        /* Output a summary of each column, and the covariance and correlation
+         * matrices if they were requested, to the terminal and the output file.
          */
-        std::cout << "getSum() => " << statsCalculator.getSum() << "\n"
-        << "getMean() => " << statsCalculator.getMean() << "\n"
-        << "getStandardDeviation() => " << statsCalculator.getStandardDeviation() << "\n"
-        << std::endl;
+        columnTable.printStats();
+        columnTable.writeStats(paths[1]);
         
-        /* Call the writeStats() method provided by StatsCalculator. This
-         * outputs a formatted summary of the statistical properties of the
-         * numerical values that were extracted FROM the input file TO the
-         * output file specified by the SECOND command line argument stored 
-         * in the character-array "argv[1]".
+        // Return a non-zero value if the input file could not be parsed.
+        return validFile ? 0 : 1;
+    }
+    /* Group-by mode is also handled separately, and requires exactly TWO
+     * file paths.
+     */
+    else if(groupMode && !reduceMode && paths.size() == 2 && !invalidOption){
+        
+        // Group the values of the input file, using the requested threads.
+        GroupedStats groupedStats;
+        groupedStats.setThreadCount(threadCount);
+        groupedStats.setVerbosity(verbosity);
+        groupedStats.setSortedKeys(sortKeys);
+        bool validFile = groupedStats.readFile(paths[0]);
+        
+        // Output a summary of each group to the terminal and the output file.
+        groupedStats.printStats();
+        groupedStats.writeStats(paths[1]);
+        
+        // Return a non-zero value if the input file could not be parsed.
+        return validFile ? 0 : 1;
+    }
+    /* Weighted mode is also handled separately, and requires exactly TWO
+     * file paths.
+     */
+    else if(weightedMode && !reduceMode && paths.size() == 2 && !invalidOption){
+        
+        // Accumulate the weighted values of the input file in a single pass.
+        WeightedStats weightedStats;
+        weightedStats.setThreadCount(threadCount);
+        weightedStats.setVerbosity(verbosity);
+        bool validFile = weightedStats.readFile(paths[0]);
+        
+        // Output the weighted summary to the terminal and the output file.
+        weightedStats.printStats();
+        weightedStats.writeStats(paths[1]);
+        
+        // Return a non-zero value if the input file could not be parsed.
+        return validFile ? 0 : 1;
+    }
+    /* Otherwise, verify that the program was invoked with TWO file paths, or
+     * in reduce mode with at least one state file and an output file, and no
+     * invalid options.
+     */
+    else if((paths.size() == 2 || (reduceMode && paths.size() > 2)) && !invalidOption){
+        /* Declare a "generic lambda expression" that summarizes the values
+         * using a calculator of any storage type, which is passed to it by
+         * reference. Its body is compiled once for each storage type with
+         * which it is invoked, and it returns the exit status of the program.
          */
-        statsCalculator.writeStats(argv[2]);
+        auto summarizeValues = [&](auto & statsCalculator) -> int {
+            
+            // Configure the number of threads used to parse the input file.
+            statsCalculator.setThreadCount(threadCount);
+            
+            /* Configure whether the parsed values should be stored. The
+             * length of the standard input is unknown in advance, so its
+             * values are never stored.
+             */
+            bool standardInput = !reduceMode && !binaryInput && paths[0] == "-";
+            statsCalculator.setStreamingMode(streamingMode || standardInput);
+            
+            /* Exact quantiles, sorting and ranges of values all require the
+             * values to be stored, so rather than silently reporting NaN or
+             * empty results, refuse to combine them with the standard input.
+             */
+            if(standardInput && (exactQuantiles || sortValues || !ranges.empty())){
+                std::cout << "Unable to apply --exact-quantiles, --sort or --range "
+                << "to the standard input, whose values are read in streaming "
+                << "mode and are not stored." << std::endl;
+                return 1;
+            }
+            
+            // Configure whether the input file is read through the pipeline.
+            statsCalculator.setPipelinedReading(pipelinedReading);
+            
+            // Configure how much information should be printed to the terminal.
+            statsCalculator.setVerbosity(verbosity);
+            statsCalculator.setEchoCount(echoCount);
+            
+            // Configure whether quantiles should be estimated or found exactly.
+            statsCalculator.setQuantileAccuracy(quantileAccuracy);
+            statsCalculator.setExactQuantiles(exactQuantiles);
+            
+            // Configure the bins of the histogram, if one was requested.
+            statsCalculator.setHistogram(histogramBinning, histogramBinCount,
+                                         histogramLowerEdge, histogramUpperEdge);
+            
+            /* Call the readFile method provided by StatsCalculator, passing the 
+             * FIRST file path, stored in the std::string "paths[0]".
+             *
+             * This will attempt to read a sequence of whitespace-spearated numeric
+             * values from a text file at the file-system path specified by "paths[0]".
+             *
+             * Technical Note: Each path was stored by constructing a std::string
+             * from a command line token of type "char *". std::string provides a
+             * constructor that accepts a "char *" as its single argument. This is
+             * known as a "Converting Constructor".
+             */
+            bool validFile(true);
+            if(!reduceMode && binaryInput){
+                // A binary data file is read without parsing by readBinary().
+                validFile = statsCalculator.readBinary(paths[0]);
+            }
+            else if(!reduceMode){
+                validFile = statsCalculator.readFile(paths[0]);
+            }
+            else{
+                /* In reduce mode, merge the aggregate state from every path
+                 * except the last, which is the output file.
+                 */
+                std::cout << "Merging " << paths.size() - 1 << " state files.\n" << std::endl;
+                for(std::size_t pathIndex = 0; pathIndex + 1 < paths.size(); ++pathIndex){
+                    /* A shard that cannot be merged would silently bias the
+                     * global summary, so abandon the reduce instead.
+                     */
+                    if(!statsCalculator.mergeState(paths[pathIndex])){
+                        std::cout << "Unable to merge the state file:\n\n"
+                        << paths[pathIndex] << std::endl;
+                        return 1;
+                    }
+                }
+            }
+            
+            // If requested, sort the stored values.
+            if(sortValues){
+                statsCalculator.sortValues();
+            }
+            
+            /* Call the printStats() method provided by StatsCalculator. This 
+             * outputs a formatted summary of the statistical properties of the 
+             * numerical values that were extracted from the input file to the
+             * terminal.
+             */
+            statsCalculator.printStats();
+            
+            /* If requested, read the block index, or build it and save it for
+             * later runs.
+             */
+            if(!indexFileName.empty() && !statsCalculator.readIndex(indexFileName)){
+                statsCalculator.buildIndex();
+                statsCalculator.writeIndex(indexFileName);
+            }
+            
+            // Output a summary of each requested range of values.
+            for(std::size_t rangeIndex = 0; rangeIndex < ranges.size(); ++rangeIndex){
+                StatsSummary rangeSummary = statsCalculator.getRangeSummary(ranges[rangeIndex].first,
+                                                                            ranges[rangeIndex].second);
+                std::cout << "Values [" << ranges[rangeIndex].first << ", "
+                << ranges[rangeIndex].second << "):\n\n"
+                << "Count = " << rangeSummary.count << "\n"
+                << "Sum =  " << rangeSummary.sum << "\n"
+                << "Mean = " << rangeSummary.mean << "\n"
+                << "Standard Deviation = " << rangeSummary.standardDeviation
+                << "\n" << std::endl;
+            }
+            
+            /* Individually call the getter methods for each of the computable
+             * statistics and output their values to the terminal.
+             */
+            std::cout << "getSum() => " << statsCalculator.getSum() << "\n"
+            << "getMean() => " << statsCalculator.getMean() << "\n"
+            << "getStandardDeviation() => " << statsCalculator.getStandardDeviation() << "\n"
+            << std::endl;
+            
+            /* Call the writeStats() method provided by StatsCalculator. This
+             * outputs a formatted summary of the statistical properties of the
+             * numerical values that were extracted FROM the input file TO the
+             * output file specified by the LAST file path, stored
+             * in the std::string "paths.back()". Except in reduce mode, this
+             * is the SECOND file path.
+             */
+            bool summaryWritten = statsCalculator.writeStats(paths.back());
+            
+            /* If requested, write the aggregate state to a binary file. In
+             * reduce mode this allows the merged state of several shards to be
+             * merged again, forming a hierarchical reduction.
+             *
+             * The state of an input file that could not be read would be
+             * merged as though it described a shard without values, silently
+             * biasing the global summary, so it is not written.
+             */
+            if(!stateFileName.empty() && validFile){
+                statsCalculator.writeState(stateFileName);
+            }
+            
+            /* Return a non-zero value if the input file could not be read or
+             * the summary could not be written.
+             */
+            return (validFile && summaryWritten) ? 0 : 1;
+        };
         
-        // return 0 on success
-        return 0;
+        /* Instantiate a calculator with the storage type selected using the
+         * "--storage" option and summarize the values using it. Values
+         * stored in single precision occupy half the memory, while 64-bit
+         * integers are parsed exactly.
+         */
+        if(storageType == "float"){
+            FloatStatsCalculator statsCalculator;
+            return summarizeValues(statsCalculator);
+        }
+        else if(storageType == "int64"){
+            CounterStatsCalculator statsCalculator;
+            return summarizeValues(statsCalculator);
+        }
+        StatsCalculator statsCalculator;
+        return summarizeValues(statsCalculator);
     }
     else{ // An invalid number of arguments was provided.
         
@@ -92,8 +998,87 @@ int main(int argc, char * argv[]){
          * invocation syntax.
          */
         std::cout << "Required Syntax:\n\n"
-        << "./statsCalculator inputFile outputFile\n\n"
+        << "./statsCalculator [--threads N] [--stream] [--pipeline] [--binary] "
+        << "[--quiet | --echo N | --full] "
+        << "[--storage double|float|int64] "
+        << "[--quantiles ACCURACY] [--exact-quantiles] [--sort] "
+        << "[--histogram SPEC [--histogram-range LOWER UPPER]] "
+        << "[--save-state stateFile] [--index indexFile] "
+        << "[--range FIRST LAST ...] "
+        << "inputFile outputFile\n"
+        << "./statsCalculator [options] - outputFile < inputFile\n"
+        << "./statsCalculator --columns [--threads N] [--quiet] [--covariance] "
+        << "inputFile outputFile\n"
+        << "./statsCalculator --group-by [--threads N] [--quiet] [--sort-keys] "
+        << "inputFile outputFile\n"
+        << "./statsCalculator --weighted [--threads N] [--quiet] "
+        << "inputFile outputFile\n"
+        << "./statsCalculator --reduce [--save-state stateFile] "
+        << "stateFile1 [stateFile2 ...] outputFile\n"
+        << "./statsCalculator --batch [--threads N] [--stream] [--binary] "
+        << "[--quantiles ACCURACY] [--histogram SPEC [--histogram-range LOWER UPPER]] "
+        << "[--manifest manifestFile] "
+        << "[--output-dir outputDirectory] [--combined combinedFile] "
+        << "[--save-state stateFile] [inputFile1 ...]\n\n"
         << "Argument Descriptions:\n\n"
+        << "--threads N - Parse the input file using N worker threads "
+        << "(0 selects one per hardware thread).\n\n"
+        << "--stream - Compute the statistics without storing the values "
+        << "of the input file.\n\n"
+        << "inputFile \"-\" - Read the values from the standard input, in streaming mode, "
+        << "instead of from an input file. Cannot be combined with "
+        << "--exact-quantiles, --sort or --range.\n\n"
+        << "--pipeline - Read the input file in large blocks while earlier "
+        << "blocks are parsed, rather than memory-mapping it.\n\n"
+        << "--binary - Read binary data files instead of text files.\n\n"
+        << "--storage TYPE - Store the values as double (the default), float, "
+        << "which halves their memory, or int64, which accepts only integers.\n\n"
+        << "--range FIRST LAST - Print a summary of the values with indices "
+        << "from FIRST up to, but not including, LAST. May be repeated.\n\n"
+        << "--index indexFile - Read the block index used to summarize ranges "
+        << "from indexFile, or build it and write it to indexFile.\n\n"
+        << "--quantiles ACCURACY - Also estimate the p50, p90, p99 and p99.9 "
+        << "quantiles within a relative error of ACCURACY, from 0.0001 up to, "
+        << "but not including, 1.\n\n"
+        << "--exact-quantiles - Also report the exact values of those "
+        << "quantiles, without sorting the values.\n\n"
+        << "--sort - Sort the values before summarizing them.\n\n"
+        << "--columns - Read rows of comma- or whitespace-separated columns, "
+        << "with an optional header line, and summarize each column. The input "
+        << "cannot be the standard input.\n\n"
+        << "--covariance - With --columns, also report the covariance and "
+        << "correlation matrices of the columns.\n\n"
+        << "--group-by - Read lines of a key and a value, separated by a comma "
+        << "or whitespace, and summarize the values of each distinct key. The "
+        << "input cannot be the standard input.\n\n"
+        << "--sort-keys - With --group-by, report the groups in order of "
+        << "their keys instead of their first appearance.\n\n"
+        << "--weighted - Read lines of a value and its non-negative weight and "
+        << "report the weighted sum, mean and variances. The input cannot be "
+        << "the standard input.\n\n"
+        << "--histogram SPEC - Also write a histogram to outputFile.hist, with "
+        << "SPEC = N equal bins, log:N logarithmic bins, fd (Freedman-Diaconis) "
+        << "or scott (Scott).\n\n"
+        << "--histogram-range LOWER UPPER - Set the edges of the histogram "
+        << "instead of using the extreme values.\n\n"
+        << "--quiet - Do not print progress messages or the values of the "
+        << "input file.\n\n"
+        << "--echo N - Print only the first and last N values of the input "
+        << "file (the default, with N = 5).\n\n"
+        << "--full - Print every value of the input file.\n\n"
+        << "--save-state stateFile - Also write the aggregate state of the "
+        << "values to a binary file that can be merged using --reduce.\n\n"
+        << "--reduce - Merge the aggregate states in the listed state files "
+        << "instead of reading an input file.\n\n"
+        << "--batch - Process every listed input file, or file matching a "
+        << "quoted wildcard pattern, concurrently using N worker threads, "
+        << "writing the summary of each to a file with the suffix .stats.\n\n"
+        << "--manifest manifestFile - Enable batch mode and read further input "
+        << "paths or patterns from manifestFile, one per line.\n\n"
+        << "--output-dir outputDirectory - Write the summary files of a batch "
+        << "to outputDirectory.\n\n"
+        << "--combined combinedFile - Also write a summary of all the input "
+        << "files of a batch to combinedFile.\n\n"
         << "inputFile - The path of a text file containing "
         << "whitespace-separated numeric values.\n\n"
         << "outputFile - A path to which an output text file "
@@ -0,0 +1,375 @@
+// IMPLEMENTATION file for the WeightedStats class
+
+// STL HEADER FILES
+
+/* The <algorithm> header is included to provide the std::count(...) and
+ * std::find(...) functions.
+ */
+#include <algorithm>
+// The <fstream> header is included to enable output to files.
+#include <fstream>
+// The <iostream> header is included to enable textual terminal output.
+#include <iostream>
+// The <thread> header is included to provide the std::thread class.
+#include <thread>
+// The <vector> header is included to provide the STL std::vector type.
+#include <vector>
+
+// LOCAL HEADER FILES
+
+/* The "WeightedStats.h" header is included to provide a definition of the
+ * WeightedStats class.
+ */
+#include "WeightedStats.h"
+
+/* The "DelimitedText.h" header is included to provide the MappedTextFile
+ * class and the functions that divide a file into lines and fields.
+ */
+#include "DelimitedText.h"
+
+// CONSTANTS
+
+/* parseRows() passes the values and weights that it parses to the
+ * accumulator in batches of this many, so that the accumulator can process
+ * them as arrays.
+ */
+static const std::size_t parsedBatchSize = 1024;
+
+// HELPER FUNCTIONS
+
+/** Helper function that skips the separator between two fields.
+ *
+ * \param position - A pointer to the first character after the first field.
+ * \param lineEnd - A pointer to the end of the line or of the buffer.
+ * \param separator - ',' if the fields are separated by a comma, which may
+ * be surrounded by whitespace, or ' ' if they are separated by whitespace.
+ *
+ * \return A pointer to the first character of the second field, or a null
+ * pointer if the first field is not followed by a separator.
+ */
+static const char * skipSeparator(const char * position, const char * lineEnd,
+                                  char separator){
+    const char * fieldBegin = position;
+    while(position != lineEnd && isBlank(*position)){
+        ++position;
+    }
+    if(separator == ','){
+        if(position == lineEnd || *position != ','){
+            return 0;
+        }
+        ++position;
+        while(position != lineEnd && isBlank(*position)){
+            ++position;
+        }
+    }
+    else if(position == fieldBegin){
+        return 0;
+    }
+    return position;
+}
+
+// PRIVATE METHODS OF WEIGHTEDSTATS
+
+/** Private static method that parses lines containing a value and a weight.
+ *
+ * \param bufferBegin - A pointer to the first character of the range, which
+ * must be the first character of a line.
+ * \param bufferEnd - A pointer one past the last character of the range,
+ * which must be the end of a line or of the file.
+ * \param separator - ',' if the value and weight are separated by a comma,
+ * which may be surrounded by whitespace, or ' ' if they are separated by
+ * whitespace.
+ * \param accumulator - The accumulator to which the weighted values are
+ * added.
+ *
+ * \return A pointer to the first character of the first line that could not
+ * be parsed, or "bufferEnd" if every line was parsed.
+ *
+ * Every line must contain exactly one value followed by one weight, which
+ * must not be negative. A value is added only when the whole line has been
+ * parsed, so a malformed line contributes nothing. Empty lines and lines
+ * that begin with "#" are skipped.
+ *
+ * The values and weights are collected in batches, each of which is added
+ * to the accumulator by a single call of
+ * WeightedStatsAccumulator::addValues().
+ */
+const char * WeightedStats::parseRows(const char * bufferBegin, const char * bufferEnd,
+                                      char separator, WeightedStatsAccumulator & accumulator){
+    double batchValues[parsedBatchSize];
+    double batchWeights[parsedBatchSize];
+    std::size_t batchCount(0);
+    const char * lineBegin = bufferBegin;
+    while(lineBegin != bufferEnd){
+        
+        // Skip the whitespace that precedes the value.
+        const char * position = lineBegin;
+        while(position != bufferEnd && isBlank(*position)){
+            ++position;
+        }
+        
+        // Skip empty lines and comments.
+        if(position == bufferEnd || *position == '\n' || *position == '#'){
+            position = findLineEnd(position, bufferEnd);
+            lineBegin = (position == bufferEnd) ? bufferEnd : position + 1;
+            continue;
+        }
+        
+        // Parse the value and the weight.
+        double value(0.0);
+        double weight(0.0);
+        position = parseValue(position, bufferEnd, value);
+        if(position){
+            position = skipSeparator(position, bufferEnd, separator);
+        }
+        if(position){
+            position = parseValue(position, bufferEnd, weight);
+        }
+        
+        // The line must end after a weight that is not negative.
+        while(position && position != bufferEnd && isBlank(*position)){
+            ++position;
+        }
+        if(!position || (position != bufferEnd && *position != '\n') || weight < 0.0){
+            accumulator.addValues(batchValues, batchWeights, batchCount);
+            return lineBegin;
+        }
+        
+        // Add the batch to the accumulator when it is full.
+        batchValues[batchCount] = value;
+        batchWeights[batchCount] = weight;
+        if(++batchCount == parsedBatchSize){
+            accumulator.addValues(batchValues, batchWeights, batchCount);
+            batchCount = 0;
+        }
+        lineBegin = (position == bufferEnd) ? bufferEnd : position + 1;
+    }
+    
+    accumulator.addValues(batchValues, batchWeights, batchCount);
+    return bufferEnd;
+}
+
+/** Private method that writes the summary of the weighted values to an
+ * output stream.
+ *
+ * \param stream - The stream to which the summary is written.
+ *
+ * The statistics are written in the format "Statistic_Name =
+ * Statistic_Value", preceded by the names of the value and weight columns in
+ * the same format. The sum, mean, standard deviation and higher moments
+ * are weighted, and the standard deviation is the square root of the
+ * weighted (population) variance, as for unweighted values. Both unbiased
+ * estimates of the variance are also written, since which of them applies
+ * depends on the meaning of the weights.
+ */
+void WeightedStats::writeSummary(std::ostream & stream) const {
+    WeightedStatsSummary summary = getSummary();
+    stream << "Weighted statistical analysis of numeric data:\n\n"
+    << "Value Column = " << valueName << "\n"
+    << "Weight Column = " << weightName << "\n"
+    << "Sum of Weights = " << summary.sumOfWeights << "\n"
+    << "Effective Count = " << summary.effectiveCount << "\n"
+    << "Weighted Sum = " << summary.sum << "\n"
+    << "Weighted Mean = " << summary.mean << "\n"
+    << "Weighted Standard Deviation = " << summary.standardDeviation << "\n"
+    << "Frequency Weighted Variance = " << summary.frequencyVariance << "\n"
+    << "Reliability Weighted Variance = " << summary.reliabilityVariance << "\n"
+    << "Count = " << summary.count << "\n"
+    << "Minimum = " << summary.minimum << "\n"
+    << "Maximum = " << summary.maximum << "\n"
+    << "Weighted Skewness = " << summary.skewness << "\n"
+    << "Weighted Excess Kurtosis = " << summary.excessKurtosis
+    << "\n" << std::endl;
+}
+
+// PUBLIC METHODS OF WEIGHTEDSTATS
+
+/** Default constructor for the WeightedStats class.
+ *
+ * Creates an object with no values, which parses files on the calling
+ * thread unless setThreadCount() is subsequently invoked.
+ */
+WeightedStats::WeightedStats() : statistics(), valueName("Value"), weightName("Weight"),
+                                 threadCount(1), verbosity(SUMMARY_OUTPUT) {
+    // No further initialization operations are required.
+}
+
+/** Public method that sets the number of worker threads.
+ *
+ * \param newThreadCount - The number of worker threads. A value of zero
+ * selects the number of hardware threads available on the current machine.
+ */
+void WeightedStats::setThreadCount(unsigned int newThreadCount){
+    if(newThreadCount == 0){
+        newThreadCount = std::thread::hardware_concurrency();
+    }
+    // std::thread::hardware_concurrency() may return zero.
+    threadCount = (newThreadCount > 0) ? newThreadCount : 1;
+}
+
+/** Public method that sets the amount of information that readFile() and
+ * writeStats() print to the terminal.
+ *
+ * \param newVerbosity - QUIET_OUTPUT to print nothing except failures.
+ */
+void WeightedStats::setVerbosity(OutputVerbosity newVerbosity){
+    verbosity = newVerbosity;
+}
+
+/** Public method that replaces the statistics with those of the weighted
+ * values of a text file.
+ *
+ * \param infileName - A string specifying the path of the text file.
+ *
+ * \return true if every line of the file was parsed, false otherwise.
+ *
+ * The file is memory-mapped by a MappedTextFile, or decompressed into memory
+ * by it if it is compressed using gzip or zstd. Its first line that is
+ * neither empty nor a comment determines the separator, which is a comma if
+ * that line contains one and whitespace otherwise, and is treated as a
+ * header that names the two columns if its first field is not numeric. The
+ * remaining lines are divided into line-aligned ranges by
+ * divideIntoLineRanges(), as in GroupedStats::readFile(), each of which is
+ * accumulated into its own WeightedStatsAccumulator by its own worker
+ * thread. The accumulators are then merged in order of their ranges.
+ */
+bool WeightedStats::readFile(const std::string & infileName){
+    
+    // Print an informative message to inform the caller of progress.
+    if(verbosity != QUIET_OUTPUT){
+        std::cout << "Reading weighted data from:\n\n" << infileName << std::endl;
+    }
+    
+    // Discard the existing statistics.
+    statistics = WeightedStatsAccumulator();
+    valueName = "Value";
+    weightName = "Weight";
+    
+    // Memory-map the input file.
+    MappedTextFile inputFile(infileName);
+    bool validFile(inputFile.isReadable());
+    std::size_t failedLine(0);
+    if(validFile && inputFile.begin() != inputFile.end()){
+        const char * fileBegin = inputFile.begin();
+        const char * fileEnd = inputFile.end();
+        
+        // Find the first line that is neither empty nor a comment.
+        const char * lineBegin = findFirstDataLine(fileBegin, fileEnd);
+        const char * lineEnd = findLineEnd(lineBegin, fileEnd);
+        const char * firstField = lineBegin;
+        while(firstField != lineEnd && isBlank(*firstField)){
+            ++firstField;
+        }
+        
+        /* Determine the separator and whether the line is a header, i.e.
+         * whether its first field is not a number.
+         */
+        char separator = (std::find(lineBegin, lineEnd, ',') != lineEnd) ? ',' : ' ';
+        const char * dataBegin = lineBegin;
+        double value(0.0);
+        if(lineBegin != fileEnd && !parseValue(firstField, lineEnd, value)){
+            std::vector<std::string> fields = splitFields(lineBegin, lineEnd, separator);
+            if(fields.size() == 2){
+                valueName = fields[0];
+                weightName = fields[1];
+            }
+            dataBegin = (lineEnd == fileEnd) ? fileEnd : lineEnd + 1;
+        }
+        
+        // Divide the lines into line-aligned ranges, one per worker thread.
+        std::vector<const char *> rangeBegins = divideIntoLineRanges(dataBegin, fileEnd,
+                                                                     threadCount);
+        std::size_t rangeCount = rangeBegins.size() - 1;
+        
+        /* Parse each range on its own worker thread into its own
+         * accumulator, so that the threads share no mutable data.
+         */
+        std::vector<WeightedStatsAccumulator> rangeStatistics(rangeCount);
+        std::vector<const char *> rangeStops(rangeCount);
+        std::vector<std::thread> workers;
+        for(std::size_t rangeIndex = 0; rangeIndex < rangeCount; ++rangeIndex){
+            workers.push_back(std::thread([&, rangeIndex](){
+                rangeStops[rangeIndex] = parseRows(rangeBegins[rangeIndex],
+                                                   rangeBegins[rangeIndex + 1], separator,
+                                                   rangeStatistics[rangeIndex]);
+            }));
+        }
+        for(std::size_t rangeIndex = 0; rangeIndex < rangeCount; ++rangeIndex){
+            workers[rangeIndex].join();
+        }
+        
+        /* Merge the accumulators of the ranges in order, up to and
+         * including the first range that contains a malformed line.
+         */
+        validFile = true;
+        std::size_t rangeIndex(0);
+        for(; rangeIndex < rangeCount && validFile; ++rangeIndex){
+            statistics.merge(rangeStatistics[rangeIndex]);
+            validFile = rangeStops[rangeIndex] == rangeBegins[rangeIndex + 1];
+        }
+        if(!validFile){
+            const char * stop = rangeStops[rangeIndex - 1];
+            failedLine = std::count(fileBegin, stop, '\n') + 1;
+        }
+    }
+    
+    // Report a failure, even with QUIET_OUTPUT verbosity.
+    if(!validFile && failedLine == 0){
+        std::cout << "Unable to read the input file:\n\n" << infileName << std::endl;
+    }
+    else if(!validFile){
+        std::cout << "Unable to parse line " << failedLine << " of the input file:\n\n"
+        << infileName << std::endl;
+    }
+    else if(inputFile.getCompression() != UNCOMPRESSED_INPUT && verbosity != QUIET_OUTPUT){
+        std::cout << "\nThe input was decompressed from "
+        << getInputCompressionName(inputFile.getCompression()) << " format." << std::endl;
+    }
+    if(verbosity != QUIET_OUTPUT){
+        std::cout << "\nRead " << statistics.getCount() << " values with a total weight of "
+        << statistics.getSumOfWeights() << ".\n" << std::endl;
+    }
+    return validFile;
+}
+
+/** Public method returns the running statistics of the weighted values.
+ */
+const WeightedStatsAccumulator & WeightedStats::getStatistics() const {
+    return statistics;
+}
+
+/** Public method returns a summary of the statistical properties of the
+ * weighted values.
+ */
+WeightedStatsSummary WeightedStats::getSummary() const {
+    return statistics.getSummary();
+}
+
+/** Public method that prints the summary of the weighted values to the
+ * terminal.
+ */
+void WeightedStats::printStats() const {
+    writeSummary(std::cout);
+}
+
+/** Public method that writes the summary of the weighted values to a text
+ * file.
+ *
+ * \param outfileName - A string specifying the path of the text file. If
+ * the file exists it is overwritten.
+ */
+void WeightedStats::writeStats(const std::string & outfileName) const {
+    std::ofstream outputFile(outfileName.c_str());
+    if(outputFile.is_open() && outputFile.good()){
+        writeSummary(outputFile);
+        outputFile.close();
+    }
+    if(!outputFile){
+        std::cout << "Unable to write the statistical summary to:\n\n"
+        << outfileName << std::endl;
+    }
+    else if(verbosity != QUIET_OUTPUT){
+        std::cout << "A statistical summary has been saved to:\n\n"
+        << outfileName << std::endl;
+    }
+}
@@ -0,0 +1,291 @@
+// IMPLEMENTATION file for WeightedStatsAccumulator class
+
+// STL HEADER FILES
+
+// The <cmath> header is included to provide the std::sqrt(...) function.
+#include <cmath>
+// The <limits> header is included to provide the std::numeric_limits type.
+#include <limits>
+
+// LOCAL HEADER FILES
+
+/* The "WeightedStatsAccumulator.h" header is included to provide a
+ * definition of the WeightedStatsAccumulator class.
+ */
+#include "WeightedStatsAccumulator.h"
+
+// CONSTANTS
+
+/* addValues() processes arrays in blocks of this many values, so that the
+ * deviations of all but the first block are measured from an accurate
+ * running mean.
+ */
+static const std::size_t momentBlockSize = 4096;
+
+// PUBLIC METHODS OF WEIGHTEDSTATSACCUMULATOR
+
+/** Default constructor for the WeightedStatsAccumulator class.
+ *
+ * Zero-initializes the running statistics, and initializes the minimum and
+ * maximum to positive and negative infinity respectively, so that the
+ * accumulator represents an empty sequence of values.
+ */
+WeightedStatsAccumulator::WeightedStatsAccumulator() :
+    count(0), sumOfWeights(0.0), sumOfSquaredWeights(0.0), sum(0.0), mean(0.0),
+    sumOfSquaredDeviations(0.0), sumOfCubedDeviations(0.0),
+    sumOfFourthPowerDeviations(0.0),
+    minimum(std::numeric_limits<double>::infinity()),
+    maximum(-std::numeric_limits<double>::infinity()) {
+    // No further initialization operations are required.
+}
+
+/** Public method that adds a single weighted value to the running
+ * statistics.
+ *
+ * \param value - The value to be added.
+ * \param weight - The weight of the value, which must be finite and not
+ * negative.
+ *
+ * The value is treated as a sequence of its own, whose weighted mean is the
+ * value and whose sums of powers of the deviations are zero, and is merged
+ * with the running statistics by merge(). With a weight of one this is the
+ * update of Welford used by StatsAccumulator::addValue().
+ */
+void WeightedStatsAccumulator::addValue(double value, double weight){
+    WeightedStatsAccumulator valueStatistics;
+    valueStatistics.count = 1;
+    if(weight > 0.0){
+        valueStatistics.sumOfWeights = weight;
+        valueStatistics.sumOfSquaredWeights = weight*weight;
+        valueStatistics.sum = weight*value;
+        valueStatistics.mean = value;
+        valueStatistics.minimum = value;
+        valueStatistics.maximum = value;
+    }
+    merge(valueStatistics);
+}
+
+/** Public method that adds an array of weighted values to the running
+ * statistics.
+ *
+ * \param values - A pointer to the first element of the array of values.
+ * \param weights - A pointer to the first element of the array of weights.
+ * \param valueCount - The number of elements in each array.
+ *
+ * As in StatsAccumulator::addValues(), the arrays are processed in blocks of
+ * "momentBlockSize" values. For each block the weighted sums of the first
+ * four powers of the deviations from a shift value K are computed in a
+ * single pass, together with the sum of the weights \f$ W \f$ and of their
+ * squares. The statistics of the block are derived from these by the same
+ * formulae as for unweighted values, with \f$ W \f$ in place of the number
+ * of values, and are then merged with the running statistics by merge().
+ * The shift value is the running mean if any weight has already been
+ * accumulated and the first element of the block otherwise.
+ */
+void WeightedStatsAccumulator::addValues(const double * values, const double * weights,
+                                         std::size_t valueCount){
+    for(std::size_t blockBegin = 0; blockBegin < valueCount; blockBegin += momentBlockSize){
+        std::size_t blockEnd = valueCount;
+        if(blockEnd - blockBegin > momentBlockSize){
+            blockEnd = blockBegin + momentBlockSize;
+        }
+        
+        // Choose the shift value...
+        double shift = (sumOfWeights > 0.0) ? mean : values[blockBegin];
+        
+        // ...and compute the weighted shifted sums for the block alone.
+        WeightedStatsAccumulator blockStatistics;
+        blockStatistics.count = blockEnd - blockBegin;
+        double shiftedSum(0.0);
+        double shiftedSumOfSquares(0.0);
+        double shiftedSumOfCubes(0.0);
+        double shiftedSumOfFourthPowers(0.0);
+        for(std::size_t valueIndex = blockBegin; valueIndex < blockEnd; ++valueIndex){
+            double weight = weights[valueIndex];
+            double deviation = values[valueIndex] - shift;
+            double weightedDeviation = weight*deviation;
+            double weightedDeviationSquared = weightedDeviation*deviation;
+            blockStatistics.sumOfWeights += weight;
+            blockStatistics.sumOfSquaredWeights += weight*weight;
+            shiftedSum += weightedDeviation;
+            shiftedSumOfSquares += weightedDeviationSquared;
+            shiftedSumOfCubes += weightedDeviationSquared*deviation;
+            shiftedSumOfFourthPowers += weightedDeviationSquared*deviation*deviation;
+            
+            // Values with zero weight do not affect the extreme values.
+            if(weight > 0.0 && values[valueIndex] < blockStatistics.minimum){
+                blockStatistics.minimum = values[valueIndex];
+            }
+            if(weight > 0.0 && values[valueIndex] > blockStatistics.maximum){
+                blockStatistics.maximum = values[valueIndex];
+            }
+        }
+        
+        // Derive the statistics of the block, if any of its weights is positive.
+        double blockWeight = blockStatistics.sumOfWeights;
+        if(blockWeight > 0.0){
+            double meanDeviation = shiftedSum/blockWeight;
+            blockStatistics.sum = shift*blockWeight + shiftedSum;
+            blockStatistics.mean = shift + meanDeviation;
+            blockStatistics.sumOfSquaredDeviations =
+                shiftedSumOfSquares - shiftedSum*meanDeviation;
+            blockStatistics.sumOfCubedDeviations =
+                shiftedSumOfCubes - 3.0*meanDeviation*shiftedSumOfSquares +
+                2.0*blockWeight*meanDeviation*meanDeviation*meanDeviation;
+            blockStatistics.sumOfFourthPowerDeviations =
+                shiftedSumOfFourthPowers - 4.0*meanDeviation*shiftedSumOfCubes +
+                6.0*meanDeviation*meanDeviation*shiftedSumOfSquares -
+                3.0*blockWeight*meanDeviation*meanDeviation*meanDeviation*meanDeviation;
+            
+            /* Rounding may produce a tiny negative result if every deviation
+             * is almost identical, so clamp the even powers to zero.
+             */
+            if(blockStatistics.sumOfSquaredDeviations < 0.0){
+                blockStatistics.sumOfSquaredDeviations = 0.0;
+            }
+            if(blockStatistics.sumOfFourthPowerDeviations < 0.0){
+                blockStatistics.sumOfFourthPowerDeviations = 0.0;
+            }
+        }
+        
+        merge(blockStatistics);
+    }
+}
+
+/** Public method that adds the running statistics of another accumulator
+ * to those of this accumulator.
+ *
+ * \param other - The accumulator whose statistics should be added.
+ *
+ * The weighted mean and sums of powers of the deviations are combined by
+ * the formulae of StatsAccumulator::merge(), in which the numbers of values
+ * \f$ n_{A} \f$ and \f$ n_{B} \f$ are replaced by the sums of the weights
+ * of the two sequences. The formulae only require these to be positive,
+ * not to be integers.
+ */
+void WeightedStatsAccumulator::merge(const WeightedStatsAccumulator & other){
+    
+    // Values with zero weight are counted, but change nothing else.
+    if(other.sumOfWeights == 0.0){
+        count += other.count;
+        return;
+    }
+    
+    // If this accumulator has no weight, simply adopt the other statistics.
+    if(sumOfWeights == 0.0){
+        std::size_t previousCount = count;
+        *this = other;
+        count += previousCount;
+        return;
+    }
+    
+    /* Apply the pairwise update formulae, updating the highest power first,
+     * since each update uses the previous values of the lower powers.
+     */
+    double thisWeight = sumOfWeights;
+    double otherWeight = other.sumOfWeights;
+    double combinedWeight = thisWeight + otherWeight;
+    double delta = other.mean - mean;
+    double scaledDelta = delta/combinedWeight;
+    double scaledDeltaSquared = scaledDelta*scaledDelta;
+    double weightProduct = thisWeight*otherWeight;
+    sumOfFourthPowerDeviations += other.sumOfFourthPowerDeviations +
+        delta*scaledDelta*scaledDeltaSquared*weightProduct*
+        (thisWeight*thisWeight - weightProduct + otherWeight*otherWeight) +
+        6.0*scaledDeltaSquared*(thisWeight*thisWeight*other.sumOfSquaredDeviations +
+                                otherWeight*otherWeight*sumOfSquaredDeviations) +
+        4.0*scaledDelta*(thisWeight*other.sumOfCubedDeviations -
+                         otherWeight*sumOfCubedDeviations);
+    sumOfCubedDeviations += other.sumOfCubedDeviations +
+        delta*scaledDeltaSquared*weightProduct*(thisWeight - otherWeight) +
+        3.0*scaledDelta*(thisWeight*other.sumOfSquaredDeviations -
+                         otherWeight*sumOfSquaredDeviations);
+    sumOfSquaredDeviations += other.sumOfSquaredDeviations +
+        delta*scaledDelta*weightProduct;
+    mean += scaledDelta*otherWeight;
+    sum += other.sum;
+    sumOfWeights = combinedWeight;
+    sumOfSquaredWeights += other.sumOfSquaredWeights;
+    count += other.count;
+    
+    // Combine the extreme values.
+    if(other.minimum < minimum){
+        minimum = other.minimum;
+    }
+    if(other.maximum > maximum){
+        maximum = other.maximum;
+    }
+}
+
+/** Public method returns the number of values that have been accumulated.
+ *
+ * \return The number of values, including those with zero weight.
+ */
+std::size_t WeightedStatsAccumulator::getCount() const {
+    return count;
+}
+
+/** Public method returns the sum of the weights of the values that have
+ * been accumulated.
+ *
+ * \return The sum of the weights.
+ */
+double WeightedStatsAccumulator::getSumOfWeights() const {
+    return sumOfWeights;
+}
+
+/** Public method returns a summary of the statistical properties of the
+ * weighted values that have been accumulated.
+ *
+ * \return A WeightedStatsSummary structure. If the sum of the weights is
+ * zero, every member except the count is zero.
+ *
+ * With \f$ W = \sum w_{i} \f$ and \f$ V = \sum w_{i}^{2} \f$, the weighted
+ * (population) variance and the two unbiased estimates of the variance are
+ *
+ * \f[ \sigma^{2} = \frac{M_{2}}{W}, \qquad
+ *     s^{2}_{\mathrm{frequency}} = \frac{M_{2}}{W - 1}, \qquad
+ *     s^{2}_{\mathrm{reliability}} = \frac{M_{2}}{W - V/W}. \f]
+ *
+ * The frequency estimate is NaN unless W exceeds one, and the reliability
+ * estimate is NaN unless at least two values have positive weights. The
+ * skewness and excess kurtosis are computed as in
+ * StatsAccumulator::getSummary(), with W in place of the number of values.
+ */
+WeightedStatsSummary WeightedStatsAccumulator::getSummary() const {
+    WeightedStatsSummary summary = {};
+    summary.count = count;
+    if(sumOfWeights > 0.0){
+        const double notANumber = std::numeric_limits<double>::quiet_NaN();
+        summary.sumOfWeights = sumOfWeights;
+        summary.effectiveCount = sumOfWeights*sumOfWeights/sumOfSquaredWeights;
+        summary.sum = sum;
+        summary.mean = mean;
+        summary.variance = sumOfSquaredDeviations/sumOfWeights;
+        summary.standardDeviation = std::sqrt(summary.variance);
+        
+        /* Compute W^2 - V rather than W - V/W, which is exactly zero if there
+         * is only one positive weight.
+         */
+        double reliabilityDenominator = sumOfWeights*sumOfWeights - sumOfSquaredWeights;
+        summary.frequencyVariance = (sumOfWeights > 1.0) ?
+            sumOfSquaredDeviations/(sumOfWeights - 1.0) : notANumber;
+        summary.reliabilityVariance = (reliabilityDenominator > 0.0) ?
+            sumOfSquaredDeviations*sumOfWeights/reliabilityDenominator : notANumber;
+        summary.minimum = minimum;
+        summary.maximum = maximum;
+        
+        // The skewness and kurtosis are undefined without any variation.
+        if(sumOfSquaredDeviations > 0.0){
+            summary.skewness = std::sqrt(sumOfWeights)*sumOfCubedDeviations/
+                (sumOfSquaredDeviations*std::sqrt(sumOfSquaredDeviations));
+            summary.excessKurtosis = sumOfWeights*sumOfFourthPowerDeviations/
+                (sumOfSquaredDeviations*sumOfSquaredDeviations) - 3.0;
+        }
+        else{
+            summary.skewness = notANumber;
+            summary.excessKurtosis = notANumber;
+        }
+    }
+    return summary;
+}
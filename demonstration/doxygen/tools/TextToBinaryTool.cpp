@@ -0,0 +1,86 @@
+/// \file TextToBinaryTool.cpp TOOL FILE that converts text data files to binary data files
+
+// The <cstdlib> header is included to provide the std::strtoul(...) function.
+#include <cstdlib>
+// The <iostream> header is included to enable textual terminal output.
+#include <iostream>
+// The <string> header is included to provide the STL std::string type.
+#include <string>
+// The <vector> header is included to provide the STL std::vector type.
+#include <vector>
+
+/* Include StatsCalculator.h to provide class definition of
+ * StatsCalculator
+ */
+#include "StatsCalculator.h"
+
+/** The main function is the entry point for the program. The program converts
+ * a text file containing whitespace-separated numeric values, in the format
+ * read by StatsCalculator::readFile(), to a binary data file that can be read
+ * by StatsCalculator::readBinary() without any parsing.
+ *
+ * The program is designed to be invoked with two command line arguments: the
+ * path of the input text file and the path of the output binary file. These
+ * may be preceded by the option "--threads N", which divides the parsing of
+ * the input file among N worker threads.
+ *
+ * \note The values are stored in memory while they are converted, so the
+ * memory required is approximately the size of the output file.
+ *
+ * The program returns zero on success and 1 if incorrect command line
+ * arguments were provided.
+ *
+ * \note This file defines its own main() function, so it is kept apart
+ * from the files in the "src" directory and is built by linking it with
+ * every one of them except "StatsCalculatorTest.cpp", as described in the
+ * "commands" file.
+ */
+int main(int argc, char * argv[]){
+    
+    // The number of parsing threads requested using the "--threads" option.
+    unsigned int threadCount(1);
+    
+    // The input and output file paths.
+    std::vector<std::string> paths;
+    
+    // A flag that records whether an unrecognized option was encountered.
+    bool invalidOption(false);
+    
+    // Loop over all command line tokens except the executable name itself.
+    for(int argIndex = 1; argIndex < argc; ++argIndex){
+        std::string argument(argv[argIndex]);
+        if(argument == "--threads" && argIndex + 1 < argc){
+            threadCount = std::strtoul(argv[++argIndex], 0, 10);
+        }
+        else if(argument.size() > 2 && argument.compare(0, 2, "--") == 0){
+            invalidOption = true;
+        }
+        else{
+            paths.push_back(argument);
+        }
+    }
+    
+    if(paths.size() == 2 && !invalidOption){
+        /* Read the text file, echoing only the first and last few values,
+         * then write the stored values to the binary file.
+         */
+        StatsCalculator statsCalculator;
+        statsCalculator.setThreadCount(threadCount);
+        statsCalculator.readFile(paths[0]);
+        statsCalculator.writeBinary(paths[1]);
+        return 0;
+    }
+    else{ // Invalid arguments were provided.
+        std::cout << "Required Syntax:\n\n"
+        << "./textToBinary [--threads N] inputFile outputFile\n\n"
+        << "Argument Descriptions:\n\n"
+        << "--threads N - Parse the input file using N worker threads "
+        << "(0 selects one per hardware thread).\n\n"
+        << "inputFile - The path of a text file containing "
+        << "whitespace-separated numeric values.\n\n"
+        << "outputFile - A path to which a binary data file containing "
+        << "the same values should be written."
+        << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,182 @@
+// Define the BOUNDEDQUEUE_H macro to act as an include guard
+#ifndef BOUNDEDQUEUE_H
+#define BOUNDEDQUEUE_H
+
+// Include the <atomic> header to provide the STL std::atomic type.
+#include <atomic>
+// Include the <condition_variable> header to provide the std::condition_variable class.
+#include <condition_variable>
+// Include the <cstddef> header to provide the std::size_t type.
+#include <cstddef>
+// Include the <mutex> header to provide the std::mutex class.
+#include <mutex>
+// Include the <thread> header to provide the std::this_thread::yield(...) function.
+#include <thread>
+// Include the <vector> header to provide the STL std::vector type.
+#include <vector>
+
+/** \class BoundedQueue
+ * The BoundedQueue class template is a first-in, first-out queue with a
+ * fixed capacity, through which exactly one "producer" thread passes items
+ * to exactly one "consumer" thread without any locks, except while one of
+ * them has had to wait for the other for some time.
+ *
+ * The items are stored in a circular array. The producer alone advances the
+ * "tail" index after writing an item, and the consumer alone advances the
+ * "head" index after reading one, so each index has a single writer. Each
+ * thread publishes its index with release semantics and reads the other
+ * thread's index with acquire semantics, which guarantees that an item is
+ * fully written before the consumer can read it, and fully read before the
+ * producer can overwrite it.
+ *
+ * The push() and pop() methods wait while the queue is full or empty
+ * respectively. They first yield the processor a few times, which costs
+ * little when the other thread is about to make room or supply an item, and
+ * then block on a condition variable, so that a thread that waits for a slow
+ * producer, such as a program writing to a pipe, occupies no processor time.
+ * The other thread only takes the mutex to wake it if a waiting flag shows
+ * that it is blocked, so the queue remains lock-free while neither thread
+ * waits for long. A queue of small capacity
+ * therefore also limits how far the producer can run ahead of the consumer,
+ * which bounds the memory occupied by the items in flight. Items are
+ * typically pointers to large buffers that are recycled through a second
+ * queue in the opposite direction.
+ */
+template<typename Item>
+class BoundedQueue {
+    
+    /** \brief The circular array of items, which has one more element than
+     * the capacity of the queue so that a full queue can be distinguished
+     * from an empty one.
+     */
+    std::vector<Item> items;
+    
+    /** \brief The index of the next item to be popped, which is written only
+     * by the consumer.
+     */
+    std::atomic<std::size_t> head;
+    
+    /** \brief The index at which the next item will be pushed, which is
+     * written only by the producer.
+     */
+    std::atomic<std::size_t> tail;
+    
+    /** \brief The number of times that push() and pop() yield the processor
+     * before blocking.
+     */
+    static const unsigned int yieldCount = 64;
+    
+    /** \brief Flags indicating that the producer is blocked in push(), or the
+     * consumer in pop(), so that the other thread must wake it.
+     */
+    std::atomic<bool> producerWaiting;
+    std::atomic<bool> consumerWaiting;
+    
+    /** \brief The mutex and condition variable on which a blocked thread
+     * waits.
+     */
+    std::mutex waitMutex;
+    std::condition_variable waitCondition;
+    
+    /** \brief Private method that appends an item to the queue if it is not
+     * full. Returns true if the item was appended. It must only be invoked
+     * by the producer thread, and does not wake a blocked consumer.
+     */
+    bool tryPush(const Item & item){
+        std::size_t currentTail = tail.load(std::memory_order_relaxed);
+        std::size_t nextTail = (currentTail + 1 == items.size()) ? 0 : currentTail + 1;
+        if(nextTail == head.load(std::memory_order_acquire)){
+            return false;
+        }
+        items[currentTail] = item;
+        tail.store(nextTail, std::memory_order_release);
+        return true;
+    }
+    
+    /** \brief Private method that removes the oldest item from the queue if it
+     * is not empty. Returns true if an item was removed, in which case it is
+     * assigned to "item". It must only be invoked by the consumer thread,
+     * and does not wake a blocked producer.
+     */
+    bool tryPop(Item & item){
+        std::size_t currentHead = head.load(std::memory_order_relaxed);
+        if(currentHead == tail.load(std::memory_order_acquire)){
+            return false;
+        }
+        item = items[currentHead];
+        head.store((currentHead + 1 == items.size()) ? 0 : currentHead + 1,
+                   std::memory_order_release);
+        return true;
+    }
+    
+    /** \brief Private method that wakes the other thread if its waiting flag
+     * is set. The sequentially consistent fence orders the preceding update
+     * of "head" or "tail" before the flag is read, while the waiting thread
+     * sets its flag before it checks the queue again, so the update cannot
+     * be missed by both threads. The mutex is taken so that the notification
+     * cannot arrive between the waiting thread's check and its wait.
+     */
+    void wakeWaitingThread(std::atomic<bool> & waiting){
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(waiting.load(std::memory_order_relaxed)){
+            std::lock_guard<std::mutex> lock(waitMutex);
+            waitCondition.notify_all();
+        }
+    }
+    
+public:
+    
+    /** \brief Constructor. Creates an empty queue.
+     *
+     * Requires one argument:
+     * 1) capacity - The largest number of items that the queue can hold.
+     */
+    explicit BoundedQueue(std::size_t capacity) : items(capacity + 1), head(0), tail(0),
+                                                  producerWaiting(false),
+                                                  consumerWaiting(false) {
+        // No further initialization operations are required.
+    }
+    
+    /** \brief Public method that appends an item to the queue, waiting while
+     * the queue is full.
+     */
+    void push(const Item & item){
+        bool pushed = tryPush(item);
+        for(unsigned int yieldIndex = 0; !pushed && yieldIndex < yieldCount; ++yieldIndex){
+            std::this_thread::yield();
+            pushed = tryPush(item);
+        }
+        if(!pushed){
+            std::unique_lock<std::mutex> lock(waitMutex);
+            producerWaiting.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            waitCondition.wait(lock, [&](){ return tryPush(item); });
+            producerWaiting.store(false, std::memory_order_relaxed);
+        }
+        wakeWaitingThread(consumerWaiting);
+    }
+    
+    /** \brief Public method that removes and returns the oldest item in the
+     * queue, waiting while the queue is empty.
+     */
+    Item pop(){
+        Item item;
+        bool popped = tryPop(item);
+        for(unsigned int yieldIndex = 0; !popped && yieldIndex < yieldCount; ++yieldIndex){
+            std::this_thread::yield();
+            popped = tryPop(item);
+        }
+        if(!popped){
+            std::unique_lock<std::mutex> lock(waitMutex);
+            consumerWaiting.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            waitCondition.wait(lock, [&](){ return tryPop(item); });
+            consumerWaiting.store(false, std::memory_order_relaxed);
+        }
+        wakeWaitingThread(producerWaiting);
+        return item;
+    }
+    
+};
+
+#endif /* End #ifndef BOUNDEDQUEUE_H preprocessor conditional block. */
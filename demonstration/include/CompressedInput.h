@@ -0,0 +1,181 @@
+// Define the COMPRESSEDINPUT_H macro to act as an include guard
+#ifndef COMPRESSEDINPUT_H
+#define COMPRESSEDINPUT_H
+
+// Include the <cstddef> header to provide the std::size_t and std::ptrdiff_t types.
+#include <cstddef>
+// Include the <vector> header to provide the STL std::vector type.
+#include <vector>
+
+/* Declare the structures in which the zlib and zstd libraries keep the state
+ * of a decompression, so that their headers need only be included by the
+ * implementation file.
+ */
+struct z_stream_s;
+struct ZSTD_DCtx_s;
+
+/** \brief Enumerates the formats in which an input file may be compressed.
+ */
+enum InputCompression {
+    /** \brief The input is not compressed. */
+    UNCOMPRESSED_INPUT,
+    /** \brief The input is compressed using gzip, and is decompressed using
+     * zlib if the program was compiled with COMPRESSED_INPUT_GZIP defined. */
+    GZIP_INPUT,
+    /** \brief The input is compressed using zstd, and is decompressed using
+     * libzstd if the program was compiled with COMPRESSED_INPUT_ZSTD defined. */
+    ZSTD_INPUT
+};
+
+/** \brief The number of leading bytes of an input file that are examined by
+ * detectInputCompression(), which is the length of the longest magic number.
+ */
+const std::size_t compressionMagicSize = 4;
+
+/** \brief Function that identifies the format in which an input file is
+ * compressed from the "magic number" with which every compressed file of
+ * that format begins.
+ *
+ * Requires two arguments:
+ * 1) leadingBytes - A pointer to the first bytes of the input file.
+ * 2) byteCount - The number of bytes available, which may be fewer than
+ *    "compressionMagicSize" if the file is very short.
+ */
+InputCompression detectInputCompression(const char * leadingBytes, std::size_t byteCount);
+
+/** \brief Function that returns true if input in the specified format can be
+ * decompressed by this build of the program.
+ */
+bool isInputCompressionSupported(InputCompression compression);
+
+/** \brief Function that returns a short, human-readable name for the
+ * specified format.
+ */
+const char * getInputCompressionName(InputCompression compression);
+
+/** \class InputDecompressor
+ * The InputDecompressor class decompresses a gzip or zstd compressed input,
+ * which it reads from an open file descriptor, as a stream. Each call of its
+ * read() method reads as much compressed input as it needs and decompresses
+ * it directly into the caller's buffer, in the manner of the POSIX read()
+ * function, so that a compressed file of any size can be parsed without
+ * its uncompressed contents ever being stored in full, on disk or in memory.
+ *
+ * A gzip input may consist of several concatenated members, and a zstd input
+ * of several concatenated frames, as produced for example by compressing
+ * the parts of a file separately. They are decompressed one after another.
+ *
+ * Both libraries are optional. Support for gzip is only compiled if the
+ * COMPRESSED_INPUT_GZIP macro is defined, in which case the program must be
+ * linked with -lz, and support for zstd if COMPRESSED_INPUT_ZSTD is defined,
+ * in which case it must be linked with -lzstd. Input in a format whose
+ * support was not compiled is still recognized, so that it can be reported
+ * rather than parsed as text.
+ *
+ * An InputDecompressor owns the state of its decompression, so it cannot be
+ * copied.
+ */
+class InputDecompressor {
+    
+    /** \brief The format of the input.
+     */
+    InputCompression compression;
+    
+    /** \brief The file descriptor from which the compressed input is read.
+     */
+    int fileDescriptor;
+    
+    /** \brief A buffer of compressed input that has been read from the file
+     * descriptor, of which the characters from "inputBegin" up to, but not
+     * including, "inputEnd" have not yet been decompressed.
+     */
+    std::vector<char> compressedInput;
+    std::size_t inputBegin;
+    std::size_t inputEnd;
+    
+    /** \brief Flag indicating that the end of the compressed input has been
+     * reached.
+     */
+    bool endOfInput;
+    
+    /** \brief Flag indicating that the final member or frame of the input has
+     * been completely decompressed.
+     */
+    bool finished;
+    
+    /** \brief Flag indicating that the input could not be read or is not
+     * valid compressed data.
+     */
+    bool failed;
+    
+    /** \brief The state of a gzip decompression, or a null pointer.
+     */
+    z_stream_s * gzipStream;
+    
+    /** \brief The state of a zstd decompression, or a null pointer.
+     */
+    ZSTD_DCtx_s * zstdContext;
+    
+    /** \brief Private method that reads more compressed input into the
+     * buffer, after any input that has not yet been decompressed. Returns
+     * false if the end of the input has been reached or it could not be
+     * read.
+     */
+    bool refillInput();
+    
+    /** \brief Private methods that decompress as much of the buffered input
+     * as fits in an output buffer, returning the number of characters that
+     * were produced.
+     */
+    std::size_t inflateGzip(char * buffer, std::size_t capacity);
+    std::size_t decompressZstd(char * buffer, std::size_t capacity);
+    
+    /** \brief The copy constructor and copy assignment operator are declared
+     * but not defined, which prevents copying.
+     */
+    InputDecompressor(const InputDecompressor &);
+    InputDecompressor & operator=(const InputDecompressor &);
+    
+public:
+    
+    /** \brief Default constructor. Creates a decompressor that has not yet
+     * been started.
+     */
+    InputDecompressor();
+    
+    /** \brief Destructor. Releases the state of the decompression.
+     */
+    ~InputDecompressor();
+    
+    /** \brief Public method that starts the decompression of an input.
+     * Returns true on success, or false if the format of the input is not
+     * supported by this build of the program.
+     *
+     * Requires four arguments:
+     * 1) inputCompression - The format of the input, as identified by
+     *    detectInputCompression().
+     * 2) inputDescriptor - A file descriptor open for reading, from which
+     *    the compressed input is read. It is not closed.
+     * 3) leadingBytes - A pointer to any bytes at the beginning of the
+     *    input that the caller has already read from the file descriptor,
+     *    such as those examined by detectInputCompression().
+     * 4) leadingByteCount - The number of those bytes.
+     */
+    bool start(InputCompression inputCompression, int inputDescriptor,
+               const char * leadingBytes, std::size_t leadingByteCount);
+    
+    /** \brief Public method that decompresses the next characters of the
+     * input into a buffer. Returns the number of characters produced, which
+     * is zero once the whole input has been decompressed, or -1 if the input
+     * could not be read or is not valid compressed data, including if it
+     * ends part of the way through a member or frame.
+     *
+     * Requires two arguments:
+     * 1) buffer - A pointer to the first character of the buffer.
+     * 2) capacity - The number of characters that the buffer can hold.
+     */
+    std::ptrdiff_t read(char * buffer, std::size_t capacity);
+    
+};
+
+#endif /* End #ifndef COMPRESSEDINPUT_H preprocessor conditional block. */
@@ -0,0 +1,169 @@
+// Define the GROUPHASHTABLE_H macro to act as an include guard
+#ifndef GROUPHASHTABLE_H
+#define GROUPHASHTABLE_H
+
+// Include the <cstddef> header to provide the std::size_t type.
+#include <cstddef>
+// Include the <cstdint> header to provide fixed-width integer types.
+#include <cstdint>
+// Include the <string_view> header to provide the std::string_view type.
+#include <string_view>
+// Include the <vector> header to provide the STL std::vector type.
+#include <vector>
+
+// Include "StatsAccumulator.h" to provide the StatsAccumulator class.
+#include "StatsAccumulator.h"
+
+/** \class GroupHashTable
+ * The GroupHashTable class associates a StatsAccumulator with each distinct
+ * key, which is an arbitrary string of characters, so that the statistics
+ * of the values that share a key can be accumulated without storing them.
+ *
+ * The table uses open addressing with linear probing, so it consists of a
+ * few flat arrays rather than one separately allocated node per key. The
+ * groups themselves are stored densely, in the order in which their keys
+ * were first inserted: the characters of every key are stored one after
+ * another in a single array, and the accumulators are stored in another.
+ * Each slot of the table holds the index of a group, the hash and length
+ * of its key and, for keys of up to "inlineKeyLength" characters, a copy of
+ * the key itself, so a typical lookup reads a single slot and a single
+ * accumulator.
+ *
+ * When millions of distinct keys are grouped, those two reads almost always
+ * miss the processor cache, and a lookup would spend most of its time
+ * waiting for memory. addValues() therefore processes values in batches,
+ * requesting the slots and then the accumulators of every value of a batch
+ * before any of them is used, so that the memory accesses of the batch
+ * overlap rather than follow one another.
+ *
+ * Two tables can be merged, so that separate parts of a file can be
+ * grouped independently, for example by different threads.
+ */
+class GroupHashTable {
+    
+public:
+    
+    /** \brief The longest key that is copied into the slot of its group.
+     */
+    static const std::size_t inlineKeyLength = 16;
+    
+private:
+    
+    /** \brief A structure that describes the group that occupies a slot of
+     * the table, which occupies half of a typical cache line.
+     */
+    struct Slot {
+        
+        /** \brief The hash of the key of the group.
+         */
+        std::uint64_t hash;
+        
+        /** \brief One more than the index of the group, or zero if the slot
+         * is empty.
+         */
+        std::uint32_t groupNumber;
+        
+        /** \brief The number of characters in the key of the group.
+         */
+        std::uint32_t keyLength;
+        
+        /** \brief The first "inlineKeyLength" characters of the key, followed
+         * by zeros if the key is shorter.
+         */
+        char keyPrefix[inlineKeyLength];
+    };
+    
+    /** \brief The slots of the table, whose number is a power of two.
+     */
+    std::vector<Slot> slots;
+    
+    /** \brief The offsets of the first character of the key of each group in
+     * "keyCharacters", followed by the total number of characters, so that
+     * the key of group i occupies the characters from keyOffsets[i] up to,
+     * but not including, keyOffsets[i + 1].
+     */
+    std::vector<std::size_t> keyOffsets;
+    
+    /** \brief The characters of the keys of every group, stored one after
+     * another.
+     */
+    std::vector<char> keyCharacters;
+    
+    /** \brief The running statistics of the values of each group.
+     */
+    std::vector<StatsAccumulator> accumulators;
+    
+    /** \brief Private method that doubles the number of slots and moves
+     * every occupied slot into the enlarged table.
+     */
+    void grow();
+    
+    /** \brief Private method that returns true if the specified slot is
+     * occupied by the group with the specified key and hash.
+     */
+    bool matchesSlot(const Slot & slot, std::string_view key, std::uint64_t hash) const;
+    
+    /** \brief Private method that returns the index of the group with the
+     * specified key and hash, inserting a new group if there is none.
+     */
+    std::size_t findOrInsert(std::string_view key, std::uint64_t hash);
+    
+public:
+    
+    /** \brief Default constructor. Creates a table with no groups.
+     */
+    GroupHashTable();
+    
+    /** \brief Public static method that returns the hash of a key.
+     */
+    static std::uint64_t hashKey(std::string_view key);
+    
+    /** \brief Public method returns the accumulator of the group with the
+     * specified key, inserting a group with an empty accumulator if there
+     * is none. The reference remains valid only until another group is
+     * inserted.
+     */
+    StatsAccumulator & getAccumulator(std::string_view key);
+    
+    /** \brief Public method that adds each of an array of values to the
+     * accumulator of the group with the corresponding key, inserting groups
+     * for keys that are not yet present.
+     *
+     * Requires three arguments:
+     * 1) keys - A pointer to the first element of an array of keys, none of
+     *    which may refer to characters stored by this table.
+     * 2) values - A pointer to the first element of an array of values.
+     * 3) valueCount - The number of elements in each array.
+     */
+    void addValues(const std::string_view * keys, const double * values,
+                   std::size_t valueCount);
+    
+    /** \brief Public method returns the index of the group with the
+     * specified key, or the number of groups if there is no such group.
+     */
+    std::size_t findGroup(std::string_view key) const;
+    
+    /** \brief Public method that adds the running statistics of every group
+     * of another table to those of the group of this table with the same
+     * key. Groups that are new to this table are appended in the order in
+     * which they appear in the other table.
+     */
+    void merge(const GroupHashTable & other);
+    
+    /** \brief Public method returns the number of groups.
+     */
+    std::size_t getGroupCount() const;
+    
+    /** \brief Public method returns the key of the group with the specified
+     * index, which refers to characters stored by the table.
+     */
+    std::string_view getKey(std::size_t groupIndex) const;
+    
+    /** \brief Public method returns the accumulator of the group with the
+     * specified index.
+     */
+    const StatsAccumulator & getGroupAccumulator(std::size_t groupIndex) const;
+    
+};
+
+#endif /* End #ifndef GROUPHASHTABLE_H preprocessor conditional block. */
@@ -0,0 +1,156 @@
+// Define the GROUPEDSTATS_H macro to act as an include guard
+#ifndef GROUPEDSTATS_H
+#define GROUPEDSTATS_H
+
+// Include the <cstddef> header to provide the std::size_t type.
+#include <cstddef>
+// Include the <iosfwd> header to declare the std::ostream type.
+#include <iosfwd>
+// Include the <string> header to provide the STL std::string type.
+#include <string>
+
+// Include "StatsCalculator.h" to provide the OutputVerbosity enumeration and
+// the StatsSummary structure.
+#include "StatsCalculator.h"
+// Include "GroupHashTable.h" to provide the GroupHashTable class.
+#include "GroupHashTable.h"
+
+/** \class GroupedStats
+ * The GroupedStats class reads a text file whose lines each contain a
+ * categorical key, such as the identifier of a sensor or of a host,
+ * followed by a numeric value, separated either by a comma or by
+ * whitespace. An optional header line names the two columns, and lines
+ * that are empty or begin with "#" are ignored.
+ *
+ * The values are not stored. Instead they are accumulated, as they are
+ * parsed, into the running statistics of the group of values that share
+ * their key, which are held in a GroupHashTable. The file is divided among
+ * several worker threads, each of which fills its own table, and the tables
+ * are merged when every thread has finished.
+ *
+ * The statistics of every group are reported one group per line, either in
+ * the order in which the keys first appear in the file or sorted by key.
+ */
+class GroupedStats {
+    
+    /** \brief The running statistics of each group of values.
+     */
+    GroupHashTable groups;
+    
+    /** \brief The name of the key column, taken from the header line or, if
+     * there is none, equal to "Key".
+     */
+    std::string keyName;
+    
+    /** \brief The number of worker threads among which readFile() divides
+     * the parsing of the input file.
+     */
+    unsigned int threadCount;
+    
+    /** \brief The amount of information that readFile() and writeStats()
+     * print to the terminal.
+     */
+    OutputVerbosity verbosity;
+    
+    /** \brief Flag indicating whether the groups are reported in order of
+     * their keys, rather than in order of first appearance.
+     */
+    bool sortedKeys;
+    
+    /** \brief Private static method that parses lines containing a key and
+     * a value from a range of characters that begins at the start of a line,
+     * adding each value to the group of its key in "table". Returns a
+     * pointer to the start of the first line that could not be parsed, or
+     * to the end of the range.
+     */
+    static const char * parseRows(const char * bufferBegin, const char * bufferEnd,
+                                  char separator, GroupHashTable & table);
+    
+    /** \brief Private method that writes the statistics of at most
+     * "maximumGroupCount" groups to an output stream, in the order selected
+     * by setSortedKeys().
+     */
+    void writeGroups(std::ostream & stream, std::size_t maximumGroupCount) const;
+    
+public:
+    
+    /** \brief Default constructor. Creates an object with no groups.
+     */
+    GroupedStats();
+    
+    /** \brief Public method that sets the number of worker threads.
+     *
+     * Requires one argument:
+     * 1) newThreadCount - The number of worker threads. A value of zero
+     *    selects the number of hardware threads available on the current
+     *    machine.
+     */
+    void setThreadCount(unsigned int newThreadCount);
+    
+    /** \brief Public method that sets the amount of information that
+     * readFile() and writeStats() print to the terminal.
+     *
+     * Requires one argument:
+     * 1) newVerbosity - QUIET_OUTPUT, or SUMMARY_OUTPUT (the default) or
+     *    FULL_OUTPUT, both of which print progress messages.
+     */
+    void setVerbosity(OutputVerbosity newVerbosity);
+    
+    /** \brief Public method that sets the order in which the groups are
+     * reported.
+     *
+     * Requires one argument:
+     * 1) enabled - true to sort the groups by key, comparing the characters
+     *    of the keys as unsigned bytes, or false (the default) to report
+     *    them in the order in which their keys first appear.
+     */
+    void setSortedKeys(bool enabled);
+    
+    /** \brief Public method that replaces the groups with those of the
+     * lines of a text file. Returns true if every line of the file was
+     * parsed, and false if the file could not be read, in which case there
+     * are no groups, or if a malformed line was encountered, in which case
+     * the values of the lines that precede it are retained.
+     *
+     * Requires one argument:
+     * 1) infileName - A string specifying the path of a text file whose
+     *    lines each contain a key and a numeric value.
+     */
+    bool readFile(const std::string & infileName);
+    
+    /** \brief Public method returns the number of groups.
+     */
+    std::size_t getGroupCount() const;
+    
+    /** \brief Public method returns the total number of values in every
+     * group.
+     */
+    std::size_t getValueCount() const;
+    
+    /** \brief Public method returns the table that holds the running
+     * statistics of each group.
+     */
+    const GroupHashTable & getGroups() const;
+    
+    /** \brief Public method that copies a summary of the statistical
+     * properties of the values with the specified key into "summary".
+     * Returns true on success and false if there is no such key.
+     */
+    bool getGroupSummary(const std::string & key, StatsSummary & summary) const;
+    
+    /** \brief Public method that prints the statistics of the first few
+     * groups to the terminal.
+     */
+    void printStats() const;
+    
+    /** \brief Public method that writes the statistics of every group to a
+     * text file.
+     *
+     * Requires one argument:
+     * 1) outfileName - A string specifying the path of the text file.
+     */
+    void writeStats(const std::string & outfileName) const;
+    
+};
+
+#endif /* End #ifndef GROUPEDSTATS_H preprocessor conditional block. */
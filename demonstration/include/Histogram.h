@@ -0,0 +1,180 @@
+// Define the HISTOGRAM_H macro to act as an include guard
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+// Include the <cstddef> header to provide the std::size_t type.
+#include <cstddef>
+// Include the <cstdint> header to provide fixed-width integer types.
+#include <cstdint>
+// Include the <iosfwd> header to declare the std::ostream type.
+#include <iosfwd>
+// Include the <vector> header to provide the STL std::vector type.
+#include <vector>
+
+/** \brief Enumerates the ways in which the bins of a Histogram can be spaced.
+ */
+enum HistogramScale {
+    /** \brief Bins of equal width. */
+    LINEAR_SCALE,
+    /** \brief Bins whose edges form a geometric sequence, so that they have
+     * equal widths on a logarithmic axis. Every edge must be positive. */
+    LOGARITHMIC_SCALE
+};
+
+/** \class Histogram
+ * The Histogram class counts the numeric values that are supplied to it
+ * incrementally in each of a fixed number of contiguous bins between a lower
+ * and an upper edge. Values below the lower edge or above the upper edge are
+ * counted separately as underflow and overflow respectively.
+ *
+ * Every bin includes its lower edge but not its upper edge, except for the
+ * last bin, which includes the upper edge of the histogram, so that the
+ * largest value is counted when the edges are set to the extreme values.
+ *
+ * Two histograms with identical bins can be merged, so that separate parts
+ * of a sequence of values can be binned independently, for example by
+ * different threads, without any synchronization.
+ */
+class Histogram {
+    
+    /** \brief The spacing of the bins.
+     */
+    HistogramScale scale;
+    
+    /** \brief The edges of the bins, of which there is one more than the
+     * number of bins.
+     */
+    std::vector<double> binEdges;
+    
+    /** \brief The count of values in each bin.
+     */
+    std::vector<std::uint64_t> binCounts;
+    
+    /** \brief The count of values below the lower edge of the first bin.
+     */
+    std::uint64_t underflowCount;
+    
+    /** \brief The count of values above the upper edge of the last bin.
+     */
+    std::uint64_t overflowCount;
+    
+    /** \brief The lower edge of the first bin, from which linearly spaced bins
+     * are located.
+     */
+    double origin;
+    
+    /** \brief The number of linearly spaced bins per unit of value.
+     */
+    double binsPerUnit;
+    
+    /** \brief The number of low-order bits that are discarded from the bit
+     * pattern of a value to locate a logarithmically spaced bin.
+     */
+    unsigned int lookupShift;
+    
+    /** \brief The bit pattern of the lower edge of the first bin after
+     * discarding "lookupShift" bits.
+     */
+    std::uint64_t lookupOrigin;
+    
+    /** \brief For logarithmically spaced bins, the first bin that may contain
+     * a value with each shortened bit pattern, counting from "lookupOrigin".
+     */
+    std::vector<std::size_t> binLookup;
+    
+    /** \brief Private method that adds an array of values, whose type is a
+     * template parameter, to the histogram. It is only instantiated, for
+     * each type accepted by addValues(), in the implementation file.
+     */
+    template<typename Element>
+    void addElements(const Element * values, std::size_t valueCount);
+    
+public:
+    
+    /** \brief Default constructor. Creates a histogram with no bins, which
+     * ignores every value that is added to it.
+     */
+    Histogram();
+    
+    /** \brief Constructor. Creates a histogram with empty bins.
+     *
+     * Requires four arguments:
+     * 1) newScale - The spacing of the bins.
+     * 2) binCount - The number of bins, which must be positive.
+     * 3) lowerEdge - The lower edge of the first bin.
+     * 4) upperEdge - The upper edge of the last bin, which must be greater
+     *    than "lowerEdge". For logarithmically spaced bins both edges must
+     *    be positive.
+     */
+    Histogram(HistogramScale newScale, std::size_t binCount, double lowerEdge,
+              double upperEdge);
+    
+    /** \brief Public method that adds a single value to the histogram.
+     * NaN values are ignored.
+     */
+    void addValue(double value);
+    
+    /** \brief Public method that adds an array of values to the histogram.
+     * NaN values are ignored.
+     *
+     * Requires two arguments:
+     * 1) values - A pointer to the first element of the array.
+     * 2) valueCount - The number of elements in the array.
+     */
+    void addValues(const double * values, std::size_t valueCount);
+    
+    /** \brief Public methods that add an array of single precision values or
+     * of 64-bit integers to the histogram, converting each to double
+     * precision.
+     *
+     * Requires two arguments:
+     * 1) values - A pointer to the first element of the array.
+     * 2) valueCount - The number of elements in the array.
+     */
+    void addValues(const float * values, std::size_t valueCount);
+    void addValues(const std::int64_t * values, std::size_t valueCount);
+    
+    /** \brief Public method that adds the counts of another histogram with
+     * identical bins to those of this histogram. Returns true on success,
+     * and false, leaving this histogram unchanged, if the bins differ.
+     */
+    bool merge(const Histogram & other);
+    
+    /** \brief Public method returns the spacing of the bins.
+     */
+    HistogramScale getScale() const;
+    
+    /** \brief Public method returns the number of bins.
+     */
+    std::size_t getBinCount() const;
+    
+    /** \brief Public method returns the edge with the specified index, from
+     * zero (the lower edge of the first bin) to the number of bins (the
+     * upper edge of the last bin).
+     */
+    double getBinEdge(std::size_t edgeIndex) const;
+    
+    /** \brief Public method returns the count of values in the bin with the
+     * specified index.
+     */
+    std::uint64_t getBinValueCount(std::size_t binIndex) const;
+    
+    /** \brief Public method returns the count of values below the lower edge
+     * of the first bin.
+     */
+    std::uint64_t getUnderflowCount() const;
+    
+    /** \brief Public method returns the count of values above the upper edge
+     * of the last bin.
+     */
+    std::uint64_t getOverflowCount() const;
+    
+    /** \brief Public method that writes the histogram to a text stream, as
+     * one line per bin containing its lower edge, upper edge and count.
+     * Returns true if the histogram was written successfully.
+     */
+    bool write(std::ostream & stream) const;
+    
+};
+
+#endif /* End #ifndef HISTOGRAM_H preprocessor conditional block. */
@@ -0,0 +1,237 @@
+// Define the QUANTILESKETCH_H macro to act as an include guard
+#ifndef QUANTILESKETCH_H
+#define QUANTILESKETCH_H
+
+// Include the <cstddef> header to provide the std::size_t type.
+#include <cstddef>
+// Include the <cstdint> header to provide fixed-width integer types.
+#include <cstdint>
+// Include the <vector> header to provide the STL std::vector type.
+#include <vector>
+
+/** \class SketchBucketStore
+ * The SketchBucketStore class counts the values that fall into each of a
+ * contiguous range of logarithmically spaced buckets, identified by integer
+ * keys. It is used by the QuantileSketch class to store the counts of its
+ * positive and negative values separately.
+ *
+ * The number of buckets is bounded. If a new key would exceed the bound,
+ * the buckets with the lowest keys are merged into a single bucket, so the
+ * accuracy of the lowest quantiles is sacrificed to preserve that of the
+ * highest. The store records that its lowest bucket has been collapsed in
+ * this way, so that estimates drawn from it can be identified.
+ */
+class SketchBucketStore {
+    
+    /** \brief The count of values in each bucket. The first element holds the
+     * count of the bucket whose key is "minimumKey".
+     */
+    std::vector<std::uint64_t> bucketCounts;
+    
+    /** \brief The key of the first bucket.
+     */
+    int minimumKey;
+    
+    /** \brief The maximum number of buckets.
+     */
+    std::size_t maximumBucketCount;
+    
+    /** \brief The total count of values in all buckets.
+     */
+    std::uint64_t totalCount;
+    
+    /** \brief A flag that records whether the lowest bucket also holds the
+     * counts of buckets with lower keys, which were merged into it.
+     */
+    bool lowestBucketCollapsed;
+    
+    /** \brief Private method that merges every bucket whose key is lower than
+     * "newMinimumKey" into the bucket with that key.
+     */
+    void collapseBelow(int newMinimumKey);
+    
+public:
+    
+    /** \brief Constructor. Creates an empty store with at most
+     * "maximumBuckets" buckets.
+     */
+    explicit SketchBucketStore(std::size_t maximumBuckets);
+    
+    /** \brief Public method that adds a count to the bucket with the
+     * specified key.
+     */
+    void add(int key, std::uint64_t count);
+    
+    /** \brief Public method that adds the counts of every bucket of another
+     * store to this store.
+     */
+    void merge(const SketchBucketStore & other);
+    
+    /** \brief Public method returns the total count of values in all buckets.
+     */
+    std::uint64_t getTotalCount() const;
+    
+    /** \brief Public method returns the key of the bucket that contains the
+     * value with the specified zero-based rank, counting from the lowest key.
+     */
+    int getKeyAtRank(std::uint64_t rank) const;
+    
+    /** \brief Public method returns true if the value with the specified
+     * zero-based rank, counting from the lowest key, lies in a bucket into
+     * which lower buckets were merged, so that its key is not accurate.
+     */
+    bool isRankCollapsed(std::uint64_t rank) const;
+    
+};
+
+/** \class QuantileSketch
+ * The QuantileSketch class maintains an approximate representation of the
+ * distribution of a sequence of numeric values that are supplied to it
+ * incrementally, from which any quantile (for example the median or the
+ * 99th percentile) can be estimated. The values themselves are not stored,
+ * and the memory that it occupies is bounded independently of the length of
+ * the sequence, typically to a few kilobytes.
+ *
+ * The sketch implements the DDSketch algorithm of Masson, Rim and Lee
+ * (2019). Each value is counted in a bucket whose boundaries are successive
+ * powers of \f$ \gamma = (1 + \alpha)/(1 - \alpha) \f$, so that every
+ * estimated quantile is within a relative error \f$ \alpha \f$ of the true
+ * value of that quantile, however skewed the distribution.
+ *
+ * Two sketches with the same relative accuracy that have been supplied with
+ * different parts of a sequence can be merged exactly to obtain the sketch
+ * of the whole sequence. This allows the parts to be processed
+ * independently, for example by different threads.
+ *
+ * The number of buckets is bounded, so values spread over too many buckets
+ * cause the lowest buckets to be merged. The quantiles drawn from a merged
+ * bucket are not within the relative accuracy, which isWithinAccuracy()
+ * reports. The smaller the relative accuracy, the narrower the range of
+ * values that the bounded buckets span, so accuracies below
+ * getMinimumRelativeAccuracy() are not supported.
+ */
+class QuantileSketch {
+    
+    /** \brief The relative accuracy \f$ \alpha \f$ of the estimated quantiles.
+     */
+    double relativeAccuracy;
+    
+    /** \brief The reciprocal of the natural logarithm of \f$ \gamma \f$, which
+     * converts the logarithm of a value to its bucket key.
+     */
+    double inverseLogGamma;
+    
+    /** \brief The counts of the positive values, keyed by magnitude.
+     */
+    SketchBucketStore positiveStore;
+    
+    /** \brief The counts of the negative values, keyed by magnitude.
+     */
+    SketchBucketStore negativeStore;
+    
+    /** \brief The count of the values whose magnitude is too small to be
+     * assigned to a bucket, which are treated as zero.
+     */
+    std::uint64_t zeroCount;
+    
+    /** \brief Private method returns the bucket key of a positive value.
+     */
+    int getKey(double magnitude) const;
+    
+    /** \brief Private method returns the representative value of the bucket
+     * with the specified key.
+     */
+    double getBucketValue(int key) const;
+    
+    /** \brief Private method returns the zero-based rank of the value that
+     * estimates the quantile with the specified probability. The sketch must
+     * not be empty.
+     */
+    std::uint64_t getRank(double probability) const;
+    
+public:
+    
+    /** \brief Default constructor. Creates an empty sketch with a relative
+     * accuracy of 1%.
+     */
+    QuantileSketch();
+    
+    /** \brief Constructor. Creates an empty sketch with the specified relative
+     * accuracy, which must be supported, as reported by
+     * isSupportedAccuracy().
+     */
+    explicit QuantileSketch(double accuracy);
+    
+    /** \brief Public static method returns the smallest supported relative
+     * accuracy.
+     */
+    static double getMinimumRelativeAccuracy();
+    
+    /** \brief Public static method returns true if the specified relative
+     * accuracy lies between getMinimumRelativeAccuracy() and one, excluding
+     * one.
+     *
+     * Requires one argument:
+     * 1) accuracy - The relative accuracy, for example 0.01 for 1%.
+     */
+    static bool isSupportedAccuracy(double accuracy);
+    
+    /** \brief Public method that adds a single value to the sketch.
+     */
+    void addValue(double value);
+    
+    /** \brief Public method that adds an array of values to the sketch.
+     *
+     * Requires two arguments:
+     * 1) values - A pointer to the first element of the array.
+     * 2) valueCount - The number of elements in the array.
+     */
+    void addValues(const double * values, std::size_t valueCount);
+    
+    /** \brief Public methods that add an array of single precision values or
+     * of 64-bit integers to the sketch, converting each to double precision.
+     *
+     * Requires two arguments:
+     * 1) values - A pointer to the first element of the array.
+     * 2) valueCount - The number of elements in the array.
+     */
+    void addValues(const float * values, std::size_t valueCount);
+    void addValues(const std::int64_t * values, std::size_t valueCount);
+    
+    /** \brief Public method that adds the counts of another sketch, which must
+     * have the same relative accuracy, to this sketch. Returns false, leaving
+     * this sketch unchanged, if the relative accuracies differ.
+     */
+    bool merge(const QuantileSketch & other);
+    
+    /** \brief Public method returns the number of values that have been added.
+     */
+    std::uint64_t getCount() const;
+    
+    /** \brief Public method returns the relative accuracy of the sketch.
+     */
+    double getRelativeAccuracy() const;
+    
+    /** \brief Public method returns an estimate of the specified quantile of
+     * the values that have been added.
+     *
+     * Requires one argument:
+     * 1) probability - The fraction of the values that lie below the
+     *    quantile, between zero and one. For example 0.5 for the median.
+     */
+    double getQuantile(double probability) const;
+    
+    /** \brief Public method returns true if the estimate of the specified
+     * quantile returned by getQuantile() is within the relative accuracy of
+     * the sketch, and false if it was drawn from a bucket into which lower
+     * buckets were merged, or no values have been added.
+     *
+     * Requires one argument:
+     * 1) probability - The fraction of the values that lie below the
+     *    quantile, between zero and one.
+     */
+    bool isWithinAccuracy(double probability) const;
+    
+};
+
+#endif /* End #ifndef QUANTILESKETCH_H preprocessor conditional block. */
@@ -0,0 +1,154 @@
+// Define the REDUCTIONKERNELS_H macro to act as an include guard
+#ifndef REDUCTIONKERNELS_H
+#define REDUCTIONKERNELS_H
+
+// Include the <cstddef> header to provide the std::size_t type.
+#include <cstddef>
+// Include the <cstdint> header to provide the std::int64_t type.
+#include <cstdint>
+
+/** \brief Enumerates the instruction sets for which explicitly vectorized
+ * reduction kernels are provided.
+ */
+enum ReductionInstructionSet {
+    /** \brief Portable kernel using only scalar floating-point arithmetic. */
+    SCALAR_REDUCTION,
+    /** \brief Kernel using 256-bit AVX2 and FMA vector instructions. */
+    AVX2_REDUCTION,
+    /** \brief Kernel using 512-bit AVX-512F vector instructions. */
+    AVX512_REDUCTION
+};
+
+/** \brief A structure that collects the sums of the first four powers of the
+ * deviations of an array of values from a shift value, together with the
+ * smallest and largest values of the array, all of which are computed in a
+ * single pass.
+ */
+struct ShiftedMomentSums {
+    
+    /** \brief The sum of the deviations.
+     */
+    double sum;
+    
+    /** \brief The sum of the squared deviations.
+     */
+    double sumOfSquares;
+    
+    /** \brief The sum of the cubed deviations.
+     */
+    double sumOfCubes;
+    
+    /** \brief The sum of the fourth powers of the deviations.
+     */
+    double sumOfFourthPowers;
+    
+    /** \brief The smallest element of the array, which is not shifted.
+     */
+    double minimum;
+    
+    /** \brief The largest element of the array, which is not shifted.
+     */
+    double maximum;
+};
+
+/** \brief Function that returns the most capable instruction set supported by
+ * the processor on which the program is currently running.
+ */
+ReductionInstructionSet detectReductionInstructionSet();
+
+/** \brief Function that returns true if the processor on which the program is
+ * currently running supports the specified instruction set.
+ */
+bool isReductionInstructionSetSupported(ReductionInstructionSet instructionSet);
+
+/** \brief Function that returns a short, human-readable name for the specified
+ * instruction set.
+ */
+const char * getReductionInstructionSetName(ReductionInstructionSet instructionSet);
+
+/** \brief Function that computes the sums of the first four powers of the
+ * deviations of an array of double precision values from a shift value, and
+ * the smallest and largest elements of the array, in a single pass, using
+ * the kernel for the most capable instruction set that the current
+ * processor supports.
+ *
+ * Requires four arguments:
+ * 1) values - A pointer to the first element of the array.
+ * 2) count - The number of elements in the array. If it is zero, the
+ *    minimum and maximum are positive and negative infinity respectively.
+ * 3) shift - The value that is subtracted from every element.
+ * 4) sums - A reference to a structure that receives the results.
+ */
+void shiftedMomentSums(const double * values, std::size_t count, double shift,
+                       ShiftedMomentSums & sums);
+
+/** \brief Function that computes the sums of the first four powers of the
+ * deviations of an array of double precision values from a shift value, and
+ * the smallest and largest elements of the array, in a single pass, using
+ * the kernel for a caller-specified instruction set. The instruction set
+ * must be supported by the current processor.
+ */
+void shiftedMomentSums(ReductionInstructionSet instructionSet,
+                       const double * values, std::size_t count, double shift,
+                       ShiftedMomentSums & sums);
+
+/** \brief Functions that compute the same sums as shiftedMomentSums(...) for
+ * an array of single precision values or of 64-bit integers, using the
+ * kernel for the most capable instruction set that the current processor
+ * supports. Every element is converted to double precision as it is loaded,
+ * so the sums are accumulated in double precision, which represents every
+ * 64-bit integer of magnitude up to 2^53 exactly.
+ */
+void shiftedMomentSums(const float * values, std::size_t count, double shift,
+                       ShiftedMomentSums & sums);
+void shiftedMomentSums(const std::int64_t * values, std::size_t count, double shift,
+                       ShiftedMomentSums & sums);
+
+/** \brief Functions that compute the same sums as shiftedMomentSums(...) for
+ * an array of single precision values or of 64-bit integers, using the
+ * kernel for a caller-specified instruction set. The instruction set must
+ * be supported by the current processor.
+ */
+void shiftedMomentSums(ReductionInstructionSet instructionSet,
+                       const float * values, std::size_t count, double shift,
+                       ShiftedMomentSums & sums);
+void shiftedMomentSums(ReductionInstructionSet instructionSet,
+                       const std::int64_t * values, std::size_t count, double shift,
+                       ShiftedMomentSums & sums);
+
+/** \brief Function that adds the sums of the products of every pair of
+ * columns of a block of double precision values to the elements on and
+ * above the diagonal of a square matrix, using the kernel for the most
+ * capable instruction set that the current processor supports. If the
+ * columns are the deviations of several variables from their means, the
+ * sums are the elements of the matrix X^T X from which their covariances
+ * are computed.
+ *
+ * Requires five arguments:
+ * 1) block - A pointer to the first value of the block, whose columns are
+ *    stored one after another.
+ * 2) columnCount - The number of columns in the block.
+ * 3) rowCount - The number of values in each column, which must be a
+ *    multiple of eight. Shorter columns can be padded with zeros, which
+ *    contribute nothing to the sums.
+ * 4) columnStride - The distance, in values, between the first values of
+ *    successive columns, which must not be less than "rowCount".
+ * 5) crossProducts - A pointer to the first element of a square matrix with
+ *    "columnCount" rows, stored row by row. The sum of the products of
+ *    columns i and j, where j >= i, is added to the element in row i and
+ *    column j. The elements below the diagonal are not modified.
+ */
+void addCrossProducts(const double * block, std::size_t columnCount, std::size_t rowCount,
+                      std::size_t columnStride, double * crossProducts);
+
+/** \brief Function that adds the sums of the products of every pair of
+ * columns of a block of double precision values to the elements on and
+ * above the diagonal of a square matrix, using the kernel for a
+ * caller-specified instruction set. The instruction set must be supported
+ * by the current processor.
+ */
+void addCrossProducts(ReductionInstructionSet instructionSet,
+                      const double * block, std::size_t columnCount, std::size_t rowCount,
+                      std::size_t columnStride, double * crossProducts);
+
+#endif /* End #ifndef REDUCTIONKERNELS_H preprocessor conditional block. */
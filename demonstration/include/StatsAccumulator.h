@@ -0,0 +1,207 @@
+// Define the STATSACCUMULATOR_H macro to act as an include guard
+#ifndef STATSACCUMULATOR_H
+#define STATSACCUMULATOR_H
+
+// Include the <cstddef> header to provide the std::size_t type.
+#include <cstddef>
+// Include the <cstdint> header to provide the std::int64_t type.
+#include <cstdint>
+// Include the <iosfwd> header to declare the std::istream and std::ostream types.
+#include <iosfwd>
+
+/** \brief A structure that collects the statistical properties of a sequence
+ * of numeric values, all of which are computed in a single pass over those
+ * values.
+ */
+struct StatsSummary {
+    
+    /** \brief The number of values in the sequence.
+     */
+    std::size_t count;
+    
+    /** \brief The sum of the values.
+     */
+    double sum;
+    
+    /** \brief The mean of the values.
+     */
+    double mean;
+    
+    /** \brief The variance of the values.
+     */
+    double variance;
+    
+    /** \brief The standard deviation of the values.
+     */
+    double standardDeviation;
+    
+    /** \brief The smallest of the values.
+     */
+    double minimum;
+    
+    /** \brief The largest of the values.
+     */
+    double maximum;
+    
+    /** \brief The skewness of the values, which measures the asymmetry of
+     * their distribution about the mean.
+     */
+    double skewness;
+    
+    /** \brief The excess kurtosis of the values, which measures the weight
+     * of the tails of their distribution relative to a normal distribution.
+     */
+    double excessKurtosis;
+};
+
+/** \class StatsAccumulator
+ * The StatsAccumulator class maintains running statistics of a sequence of
+ * numeric values that are supplied to it incrementally. The values
+ * themselves are not stored, so the memory that it occupies is independent
+ * of the length of the sequence.
+ *
+ * Two accumulators that have been supplied with different parts of a
+ * sequence can be merged to obtain the statistics of the whole sequence.
+ * This allows the parts to be processed independently, for example by
+ * different threads.
+ *
+ * Rather than the sums of the powers of the values, the accumulator stores
+ * the sums of the second, third and fourth powers of their deviations from
+ * the running mean, from which the variance, skewness and kurtosis are
+ * derived. These are updated using the method of Welford, as extended by
+ * Terriberry, for single values, and the pairwise method of Chan, Golub and
+ * LeVeque, as extended by Pebay, for arrays of values and merged
+ * accumulators. This avoids the catastrophic cancellation that affects the
+ * formula \f$ \langle X^{2} \rangle - \langle X \rangle^{2} \f$ when the
+ * standard deviation of the values is small relative to their mean. The
+ * smallest and largest values are also maintained.
+ *
+ * The running statistics can be written to and read from a compact binary
+ * "state" record, so that the statistics of a sequence that was divided
+ * among several processes or machines can be combined exactly without
+ * revisiting any of its values.
+ */
+class StatsAccumulator {
+    
+    /** \brief The number of values that have been accumulated.
+     */
+    std::size_t count;
+    
+    /** \brief The sum of the values that have been accumulated.
+     */
+    double sum;
+    
+    /** \brief The mean of the values that have been accumulated.
+     */
+    double mean;
+    
+    /** \brief The sum of the squared deviations of the values that have been
+     * accumulated from their mean, often denoted M2.
+     */
+    double sumOfSquaredDeviations;
+    
+    /** \brief The sum of the cubed deviations of the values that have been
+     * accumulated from their mean, often denoted M3.
+     */
+    double sumOfCubedDeviations;
+    
+    /** \brief The sum of the fourth powers of the deviations of the values
+     * that have been accumulated from their mean, often denoted M4.
+     */
+    double sumOfFourthPowerDeviations;
+    
+    /** \brief The smallest value that has been accumulated, or positive
+     * infinity if none have.
+     */
+    double minimum;
+    
+    /** \brief The largest value that has been accumulated, or negative
+     * infinity if none have.
+     */
+    double maximum;
+    
+    /** \brief Private method that adds an array of values, whose type is a
+     * template parameter, to the running statistics. It is only
+     * instantiated, for each type accepted by addValues(), in the
+     * implementation file.
+     */
+    template<typename Element>
+    void addElements(const Element * values, std::size_t valueCount);
+    
+public:
+    
+    /** \brief The number of bytes in a state record written by storeState()
+     * or writeState().
+     */
+    static const std::size_t stateRecordSize = 72;
+    
+    /** \brief Default constructor. Creates an accumulator that has not been
+     * supplied with any values.
+     */
+    StatsAccumulator();
+    
+    /** \brief Public method that adds a single value to the running statistics.
+     */
+    void addValue(double value);
+    
+    /** \brief Public method that adds an array of values to the running
+     * statistics.
+     *
+     * Requires two arguments:
+     * 1) values - A pointer to the first element of the array.
+     * 2) valueCount - The number of elements in the array.
+     */
+    void addValues(const double * values, std::size_t valueCount);
+    
+    /** \brief Public methods that add an array of single precision values or
+     * of 64-bit integers to the running statistics. Every value is converted
+     * to double precision before it is accumulated.
+     *
+     * Requires two arguments:
+     * 1) values - A pointer to the first element of the array.
+     * 2) valueCount - The number of elements in the array.
+     */
+    void addValues(const float * values, std::size_t valueCount);
+    void addValues(const std::int64_t * values, std::size_t valueCount);
+    
+    /** \brief Public method that adds the running statistics of another
+     * accumulator to those of this accumulator.
+     */
+    void merge(const StatsAccumulator & other);
+    
+    /** \brief Public method returns the number of values that have been
+     * accumulated.
+     */
+    std::size_t getCount() const;
+    
+    /** \brief Public method returns a summary of the statistical properties of
+     * the values that have been accumulated.
+     */
+    StatsSummary getSummary() const;
+    
+    /** \brief Public method that stores the running statistics in a buffer
+     * of "stateRecordSize" bytes as a fixed-size state record.
+     */
+    void storeState(unsigned char * record) const;
+    
+    /** \brief Public method that replaces the running statistics with those
+     * loaded from a state record in a buffer of "stateRecordSize" bytes.
+     * Returns true on success, and leaves the running statistics unchanged
+     * otherwise.
+     */
+    bool loadState(const unsigned char * record);
+    
+    /** \brief Public method that writes the running statistics to a binary
+     * stream as a fixed-size state record. Returns true on success.
+     */
+    bool writeState(std::ostream & stream) const;
+    
+    /** \brief Public method that replaces the running statistics with those
+     * read from a state record in a binary stream. Returns true on success,
+     * and leaves the running statistics unchanged otherwise.
+     */
+    bool readState(std::istream & stream);
+    
+};
+
+#endif /* End #ifndef STATSACCUMULATOR_H preprocessor conditional block. */
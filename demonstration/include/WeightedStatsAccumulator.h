@@ -0,0 +1,194 @@
+// Define the WEIGHTEDSTATSACCUMULATOR_H macro to act as an include guard
+#ifndef WEIGHTEDSTATSACCUMULATOR_H
+#define WEIGHTEDSTATSACCUMULATOR_H
+
+// Include the <cstddef> header to provide the std::size_t type.
+#include <cstddef>
+
+/** \brief A structure that collects the statistical properties of a sequence
+ * of weighted numeric values, all of which are computed in a single pass
+ * over those values.
+ */
+struct WeightedStatsSummary {
+    
+    /** \brief The number of values in the sequence, irrespective of their
+     * weights.
+     */
+    std::size_t count;
+    
+    /** \brief The sum of the weights, which is the total number of events if
+     * the weights are frequencies.
+     */
+    double sumOfWeights;
+    
+    /** \brief The effective number of values, i.e. the square of the sum of
+     * the weights divided by the sum of their squares, which is equal to
+     * "count" if every weight is identical.
+     */
+    double effectiveCount;
+    
+    /** \brief The sum of the products of the values and their weights.
+     */
+    double sum;
+    
+    /** \brief The weighted mean of the values.
+     */
+    double mean;
+    
+    /** \brief The weighted (population) variance of the values, i.e. the
+     * weighted mean squared deviation from the weighted mean.
+     */
+    double variance;
+    
+    /** \brief The square root of the weighted (population) variance.
+     */
+    double standardDeviation;
+    
+    /** \brief The unbiased estimate of the variance if the weights are
+     * frequencies, i.e. integer numbers of occurrences of each value.
+     */
+    double frequencyVariance;
+    
+    /** \brief The unbiased estimate of the variance if the weights are
+     * reliabilities, for example the reciprocals of the variances of the
+     * measurements, whose scale is arbitrary.
+     */
+    double reliabilityVariance;
+    
+    /** \brief The smallest of the values with a positive weight.
+     */
+    double minimum;
+    
+    /** \brief The largest of the values with a positive weight.
+     */
+    double maximum;
+    
+    /** \brief The weighted skewness of the values.
+     */
+    double skewness;
+    
+    /** \brief The weighted excess kurtosis of the values.
+     */
+    double excessKurtosis;
+};
+
+/** \class WeightedStatsAccumulator
+ * The WeightedStatsAccumulator class maintains running statistics of a
+ * sequence of numeric values, each of which is accompanied by a
+ * non-negative weight, without storing them. A value with weight w
+ * contributes to the statistics exactly as w copies of that value would
+ * contribute to those of a StatsAccumulator, so the sequence never needs
+ * to be expanded into repeated values, and weights need not be integers.
+ *
+ * The running statistics are represented as in StatsAccumulator, by the
+ * weighted mean and the weighted sums of the second, third and fourth
+ * powers of the deviations from it, with the sum of the weights taking the
+ * place of the number of values. The same pairwise update of Chan, Golub
+ * and LeVeque, as extended by Pebay, therefore adds blocks of values and
+ * merges accumulators, so that separate parts of a sequence can be
+ * processed independently, for example by different threads. The sum of
+ * the squares of the weights is also maintained, from which the unbiased
+ * variance for reliability weights is derived.
+ */
+class WeightedStatsAccumulator {
+    
+    /** \brief The number of values that have been accumulated.
+     */
+    std::size_t count;
+    
+    /** \brief The sum of the weights of the values that have been
+     * accumulated.
+     */
+    double sumOfWeights;
+    
+    /** \brief The sum of the squares of the weights of the values that have
+     * been accumulated.
+     */
+    double sumOfSquaredWeights;
+    
+    /** \brief The sum of the products of the values that have been
+     * accumulated and their weights.
+     */
+    double sum;
+    
+    /** \brief The weighted mean of the values that have been accumulated.
+     */
+    double mean;
+    
+    /** \brief The weighted sum of the squared deviations of the values from
+     * their weighted mean.
+     */
+    double sumOfSquaredDeviations;
+    
+    /** \brief The weighted sum of the cubed deviations of the values from
+     * their weighted mean.
+     */
+    double sumOfCubedDeviations;
+    
+    /** \brief The weighted sum of the fourth powers of the deviations of the
+     * values from their weighted mean.
+     */
+    double sumOfFourthPowerDeviations;
+    
+    /** \brief The smallest value with a positive weight that has been
+     * accumulated, or positive infinity if none have.
+     */
+    double minimum;
+    
+    /** \brief The largest value with a positive weight that has been
+     * accumulated, or negative infinity if none have.
+     */
+    double maximum;
+    
+public:
+    
+    /** \brief Default constructor. Creates an accumulator that has not been
+     * supplied with any values.
+     */
+    WeightedStatsAccumulator();
+    
+    /** \brief Public method that adds a single weighted value to the running
+     * statistics.
+     *
+     * Requires two arguments:
+     * 1) value - The value.
+     * 2) weight - The weight of the value, which must be finite and not
+     *    negative. A value with zero weight is counted, but does not
+     *    otherwise affect the statistics.
+     */
+    void addValue(double value, double weight);
+    
+    /** \brief Public method that adds an array of weighted values to the
+     * running statistics.
+     *
+     * Requires three arguments:
+     * 1) values - A pointer to the first element of the array of values.
+     * 2) weights - A pointer to the first element of the array of their
+     *    weights, each of which must be finite and not negative.
+     * 3) valueCount - The number of elements in each array.
+     */
+    void addValues(const double * values, const double * weights, std::size_t valueCount);
+    
+    /** \brief Public method that adds the running statistics of another
+     * accumulator to those of this accumulator.
+     */
+    void merge(const WeightedStatsAccumulator & other);
+    
+    /** \brief Public method returns the number of values that have been
+     * accumulated.
+     */
+    std::size_t getCount() const;
+    
+    /** \brief Public method returns the sum of the weights of the values
+     * that have been accumulated.
+     */
+    double getSumOfWeights() const;
+    
+    /** \brief Public method returns a summary of the statistical properties of
+     * the weighted values that have been accumulated.
+     */
+    WeightedStatsSummary getSummary() const;
+    
+};
+
+#endif /* End #ifndef WEIGHTEDSTATSACCUMULATOR_H preprocessor conditional block. */
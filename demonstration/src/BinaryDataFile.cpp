@@ -0,0 +1,334 @@
+// IMPLEMENTATION file for the binary data file functions
+
+// STL HEADER FILES
+
+// The <cstring> header is included to provide the std::memcmp(...) function.
+#include <cstring>
+// The <fstream> header is included to enable input from and output to files.
+#include <fstream>
+
+// LOCAL HEADER FILES
+
+/* The "BinaryDataFile.h" header is included to provide declarations of the
+ * functions that are defined in this file.
+ */
+#include "BinaryDataFile.h"
+
+/* The "ByteOrder.h" header is included to provide functions that store and
+ * load values in little-endian byte order.
+ */
+#include "ByteOrder.h"
+
+// CONSTANTS
+
+/* The four characters that identify a binary data file, followed by the
+ * version of its layout. Version 2 stores the larger block summaries that
+ * include the higher moments and extreme values of each block.
+ */
+static const char binaryDataMagic[4] = {'S', 'C', 'B', 'D'};
+static const std::uint32_t binaryDataVersion = 2;
+
+/* The four characters that identify a block index file, followed by the
+ * version of its layout, which changes with that of the block summaries.
+ */
+static const char blockIndexMagic[4] = {'S', 'C', 'B', 'I'};
+static const std::uint32_t blockIndexVersion = 2;
+
+/* The number of bytes in the header of a block index file, which precedes
+ * the block summaries.
+ */
+static const std::size_t blockIndexHeaderSize = 32;
+
+/* The number of bytes in the fixed part of the header, which precedes the
+ * block summaries.
+ */
+static const std::size_t fixedHeaderSize = 48;
+
+/* The first stored value is aligned to a multiple of this number of bytes,
+ * which is the size of a memory page on most systems, so that the values
+ * occupy whole pages when the file is memory-mapped.
+ */
+static const std::size_t dataAlignment = 4096;
+
+// PUBLIC FUNCTIONS
+
+/** Function that writes an array of double-precision values to a binary
+ * data file.
+ *
+ * \param fileName - A string specifying the path of the file to be written.
+ * If the file exists it will be overwritten.
+ * \param values - A pointer to the first element of the array.
+ * \param valueCount - The number of elements in the array.
+ *
+ * \return true if the file was written successfully, false otherwise.
+ *
+ * The file comprises a header followed by the values. The header begins
+ * with the following 48 bytes, in which every field is stored in
+ * little-endian byte order.
+ *
+ * - The four characters "SCBD" and the version of the layout, as a 32-bit
+ *   unsigned integer.
+ * - The type of the values (FLOAT64_DATA), as a 32-bit unsigned integer,
+ *   followed by four bytes that are reserved and set to zero.
+ * - The number of values, the number of values in each block, the number
+ *   of blocks and the offset of the first value from the beginning of the
+ *   file, each as a 64-bit unsigned integer.
+ *
+ * These are followed by one state record, written by
+ * StatsAccumulator::storeState(), for each block of "binaryDataBlockSize"
+ * consecutive values, the last of which may contain fewer values. Zero
+ * bytes then pad the header to a multiple of 4096 bytes, and the values
+ * follow as a contiguous array of little-endian IEEE 754 double-precision
+ * numbers.
+ *
+ * The block summaries allow the statistics of the whole file, or of any
+ * range of whole blocks, to be obtained without reading the values.
+ */
+bool writeBinaryDataFile(const std::string & fileName, const double * values,
+                         std::size_t valueCount){
+    
+    // Compute the number of blocks, and the offset of the first value.
+    std::size_t blockCount = (valueCount + binaryDataBlockSize - 1)/binaryDataBlockSize;
+    std::size_t summariesSize = blockCount*StatsAccumulator::stateRecordSize;
+    std::size_t dataOffset = (fixedHeaderSize + summariesSize + dataAlignment - 1)/
+        dataAlignment*dataAlignment;
+    
+    /* Assemble the whole header, including the padding, in a buffer whose
+     * elements are initialized to zero.
+     */
+    std::vector<unsigned char> header(dataOffset, 0);
+    std::memcpy(&header[0], binaryDataMagic, 4);
+    storeLittleEndian(&header[4], binaryDataVersion, 4);
+    storeLittleEndian(&header[8], FLOAT64_DATA, 4);
+    storeLittleEndian(&header[16], valueCount, 8);
+    storeLittleEndian(&header[24], binaryDataBlockSize, 8);
+    storeLittleEndian(&header[32], blockCount, 8);
+    storeLittleEndian(&header[40], dataOffset, 8);
+    
+    // Compute and store the summary of each block.
+    for(std::size_t blockIndex = 0; blockIndex < blockCount; ++blockIndex){
+        std::size_t blockBegin = blockIndex*binaryDataBlockSize;
+        std::size_t blockLength = valueCount - blockBegin;
+        if(blockLength > binaryDataBlockSize){
+            blockLength = binaryDataBlockSize;
+        }
+        
+        StatsAccumulator blockStatistics;
+        blockStatistics.addValues(values + blockBegin, blockLength);
+        blockStatistics.storeState(&header[fixedHeaderSize +
+                                          blockIndex*StatsAccumulator::stateRecordSize]);
+    }
+    
+    /* Open the output file in binary mode, so that no characters are
+     * translated on platforms that distinguish text and binary files.
+     */
+    std::ofstream outputFile(fileName.c_str(), std::ios::out | std::ios::binary);
+    if(!outputFile.is_open()){
+        return false;
+    }
+    outputFile.write(reinterpret_cast<const char *>(&header[0]), dataOffset);
+    
+    /* On a little-endian processor the values are already stored in memory
+     * in the required format, and can be written directly.
+     */
+    if(isLittleEndianHost()){
+        outputFile.write(reinterpret_cast<const char *>(values),
+                         valueCount*sizeof(double));
+    }
+    // Otherwise, convert the values in chunks of a manageable size.
+    else{
+        std::vector<unsigned char> chunk(8*binaryDataBlockSize);
+        for(std::size_t chunkBegin = 0; chunkBegin < valueCount;
+            chunkBegin += binaryDataBlockSize){
+            std::size_t chunkLength = valueCount - chunkBegin;
+            if(chunkLength > binaryDataBlockSize){
+                chunkLength = binaryDataBlockSize;
+            }
+            for(std::size_t valueIndex = 0; valueIndex < chunkLength; ++valueIndex){
+                storeDouble(&chunk[8*valueIndex], values[chunkBegin + valueIndex]);
+            }
+            outputFile.write(reinterpret_cast<const char *>(&chunk[0]), 8*chunkLength);
+        }
+    }
+    
+    // Closing the file flushes its buffer, which may reveal a write error.
+    outputFile.close();
+    return !outputFile.fail();
+}
+
+/** Function that reads and validates the header of a binary data file that
+ * has been loaded or mapped into memory.
+ *
+ * \param fileBegin - A pointer to the first byte of the file.
+ * \param fileSize - The number of bytes in the file.
+ * \param header - A reference to a BinaryDataHeader that receives the fields
+ * of the header.
+ *
+ * \return true if the file begins with a header of the expected layout whose
+ * block summaries and values lie within the file, false otherwise.
+ *
+ * See writeBinaryDataFile() for a description of the layout of the file.
+ */
+bool parseBinaryDataHeader(const unsigned char * fileBegin, std::size_t fileSize,
+                           BinaryDataHeader & header){
+    
+    // Verify the magic characters, version and type of the values.
+    if(fileSize < fixedHeaderSize ||
+       std::memcmp(fileBegin, binaryDataMagic, 4) != 0 ||
+       loadLittleEndian(fileBegin + 4, 4) != binaryDataVersion){
+        return false;
+    }
+    header.dataType = static_cast<std::uint32_t>(loadLittleEndian(fileBegin + 8, 4));
+    header.valueCount = loadLittleEndian(fileBegin + 16, 8);
+    header.blockSize = loadLittleEndian(fileBegin + 24, 8);
+    header.blockCount = loadLittleEndian(fileBegin + 32, 8);
+    header.dataOffset = loadLittleEndian(fileBegin + 40, 8);
+    if(header.dataType != FLOAT64_DATA || header.blockSize == 0){
+        return false;
+    }
+    
+    /* Verify that the block summaries and the values lie within the file.
+     * The comparisons are arranged so that they cannot overflow, however
+     * corrupt the header may be.
+     */
+    if(header.blockCount != (header.valueCount + header.blockSize - 1)/header.blockSize ||
+       header.blockCount > (fileSize - fixedHeaderSize)/StatsAccumulator::stateRecordSize ||
+       header.dataOffset < fixedHeaderSize +
+                           header.blockCount*StatsAccumulator::stateRecordSize ||
+       header.dataOffset % sizeof(double) != 0 ||
+       header.dataOffset > fileSize ||
+       header.valueCount > (fileSize - header.dataOffset)/sizeof(double)){
+        return false;
+    }
+    
+    return true;
+}
+
+/** Function that loads the summary of the statistics of one block of values
+ * from the header of a binary data file that has been loaded or mapped into
+ * memory.
+ *
+ * \param fileBegin - A pointer to the first byte of the file.
+ * \param header - The header of the file, obtained using
+ * parseBinaryDataHeader().
+ * \param blockIndex - The index of the block.
+ * \param statistics - A reference to a StatsAccumulator that receives the
+ * statistics of the block.
+ *
+ * \return true if the block exists and its summary is a valid state record,
+ * false otherwise.
+ */
+bool loadBlockStatistics(const unsigned char * fileBegin, const BinaryDataHeader & header,
+                         std::size_t blockIndex, StatsAccumulator & statistics){
+    if(blockIndex >= header.blockCount){
+        return false;
+    }
+    return statistics.loadState(fileBegin + fixedHeaderSize +
+                                blockIndex*StatsAccumulator::stateRecordSize);
+}
+
+/** Function that writes an index of block summaries to a binary index file.
+ *
+ * \param fileName - A string specifying the path of the file to be written.
+ * If the file exists it will be overwritten.
+ * \param blockSummaries - The statistics of each consecutive block of
+ * "binaryDataBlockSize" values.
+ * \param valueCount - The number of values in the data set that was indexed.
+ *
+ * \return true if the file was written successfully, false otherwise.
+ *
+ * The file begins with a 32-byte header comprising the four characters
+ * "SCBI", the version of the layout as a 32-bit unsigned integer, and the
+ * number of values, the number of values in each block and the number of
+ * blocks, each as a 64-bit unsigned integer. One state record, written by
+ * StatsAccumulator::storeState(), follows for each block. Every field is
+ * stored in little-endian byte order.
+ *
+ * The block summaries of a binary data file are stored in its own header,
+ * so a separate index file is only required for a text file.
+ */
+bool writeBlockIndexFile(const std::string & fileName,
+                         const std::vector<StatsAccumulator> & blockSummaries,
+                         std::uint64_t valueCount){
+    
+    // Assemble the whole file in a buffer, so it is written in one call.
+    std::size_t recordSize = StatsAccumulator::stateRecordSize;
+    std::vector<unsigned char> buffer(blockIndexHeaderSize +
+                                      blockSummaries.size()*recordSize);
+    std::memcpy(&buffer[0], blockIndexMagic, 4);
+    storeLittleEndian(&buffer[4], blockIndexVersion, 4);
+    storeLittleEndian(&buffer[8], valueCount, 8);
+    storeLittleEndian(&buffer[16], binaryDataBlockSize, 8);
+    storeLittleEndian(&buffer[24], blockSummaries.size(), 8);
+    for(std::size_t blockIndex = 0; blockIndex < blockSummaries.size(); ++blockIndex){
+        blockSummaries[blockIndex].storeState(&buffer[blockIndexHeaderSize +
+                                                      blockIndex*recordSize]);
+    }
+    
+    std::ofstream indexFile(fileName.c_str(), std::ios::out | std::ios::binary);
+    if(!indexFile.is_open()){
+        return false;
+    }
+    indexFile.write(reinterpret_cast<const char *>(&buffer[0]), buffer.size());
+    indexFile.close();
+    return !indexFile.fail();
+}
+
+/** Function that reads an index of block summaries from a binary index file.
+ *
+ * \param fileName - A string specifying the path of the index file.
+ * \param blockSummaries - A reference to a vector that receives the
+ * statistics of each block.
+ * \param valueCount - A reference to a variable that receives the number of
+ * values in the data set that was indexed.
+ *
+ * \return true if the file could be opened and contains a complete index
+ * with the expected layout and block size, false otherwise. If false is
+ * returned "blockSummaries" and "valueCount" are unchanged.
+ *
+ * See writeBlockIndexFile() for a description of the layout of the file.
+ */
+bool readBlockIndexFile(const std::string & fileName,
+                        std::vector<StatsAccumulator> & blockSummaries,
+                        std::uint64_t & valueCount){
+    std::ifstream indexFile(fileName.c_str(), std::ios::in | std::ios::binary);
+    if(!indexFile.is_open()){
+        return false;
+    }
+    
+    // Read and verify the header.
+    unsigned char header[blockIndexHeaderSize];
+    indexFile.read(reinterpret_cast<char *>(header), blockIndexHeaderSize);
+    if(indexFile.gcount() != static_cast<std::streamsize>(blockIndexHeaderSize) ||
+       std::memcmp(header, blockIndexMagic, 4) != 0 ||
+       loadLittleEndian(header + 4, 4) != blockIndexVersion ||
+       loadLittleEndian(header + 16, 8) != binaryDataBlockSize){
+        return false;
+    }
+    std::uint64_t indexedValueCount = loadLittleEndian(header + 8, 8);
+    std::uint64_t blockCount = loadLittleEndian(header + 24, 8);
+    
+    // Only complete blocks are indexed.
+    if(blockCount != indexedValueCount/binaryDataBlockSize){
+        return false;
+    }
+    
+    /* Read each block summary into a temporary vector, which replaces the
+     * caller's vector only if every summary is valid.
+     */
+    std::vector<StatsAccumulator> indexSummaries;
+    unsigned char record[StatsAccumulator::stateRecordSize];
+    for(std::uint64_t blockIndex = 0; blockIndex < blockCount; ++blockIndex){
+        indexFile.read(reinterpret_cast<char *>(record), sizeof(record));
+        StatsAccumulator blockStatistics;
+        if(indexFile.gcount() != static_cast<std::streamsize>(sizeof(record)) ||
+           !blockStatistics.loadState(record)){
+            return false;
+        }
+        indexSummaries.push_back(blockStatistics);
+    }
+    
+    blockSummaries.swap(indexSummaries);
+    valueCount = indexedValueCount;
+    return true;
+}
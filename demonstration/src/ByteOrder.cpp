@@ -0,0 +1,91 @@
+// IMPLEMENTATION file for byte order conversion functions
+
+// STL HEADER FILES
+
+// The <cstring> header is included to provide the std::memcpy(...) function.
+#include <cstring>
+
+// LOCAL HEADER FILES
+
+/* The "ByteOrder.h" header is included to provide declarations of the
+ * functions that are defined in this file.
+ */
+#include "ByteOrder.h"
+
+// PUBLIC FUNCTIONS
+
+/** Function that returns true if the processor on which the program is
+ * currently running stores multi-byte values in little-endian byte order.
+ *
+ * \return true for a little-endian processor, false otherwise.
+ *
+ * The first byte of a multi-byte integer with the value one is examined. A
+ * little-endian processor stores the least significant byte first, so that
+ * byte is one.
+ */
+bool isLittleEndianHost(){
+    std::uint32_t probe(1);
+    unsigned char firstByte;
+    std::memcpy(&firstByte, &probe, 1);
+    return firstByte == 1;
+}
+
+/** Function that stores an unsigned integer in a buffer as a little-endian
+ * sequence of bytes, independently of the byte order of the processor.
+ *
+ * \param buffer - A pointer to the first byte to be written.
+ * \param value - The value to be stored.
+ * \param byteCount - The number of bytes to be written, at most eight.
+ */
+void storeLittleEndian(unsigned char * buffer, std::uint64_t value,
+                       std::size_t byteCount){
+    for(std::size_t byteIndex = 0; byteIndex < byteCount; ++byteIndex){
+        buffer[byteIndex] = static_cast<unsigned char>(value >> (8*byteIndex));
+    }
+}
+
+/** Function that loads an unsigned integer from a little-endian sequence of
+ * bytes in a buffer.
+ *
+ * \param buffer - A pointer to the first byte to be read.
+ * \param byteCount - The number of bytes to be read, at most eight.
+ *
+ * \return The value that was stored.
+ */
+std::uint64_t loadLittleEndian(const unsigned char * buffer, std::size_t byteCount){
+    std::uint64_t value(0);
+    for(std::size_t byteIndex = 0; byteIndex < byteCount; ++byteIndex){
+        value |= static_cast<std::uint64_t>(buffer[byteIndex]) << (8*byteIndex);
+    }
+    return value;
+}
+
+/** Function that stores a double-precision value in a buffer as the
+ * little-endian sequence of bytes of its IEEE 754 representation.
+ *
+ * \param buffer - A pointer to the first of the eight bytes to be written.
+ * \param value - The value to be stored.
+ */
+void storeDouble(unsigned char * buffer, double value){
+    
+    /* Copy the bits of the value into an integer of the same size. Unlike a
+     * pointer cast, std::memcpy does not violate the strict aliasing rules.
+     */
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    storeLittleEndian(buffer, bits, 8);
+}
+
+/** Function that loads a double-precision value from the little-endian
+ * sequence of bytes of its IEEE 754 representation.
+ *
+ * \param buffer - A pointer to the first of the eight bytes to be read.
+ *
+ * \return The value that was stored.
+ */
+double loadDouble(const unsigned char * buffer){
+    std::uint64_t bits = loadLittleEndian(buffer, 8);
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
@@ -0,0 +1,591 @@
+// IMPLEMENTATION file for the ColumnTable class
+
+// STL HEADER FILES
+
+/* The <algorithm> header is included to provide the std::count(...)
+ * function.
+ */
+#include <algorithm>
+// The <fstream> header is included to enable output to files.
+#include <fstream>
+// The <iostream> header is included to enable textual terminal output.
+#include <iostream>
+// The <thread> header is included to provide the std::thread class.
+#include <thread>
+
+// LOCAL HEADER FILES
+
+/* The "ColumnTable.h" header is included to provide a definition of the
+ * ColumnTable class.
+ */
+#include "ColumnTable.h"
+
+/* The "DelimitedText.h" header is included to provide the MappedTextFile
+ * class and the functions that divide a file into lines and fields.
+ */
+#include "DelimitedText.h"
+
+/* The "StatsAccumulator.h" header is included to provide the
+ * StatsAccumulator class.
+ */
+#include "StatsAccumulator.h"
+
+// CONSTANTS
+
+/* Each worker thread of getCovarianceMatrices() should receive at least this
+ * many rows.
+ */
+static const std::size_t minimumCovarianceRowCount = 1 << 14;
+
+// HELPER FUNCTIONS
+
+/** Helper function that writes a summary of the statistical properties of a
+ * column to an output stream.
+ *
+ * \param stream - The stream to which the summary is written.
+ * \param summary - The summary.
+ *
+ * The statistics are written in the format "Statistic_Name =
+ * Statistic_Value", in the same order as StatsCalculator::writeStats().
+ */
+static void writeSummary(std::ostream & stream, const StatsSummary & summary){
+    stream << "Sum =  " << summary.sum << "\n"
+    << "Mean = " << summary.mean << "\n"
+    << "Standard Deviation = " << summary.standardDeviation << "\n"
+    << "Count = " << summary.count << "\n"
+    << "Minimum = " << summary.minimum << "\n"
+    << "Maximum = " << summary.maximum << "\n"
+    << "Skewness = " << summary.skewness << "\n"
+    << "Excess Kurtosis = " << summary.excessKurtosis
+    << "\n" << std::endl;
+}
+
+// PRIVATE METHODS OF COLUMNTABLE
+
+/** Private static method that parses rows of numeric values.
+ *
+ * \param bufferBegin - A pointer to the first character of the range, which
+ * must be the first character of a line.
+ * \param bufferEnd - A pointer one past the last character of the range,
+ * which must be the end of a line or of the file.
+ * \param separator - ',' if the values are separated by commas, which may
+ * be surrounded by whitespace, or ' ' if they are separated by whitespace.
+ * \param columns - A vector with one element per column, to each of which
+ * the values of that column are appended.
+ *
+ * \return A pointer to the first character of the first line that could not
+ * be parsed, or "bufferEnd" if every line was parsed.
+ *
+ * Every row must contain exactly one value per column. The values of a row
+ * are parsed into a small buffer and appended to the columns only when the
+ * whole row has been parsed, so a malformed row contributes no values to
+ * any column and the columns always have equal lengths. Empty lines and
+ * lines that begin with "#" are skipped.
+ */
+const char * ColumnTable::parseRows(const char * bufferBegin, const char * bufferEnd,
+                                    char separator,
+                                    std::vector<std::vector<double> > & columns){
+    
+    std::size_t columnCount = columns.size();
+    std::vector<double> rowValues(columnCount);
+    const char * lineBegin = bufferBegin;
+    
+    while(lineBegin != bufferEnd){
+        
+        // Skip the whitespace at the start of the line.
+        const char * position = lineBegin;
+        while(position != bufferEnd && isBlank(*position)){
+            ++position;
+        }
+        
+        // Skip empty lines and comment lines.
+        if(position == bufferEnd || *position == '\n' || *position == '#'){
+            lineBegin = findLineEnd(position, bufferEnd);
+            if(lineBegin != bufferEnd){
+                ++lineBegin;
+            }
+            continue;
+        }
+        
+        // Parse one value per column.
+        for(std::size_t columnIndex = 0; columnIndex < columnCount; ++columnIndex){
+            
+            // Every value after the first is preceded by a separator.
+            if(columnIndex > 0){
+                const char * fieldBegin = position;
+                while(position != bufferEnd && isBlank(*position)){
+                    ++position;
+                }
+                if(separator == ','){
+                    if(position == bufferEnd || *position != ','){
+                        return lineBegin;
+                    }
+                    ++position;
+                    while(position != bufferEnd && isBlank(*position)){
+                        ++position;
+                    }
+                }
+                else if(position == fieldBegin){
+                    return lineBegin;
+                }
+            }
+            
+            position = parseValue(position, bufferEnd, rowValues[columnIndex]);
+            if(!position){
+                return lineBegin;
+            }
+        }
+        
+        // The row must end after the last value.
+        while(position != bufferEnd && isBlank(*position)){
+            ++position;
+        }
+        if(position != bufferEnd && *position != '\n'){
+            return lineBegin;
+        }
+        
+        // Append the values of the complete row to the columns.
+        for(std::size_t columnIndex = 0; columnIndex < columnCount; ++columnIndex){
+            columns[columnIndex].push_back(rowValues[columnIndex]);
+        }
+        lineBegin = (position == bufferEnd) ? bufferEnd : position + 1;
+    }
+    
+    return bufferEnd;
+}
+
+/** Private method that writes the summary of every column to an output
+ * stream.
+ *
+ * \param stream - The stream to which the summaries are written.
+ *
+ * Each summary is preceded by the one-based index and the name of its
+ * column. Every summary is obtained from getColumnSummary(), so the values
+ * are traversed at most once.
+ */
+void ColumnTable::writeSummaries(std::ostream & stream) const {
+    stream << "Simple statistical analysis of " << getColumnCount()
+    << " columns of numeric data:\n\n";
+    for(std::size_t columnIndex = 0; columnIndex < getColumnCount(); ++columnIndex){
+        stream << "Column " << columnIndex + 1 << " (" << columnNames[columnIndex]
+        << "):\n\n";
+        writeSummary(stream, getColumnSummary(columnIndex));
+    }
+    if(covarianceMatrices){
+        writeMatrices(stream);
+    }
+}
+
+/** Private method that writes the covariance and correlation matrices of the
+ * columns to an output stream.
+ *
+ * \param stream - The stream to which the matrices are written.
+ *
+ * Each row of a matrix is written in the format "Column_Name = Value_1
+ * Value_2 ...", with one value for each column in the order in which the
+ * columns are summarized.
+ */
+void ColumnTable::writeMatrices(std::ostream & stream) const {
+    const CovarianceAccumulator & covariance = getCovarianceMatrices();
+    stream << "Covariance Matrix:\n\n";
+    for(std::size_t first = 0; first < getColumnCount(); ++first){
+        stream << columnNames[first] << " =";
+        for(std::size_t second = 0; second < getColumnCount(); ++second){
+            stream << " " << covariance.getCovariance(first, second);
+        }
+        stream << "\n";
+    }
+    stream << "\nCorrelation Matrix:\n\n";
+    for(std::size_t first = 0; first < getColumnCount(); ++first){
+        stream << columnNames[first] << " =";
+        for(std::size_t second = 0; second < getColumnCount(); ++second){
+            stream << " " << covariance.getCorrelation(first, second);
+        }
+        stream << "\n";
+    }
+    stream << std::endl;
+}
+
+// PUBLIC METHODS OF COLUMNTABLE
+
+/** Default constructor for the ColumnTable class.
+ *
+ * Creates a table with no columns, which is parsed and summarized on the
+ * calling thread unless setThreadCount() is subsequently invoked.
+ */
+ColumnTable::ColumnTable() : columnNames(), columnValues(), threadCount(1),
+                             verbosity(SUMMARY_OUTPUT), cachedSummaries(),
+                             cachedSummariesAreValid(false), covarianceMatrices(false),
+                             cachedCovariance(), cachedCovarianceIsValid(false) {
+    // No further initialization operations are required.
+}
+
+/** Public method that sets the number of worker threads.
+ *
+ * \param newThreadCount - The number of worker threads. A value of zero
+ * selects the number of hardware threads available on the current machine.
+ */
+void ColumnTable::setThreadCount(unsigned int newThreadCount){
+    if(newThreadCount == 0){
+        newThreadCount = std::thread::hardware_concurrency();
+    }
+    // std::thread::hardware_concurrency() may return zero.
+    threadCount = (newThreadCount > 0) ? newThreadCount : 1;
+}
+
+/** Public method that sets the amount of information that readFile() and
+ * writeStats() print to the terminal.
+ *
+ * \param newVerbosity - QUIET_OUTPUT to print nothing except failures.
+ */
+void ColumnTable::setVerbosity(OutputVerbosity newVerbosity){
+    verbosity = newVerbosity;
+}
+
+/** Public method that sets whether printStats() and writeStats() also report
+ * the covariance and correlation matrices of the columns.
+ *
+ * \param enabled - true to report the matrices.
+ */
+void ColumnTable::setCovarianceMatrices(bool enabled){
+    covarianceMatrices = enabled;
+}
+
+/** Public method that replaces the contents of the table with the rows of a
+ * text file.
+ *
+ * \param infileName - A string specifying the path of the text file.
+ *
+ * \return true if every line of the file was parsed, false otherwise.
+ *
+ * The file is memory-mapped by a MappedTextFile, as by
+ * StatsCalculator::readFile(), or decompressed into memory by it if it is
+ * compressed using gzip or zstd. Its first line that is neither empty nor a
+ * comment determines the layout of the table: the values are separated by
+ * commas if it contains a comma, and by whitespace otherwise, and the number
+ * of its fields is the number of columns. If every field of that line is
+ * numeric, it is the first row; otherwise it is a header whose fields name
+ * the columns.
+ *
+ * The rows that follow are divided by divideIntoLineRanges() into at most
+ * "threadCount" byte ranges of approximately equal size, each beginning at
+ * the start of a line, and each range is parsed by parseRows() on its own
+ * worker thread into its own set of columns. The columns of each range are
+ * then appended to those of the table in order. If a malformed row is encountered, it and every row that
+ * follows are discarded, and the number of the line on which it begins is
+ * reported on the terminal.
+ */
+bool ColumnTable::readFile(const std::string & infileName){
+    
+    // Print an informative message to inform the caller of progress.
+    if(verbosity != QUIET_OUTPUT){
+        std::cout << "Reading columns of data from:\n\n" << infileName << std::endl;
+    }
+    
+    // Discard the contents of the table.
+    columnNames.clear();
+    columnValues.clear();
+    cachedSummariesAreValid = false;
+    cachedCovarianceIsValid = false;
+    
+    // Memory-map the input file.
+    MappedTextFile inputFile(infileName);
+    bool validFile(inputFile.isReadable());
+    std::size_t failedLine(0);
+    if(validFile && inputFile.begin() != inputFile.end()){
+        const char * fileBegin = inputFile.begin();
+        const char * fileEnd = inputFile.end();
+        
+        // Find the first line that is neither empty nor a comment.
+        const char * lineBegin = findFirstDataLine(fileBegin, fileEnd);
+        const char * lineEnd = findLineEnd(lineBegin, fileEnd);
+        
+        /* Determine the separator, the number of columns and whether the
+         * line is a header.
+         */
+        char separator = (std::find(lineBegin, lineEnd, ',') != lineEnd) ? ',' : ' ';
+        std::vector<std::string> fields = splitFields(lineBegin, lineEnd, separator);
+        bool headerLine(false);
+        for(std::size_t fieldIndex = 0; fieldIndex < fields.size(); ++fieldIndex){
+            const std::string & field = fields[fieldIndex];
+            double value(0.0);
+            const char * fieldEnd = field.data() + field.size();
+            headerLine = headerLine || parseValue(field.data(), fieldEnd, value) != fieldEnd;
+        }
+        for(std::size_t fieldIndex = 0; fieldIndex < fields.size(); ++fieldIndex){
+            columnNames.push_back(headerLine ? fields[fieldIndex] :
+                                  std::to_string(fieldIndex + 1));
+        }
+        const char * dataBegin = lineBegin;
+        if(headerLine){
+            dataBegin = (lineEnd == fileEnd) ? fileEnd : lineEnd + 1;
+        }
+        
+        // Divide the rows into line-aligned ranges, one per worker thread.
+        std::vector<const char *> rangeBegins = divideIntoLineRanges(dataBegin, fileEnd,
+                                                                     threadCount);
+        std::size_t rangeCount = rangeBegins.size() - 1;
+        
+        /* Parse each range on its own worker thread into its own set of
+         * columns, so that the threads share no mutable data.
+         */
+        std::vector<std::vector<std::vector<double> > > rangeColumns(rangeCount,
+            std::vector<std::vector<double> >(fields.size()));
+        std::vector<const char *> rangeStops(rangeCount);
+        std::vector<std::thread> workers;
+        for(std::size_t rangeIndex = 0; rangeIndex < rangeCount; ++rangeIndex){
+            workers.push_back(std::thread([&, rangeIndex](){
+                rangeStops[rangeIndex] = parseRows(rangeBegins[rangeIndex],
+                                                   rangeBegins[rangeIndex + 1],
+                                                   separator, rangeColumns[rangeIndex]);
+            }));
+        }
+        for(std::size_t rangeIndex = 0; rangeIndex < rangeCount; ++rangeIndex){
+            workers[rangeIndex].join();
+        }
+        
+        /* Count the rows that are retained, so that each column can be
+         * allocated exactly once, then append the columns of each
+         * retained range in order. The columns of a single range are
+         * simply swapped into the table, without copying.
+         */
+        std::size_t retainedRangeCount(0);
+        std::size_t retainedRowCount(0);
+        validFile = true;
+        while(retainedRangeCount < rangeCount && validFile){
+            if(!fields.empty()){
+                retainedRowCount += rangeColumns[retainedRangeCount][0].size();
+            }
+            validFile = rangeStops[retainedRangeCount] == rangeBegins[retainedRangeCount + 1];
+            ++retainedRangeCount;
+        }
+        if(!validFile){
+            const char * stop = rangeStops[retainedRangeCount - 1];
+            failedLine = std::count(fileBegin, stop, '\n') + 1;
+        }
+        columnValues.resize(fields.size());
+        for(std::size_t columnIndex = 0; columnIndex < fields.size(); ++columnIndex){
+            if(retainedRangeCount == 1){
+                columnValues[columnIndex].swap(rangeColumns[0][columnIndex]);
+                continue;
+            }
+            columnValues[columnIndex].reserve(retainedRowCount);
+            for(std::size_t rangeIndex = 0; rangeIndex < retainedRangeCount; ++rangeIndex){
+                std::vector<double> & values = rangeColumns[rangeIndex][columnIndex];
+                columnValues[columnIndex].insert(columnValues[columnIndex].end(),
+                                                 values.begin(), values.end());
+                // Release the memory occupied by the copied values immediately.
+                std::vector<double>().swap(values);
+            }
+        }
+    }
+    
+    // Report a failure, even with QUIET_OUTPUT verbosity.
+    if(!validFile && failedLine == 0){
+        std::cout << "Unable to read the input file:\n\n" << infileName << std::endl;
+    }
+    else if(!validFile){
+        std::cout << "Unable to parse line " << failedLine << " of the input file:\n\n"
+        << infileName << std::endl;
+    }
+    else if(inputFile.getCompression() != UNCOMPRESSED_INPUT && verbosity != QUIET_OUTPUT){
+        std::cout << "\nThe input was decompressed from "
+        << getInputCompressionName(inputFile.getCompression()) << " format." << std::endl;
+    }
+    if(verbosity != QUIET_OUTPUT){
+        std::cout << "\nRead " << getRowCount() << " rows of " << getColumnCount()
+        << " columns.\n" << std::endl;
+    }
+    return validFile;
+}
+
+/** Public method returns the number of columns.
+ *
+ * \return The number of columns, which is zero before a file is read.
+ */
+std::size_t ColumnTable::getColumnCount() const {
+    return columnValues.size();
+}
+
+/** Public method returns the number of rows.
+ *
+ * \return The number of rows, which is the number of values in every
+ * column.
+ */
+std::size_t ColumnTable::getRowCount() const {
+    return columnValues.empty() ? 0 : columnValues[0].size();
+}
+
+/** Public method returns the name of a column.
+ *
+ * \param columnIndex - The zero-based index of the column.
+ *
+ * \return A reference to the name of the column.
+ */
+const std::string & ColumnTable::getColumnName(std::size_t columnIndex) const {
+    return columnNames[columnIndex];
+}
+
+/** Public method returns the index of a column.
+ *
+ * \param columnName - The name of the column. Without a header line, the
+ * name of each column is its one-based index, for example "1".
+ *
+ * \return The zero-based index of the first column with that name, or the
+ * number of columns if there is no such column.
+ */
+std::size_t ColumnTable::findColumn(const std::string & columnName) const {
+    return std::find(columnNames.begin(), columnNames.end(), columnName) - columnNames.begin();
+}
+
+/** Public method returns the values of a column.
+ *
+ * \param columnIndex - The zero-based index of the column.
+ *
+ * \return A reference to the STL vector that stores the values of the
+ * column in the order of the rows.
+ */
+const std::vector<double> & ColumnTable::getColumn(std::size_t columnIndex) const {
+    return columnValues[columnIndex];
+}
+
+/** Public method returns a summary of the statistical properties of a
+ * column.
+ *
+ * \param columnIndex - The zero-based index of the column.
+ *
+ * \return A reference to the cached summary of the column.
+ *
+ * The summaries of every column are computed together when any of them is
+ * first requested. Each column is traversed once by the addValues() method
+ * of its own StatsAccumulator, which reads its contiguous array with the
+ * vectorized kernels of ReductionKernels.h, and the columns are divided
+ * among "threadCount" worker threads, each of which summarizes every
+ * "threadCount"-th column.
+ */
+const StatsSummary & ColumnTable::getColumnSummary(std::size_t columnIndex) const {
+    
+    // Recompute the summaries only if the cached copies are out of date.
+    if(!cachedSummariesAreValid){
+        cachedSummaries.assign(getColumnCount(), StatsSummary());
+        std::size_t workerCount = threadCount;
+        if(workerCount > getColumnCount()){
+            workerCount = getColumnCount();
+        }
+        std::vector<std::thread> workers;
+        for(std::size_t workerIndex = 0; workerIndex < workerCount; ++workerIndex){
+            workers.push_back(std::thread([&, workerIndex](){
+                for(std::size_t column = workerIndex; column < getColumnCount();
+                    column += workerCount){
+                    StatsAccumulator statistics;
+                    statistics.addValues(columnValues[column].data(), columnValues[column].size());
+                    cachedSummaries[column] = statistics.getSummary();
+                }
+            }));
+        }
+        for(std::size_t workerIndex = 0; workerIndex < workerCount; ++workerIndex){
+            workers[workerIndex].join();
+        }
+        cachedSummariesAreValid = true;
+    }
+    
+    return cachedSummaries[columnIndex];
+}
+
+/** Public method that copies a summary of the statistical properties of a
+ * column.
+ *
+ * \param columnName - The name of the column.
+ * \param summary - Set to the summary of the column, if it exists.
+ *
+ * \return true if a column with that name exists, false otherwise.
+ */
+bool ColumnTable::getColumnSummary(const std::string & columnName,
+                                   StatsSummary & summary) const {
+    std::size_t columnIndex = findColumn(columnName);
+    if(columnIndex == getColumnCount()){
+        return false;
+    }
+    summary = getColumnSummary(columnIndex);
+    return true;
+}
+
+/** Public method returns the means and co-moments of the columns.
+ *
+ * \return A reference to the cached accumulator, which is recomputed if the
+ * table has changed since it was last requested.
+ *
+ * The rows are divided into one contiguous range per worker thread. Each
+ * worker accumulates its range in blocks, as described for
+ * CovarianceAccumulator::addRows(), and the accumulators of the workers are
+ * then merged in order, so the result does not depend on the order in which
+ * the workers finish.
+ */
+const CovarianceAccumulator & ColumnTable::getCovarianceMatrices() const {
+    
+    // Recompute the accumulator only if the cached copy is out of date.
+    if(!cachedCovarianceIsValid){
+        std::vector<const double *> columns(getColumnCount());
+        for(std::size_t columnIndex = 0; columnIndex < getColumnCount(); ++columnIndex){
+            columns[columnIndex] = columnValues[columnIndex].data();
+        }
+        std::size_t rowCount = getRowCount();
+        std::size_t workerCount = threadCount;
+        if(workerCount > rowCount/minimumCovarianceRowCount){
+            workerCount = rowCount/minimumCovarianceRowCount;
+        }
+        if(workerCount == 0){
+            workerCount = 1;
+        }
+        CovarianceAccumulator emptyCovariance(getColumnCount());
+        std::vector<CovarianceAccumulator> partialCovariances(workerCount, emptyCovariance);
+        std::vector<std::thread> workers;
+        for(std::size_t workerIndex = 0; workerIndex < workerCount; ++workerIndex){
+            workers.push_back(std::thread([&, workerIndex](){
+                std::size_t firstRow = rowCount*workerIndex/workerCount;
+                std::size_t lastRow = rowCount*(workerIndex + 1)/workerCount;
+                partialCovariances[workerIndex].addRows(columns.data(), firstRow,
+                                                        lastRow - firstRow);
+            }));
+        }
+        for(std::size_t workerIndex = 0; workerIndex < workerCount; ++workerIndex){
+            workers[workerIndex].join();
+        }
+        cachedCovariance = partialCovariances[0];
+        for(std::size_t workerIndex = 1; workerIndex < workerCount; ++workerIndex){
+            cachedCovariance.merge(partialCovariances[workerIndex]);
+        }
+        cachedCovarianceIsValid = true;
+    }
+    
+    return cachedCovariance;
+}
+
+/** Public method that prints a summary of the statistical properties of
+ * every column to the terminal.
+ */
+void ColumnTable::printStats() const {
+    writeSummaries(std::cout);
+}
+
+/** Public method that writes a summary of the statistical properties of
+ * every column to a text file.
+ *
+ * \param outfileName - A string specifying the path of the text file. If
+ * the file exists it is overwritten.
+ */
+void ColumnTable::writeStats(const std::string & outfileName) const {
+    std::ofstream outputFile(outfileName.c_str());
+    if(outputFile.is_open() && outputFile.good()){
+        writeSummaries(outputFile);
+        outputFile.close();
+    }
+    if(!outputFile){
+        std::cout << "Unable to write the statistical summary to:\n\n"
+        << outfileName << std::endl;
+    }
+    else if(verbosity != QUIET_OUTPUT){
+        std::cout << "A statistical summary has been saved to:\n\n"
+        << outfileName << std::endl;
+    }
+}
@@ -0,0 +1,283 @@
+// IMPLEMENTATION file for CovarianceAccumulator class
+
+// STL HEADER FILES
+
+// The <cmath> header is included to provide the std::sqrt(...) function.
+#include <cmath>
+// The <cstdint> header is included to provide the std::uintptr_t type.
+#include <cstdint>
+// The <utility> header is included to provide the std::swap(...) function.
+#include <utility>
+
+// LOCAL HEADER FILES
+
+/* The "CovarianceAccumulator.h" header is included to provide a definition
+ * of the CovarianceAccumulator class.
+ */
+#include "CovarianceAccumulator.h"
+
+/* The "ReductionKernels.h" header is included to provide the vectorized
+ * addCrossProducts(...) function.
+ */
+#include "ReductionKernels.h"
+
+// CONSTANTS
+
+/* addRows() copies the deviations of each block of rows into a buffer of
+ * about this many bytes, which is small enough to remain in the level 2
+ * cache of most processors while addCrossProducts(...) reads every column
+ * of the block many times.
+ */
+static const std::size_t blockBufferSize = 1 << 20;
+
+/* Each block contains at least this many rows, however many columns there
+ * are. addCrossProducts(...) sums the lanes of its vector accumulators once
+ * per pair of columns per block, and updating the means and co-moments
+ * also costs one operation per pair of columns per block, so short blocks
+ * would spend much of their time on this fixed overhead.
+ */
+static const std::size_t minimumBlockRowCount = 256;
+
+/* The deviations of each column are aligned to a multiple of this number of
+ * bytes, which is the size of both a cache line and an AVX-512 vector, so
+ * that no vector load straddles two cache lines.
+ */
+static const std::size_t deviationAlignment = 64;
+
+// PUBLIC METHODS OF COVARIANCEACCUMULATOR
+
+/** Default constructor for the CovarianceAccumulator class.
+ *
+ * Creates an accumulator for no variables, which can be replaced by
+ * assigning an accumulator with the required number of variables.
+ */
+CovarianceAccumulator::CovarianceAccumulator() : columnCount(0), count(0), means(),
+                                                 coMoments() {
+    // No further initialization operations are required.
+}
+
+/** Constructor for the CovarianceAccumulator class.
+ *
+ * \param newColumnCount - The number of variables.
+ *
+ * Zero-initializes the means and the co-moments, so that the accumulator
+ * represents an empty sequence of rows.
+ */
+CovarianceAccumulator::CovarianceAccumulator(std::size_t newColumnCount) :
+    columnCount(newColumnCount), count(0), means(newColumnCount, 0.0),
+    coMoments(newColumnCount*newColumnCount, 0.0) {
+    // No further initialization operations are required.
+}
+
+/** Public method that adds a range of rows to the running statistics.
+ *
+ * \param columns - An array of "columnCount" pointers, each of which points
+ * to the first value of the array of values of one variable.
+ * \param firstRow - The index, within every array, of the first row.
+ * \param rowCount - The number of rows to be added.
+ *
+ * The rows are processed in blocks. The deviations of the values of each
+ * block from the current means (or, for the first block, from its first
+ * row) are copied column by column into a buffer, and padded with zeros to
+ * a multiple of eight rows, as addCrossProducts(...) requires. If the
+ * deviations of block b, which contains n_b rows, have sums s_i, and the
+ * sums of their products are P_ij, then after the block the running
+ * statistics of n = n_a + n_b rows are updated using
+ *
+ *     C_ij <- C_ij + P_ij - s_i*s_j/n  and  mean_i <- shift_i + s_i/n,
+ *
+ * which is the formula of merge() specialized to a shift equal to the
+ * previous mean. The products can therefore be added directly to the
+ * co-moments, and the correction applied afterwards.
+ */
+void CovarianceAccumulator::addRows(const double * const * columns, std::size_t firstRow,
+                                    std::size_t rowCount){
+    
+    // Nothing needs to be done if there are no variables or no rows.
+    if(columnCount == 0 || rowCount == 0){
+        return;
+    }
+    
+    /* Choose the number of rows per block so that the buffer fits in the
+     * cache, rounded down to a multiple of eight.
+     */
+    std::size_t blockRowCount = blockBufferSize/(sizeof(double)*columnCount);
+    blockRowCount -= blockRowCount % 8;
+    if(blockRowCount < minimumBlockRowCount){
+        blockRowCount = minimumBlockRowCount;
+    }
+    
+    /* Allocate the buffer with enough spare space to align its first
+     * value. Since every column occupies a multiple of eight values, every
+     * column is then aligned.
+     */
+    const std::size_t alignmentValueCount = deviationAlignment/sizeof(double);
+    std::vector<double> deviationBuffer(columnCount*blockRowCount + alignmentValueCount - 1);
+    double * deviations = deviationBuffer.data();
+    std::size_t misalignment = reinterpret_cast<std::uintptr_t>(deviations) % deviationAlignment;
+    if(misalignment != 0){
+        deviations += (deviationAlignment - misalignment)/sizeof(double);
+    }
+    std::vector<double> shifts(columnCount);
+    std::vector<double> deviationSums(columnCount);
+    
+    std::size_t endRow = firstRow + rowCount;
+    for(std::size_t blockBegin = firstRow; blockBegin < endRow; blockBegin += blockRowCount){
+        std::size_t blockEnd = (endRow - blockBegin > blockRowCount) ?
+                               blockBegin + blockRowCount : endRow;
+        std::size_t blockSize = blockEnd - blockBegin;
+        std::size_t paddedSize = (blockSize + 7) & ~static_cast<std::size_t>(7);
+        
+        // Copy the deviations of each column of the block into the buffer.
+        for(std::size_t column = 0; column < columnCount; ++column){
+            const double * values = columns[column] + blockBegin;
+            double * columnDeviations = deviations + column*paddedSize;
+            double shift = (count > 0) ? means[column] : values[0];
+            double sum(0.0);
+            for(std::size_t row = 0; row < blockSize; ++row){
+                double deviation = values[row] - shift;
+                columnDeviations[row] = deviation;
+                sum += deviation;
+            }
+            for(std::size_t row = blockSize; row < paddedSize; ++row){
+                columnDeviations[row] = 0.0;
+            }
+            deviationSums[column] = sum;
+            shifts[column] = shift;
+        }
+        
+        // Accumulate the sums of the products of the deviations.
+        addCrossProducts(deviations, columnCount, paddedSize, paddedSize,
+                         coMoments.data());
+        
+        // Correct the co-moments and update the means.
+        count += blockSize;
+        double inverseCount = 1.0/static_cast<double>(count);
+        for(std::size_t first = 0; first < columnCount; ++first){
+            double scaledSum = deviationSums[first]*inverseCount;
+            double * coMomentRow = coMoments.data() + first*columnCount;
+            for(std::size_t second = first; second < columnCount; ++second){
+                coMomentRow[second] -= scaledSum*deviationSums[second];
+            }
+            means[first] = shifts[first] + scaledSum;
+        }
+    }
+}
+
+/** Public method that adds the running statistics of another accumulator to
+ * those of this accumulator.
+ *
+ * \param other - The accumulator whose statistics are added.
+ *
+ * \return true on success, or false if the accumulators have different
+ * numbers of variables, in which case this accumulator is not modified.
+ *
+ * The pairwise update formulae of Chan, Golub and LeVeque, which are also
+ * used by StatsAccumulator::merge(), extend to the co-moments as
+ *
+ *     C_ij = C_ij^a + C_ij^b + delta_i*delta_j*n_a*n_b/n,
+ *
+ * where delta is the difference between the means of the two sets of rows.
+ */
+bool CovarianceAccumulator::merge(const CovarianceAccumulator & other){
+    
+    if(other.columnCount != columnCount){
+        return false;
+    }
+    
+    // Nothing needs to be done if the other sequence is empty.
+    if(other.count == 0){
+        return true;
+    }
+    
+    // If this accumulator is empty, simply adopt the other statistics.
+    if(count == 0){
+        *this = other;
+        return true;
+    }
+    
+    double thisWeight = static_cast<double>(count);
+    double otherWeight = static_cast<double>(other.count);
+    double combinedWeight = thisWeight + otherWeight;
+    double weightFactor = thisWeight*otherWeight/combinedWeight;
+    for(std::size_t first = 0; first < columnCount; ++first){
+        double firstDelta = other.means[first] - means[first];
+        double scaledDelta = firstDelta*weightFactor;
+        std::size_t rowOffset = first*columnCount;
+        for(std::size_t second = first; second < columnCount; ++second){
+            double secondDelta = other.means[second] - means[second];
+            coMoments[rowOffset + second] += other.coMoments[rowOffset + second] +
+                                             scaledDelta*secondDelta;
+        }
+    }
+    
+    /* The means are updated only after every co-moment, since the
+     * co-moments use the previous means.
+     */
+    for(std::size_t column = 0; column < columnCount; ++column){
+        means[column] += (other.means[column] - means[column])*otherWeight/combinedWeight;
+    }
+    count += other.count;
+    return true;
+}
+
+/** Public method returns the number of variables.
+ */
+std::size_t CovarianceAccumulator::getColumnCount() const {
+    return columnCount;
+}
+
+/** Public method returns the number of rows that have been accumulated.
+ */
+std::size_t CovarianceAccumulator::getCount() const {
+    return count;
+}
+
+/** Public method returns the mean of a variable.
+ *
+ * \param columnIndex - The zero-based index of the variable.
+ *
+ * \return The mean, or zero if no rows have been accumulated.
+ */
+double CovarianceAccumulator::getMean(std::size_t columnIndex) const {
+    return means[columnIndex];
+}
+
+/** Public method returns the covariance of two variables.
+ *
+ * \param firstIndex - The zero-based index of one variable.
+ * \param secondIndex - The zero-based index of the other variable.
+ *
+ * \return The co-moment divided by the number of rows, which is NaN if no
+ * rows have been accumulated.
+ */
+double CovarianceAccumulator::getCovariance(std::size_t firstIndex,
+                                            std::size_t secondIndex) const {
+    
+    // Only the elements on and above the diagonal are maintained.
+    if(firstIndex > secondIndex){
+        std::swap(firstIndex, secondIndex);
+    }
+    return coMoments[firstIndex*columnCount + secondIndex]/static_cast<double>(count);
+}
+
+/** Public method returns the Pearson correlation coefficient of two
+ * variables.
+ *
+ * \param firstIndex - The zero-based index of one variable.
+ * \param secondIndex - The zero-based index of the other variable.
+ *
+ * \return The co-moment of the variables divided by the square root of the
+ * product of their own co-moments. The number of rows cancels, so it is not
+ * needed.
+ */
+double CovarianceAccumulator::getCorrelation(std::size_t firstIndex,
+                                             std::size_t secondIndex) const {
+    if(firstIndex > secondIndex){
+        std::swap(firstIndex, secondIndex);
+    }
+    double firstCoMoment = coMoments[firstIndex*columnCount + firstIndex];
+    double secondCoMoment = coMoments[secondIndex*columnCount + secondIndex];
+    return coMoments[firstIndex*columnCount + secondIndex]/
+           std::sqrt(firstCoMoment*secondCoMoment);
+}
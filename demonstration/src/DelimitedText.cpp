@@ -0,0 +1,318 @@
+// IMPLEMENTATION file for the MappedTextFile class and the delimited text functions
+
+// STL HEADER FILES
+
+// The <iostream> header is included to enable textual terminal output.
+#include <iostream>
+
+// POSIX HEADER FILES
+
+// The <fcntl.h> header is included to provide the open(...) function.
+#include <fcntl.h>
+// The <sys/mman.h> header is included to provide the mmap(...) function.
+#include <sys/mman.h>
+// The <sys/stat.h> header is included to provide the fstat(...) function.
+#include <sys/stat.h>
+// The <unistd.h> header is included to provide the pread(...) and close(...) functions.
+#include <unistd.h>
+
+// LOCAL HEADER FILES
+
+/* The "DelimitedText.h" header is included to provide a definition of the
+ * MappedTextFile class and declarations of the functions that are defined
+ * in this file.
+ */
+#include "DelimitedText.h"
+
+// CONSTANTS
+
+/* Each worker thread should receive at least this many characters. For
+ * smaller ranges the cost of starting a thread exceeds the time saved by
+ * parsing in parallel.
+ */
+static const std::size_t minimumRangeSize = 1 << 20;
+
+/* The buffer into which a compressed file is decompressed is enlarged by at
+ * least this many characters whenever it becomes full.
+ */
+static const std::size_t decompressedGrowthSize = 1 << 24;
+
+// PUBLIC FUNCTIONS
+
+/** Function that divides a line into fields.
+ *
+ * \param lineBegin - A pointer to the first character of the line.
+ * \param lineEnd - A pointer one past the last character of the line.
+ * \param separator - ',' if the fields are separated by commas, or ' ' if
+ * they are separated by whitespace.
+ *
+ * \return The fields, without any surrounding whitespace or double quotes.
+ */
+std::vector<std::string> splitFields(const char * lineBegin, const char * lineEnd,
+                                     char separator){
+    std::vector<std::string> fields;
+    const char * position = lineBegin;
+    while(true){
+        
+        // Skip the whitespace that precedes the field.
+        while(position != lineEnd && isBlank(*position)){
+            ++position;
+        }
+        if(separator == ' ' && position == lineEnd){
+            break;
+        }
+        
+        // Find the end of the field and of its trailing whitespace.
+        const char * fieldBegin = position;
+        while(position != lineEnd && *position != separator &&
+              !(separator == ' ' && isBlank(*position))){
+            ++position;
+        }
+        const char * fieldEnd = position;
+        while(fieldEnd != fieldBegin && isBlank(*(fieldEnd - 1))){
+            --fieldEnd;
+        }
+        
+        // Remove any double quotes that enclose the field.
+        if(fieldEnd - fieldBegin >= 2 && *fieldBegin == '"' && *(fieldEnd - 1) == '"'){
+            ++fieldBegin;
+            --fieldEnd;
+        }
+        fields.push_back(std::string(fieldBegin, fieldEnd));
+        
+        // A comma-separated line ends after the field that no comma follows.
+        if(separator == ',' && position == lineEnd){
+            break;
+        }
+        if(separator == ','){
+            ++position;
+        }
+    }
+    return fields;
+}
+
+/** Function that returns a pointer to the first line of a buffer that holds
+ * data.
+ *
+ * \param bufferBegin - A pointer to the first character of the buffer.
+ * \param bufferEnd - A pointer one past the last character of the buffer.
+ *
+ * \return A pointer to the first character of the first line whose first
+ * character other than whitespace exists and is not '#', or "bufferEnd" if
+ * there is no such line.
+ */
+const char * findFirstDataLine(const char * bufferBegin, const char * bufferEnd){
+    const char * lineBegin = bufferBegin;
+    while(lineBegin != bufferEnd){
+        const char * lineEnd = findLineEnd(lineBegin, bufferEnd);
+        const char * position = lineBegin;
+        while(position != lineEnd && isBlank(*position)){
+            ++position;
+        }
+        if(position != lineEnd && *position != '#'){
+            break;
+        }
+        lineBegin = (lineEnd == bufferEnd) ? bufferEnd : lineEnd + 1;
+    }
+    return lineBegin;
+}
+
+/** Function that divides a range of lines into line-aligned subranges.
+ *
+ * \param dataBegin - A pointer to the first character of the first line.
+ * \param dataEnd - A pointer one past the last character of the last line.
+ * \param threadCount - The number of worker threads available.
+ *
+ * \return The first character of each subrange, followed by "dataEnd".
+ *
+ * The number of subranges is "threadCount", reduced so that each contains
+ * at least "minimumRangeSize" characters, but is at least one. The range is
+ * first divided into subranges of equal size, and each nominal boundary
+ * except the first is then advanced to the start of the next line, so
+ * that no line is divided between two subranges. A boundary that would
+ * precede the previous one, because a line spans a whole subrange, is moved
+ * to it, leaving that subrange empty.
+ */
+std::vector<const char *> divideIntoLineRanges(const char * dataBegin, const char * dataEnd,
+                                               unsigned int threadCount){
+    
+    // Determine the number of ranges into which the lines are divided.
+    std::size_t dataSize = dataEnd - dataBegin;
+    std::size_t rangeCount = threadCount;
+    if(rangeCount > dataSize/minimumRangeSize){
+        rangeCount = dataSize/minimumRangeSize;
+    }
+    if(rangeCount < 1){
+        rangeCount = 1;
+    }
+    
+    /* Compute the first character of each range, advancing each nominal
+     * boundary to the start of the next line.
+     */
+    std::vector<const char *> rangeBegins(rangeCount + 1, dataEnd);
+    rangeBegins[0] = dataBegin;
+    for(std::size_t rangeIndex = 1; rangeIndex < rangeCount; ++rangeIndex){
+        const char * boundary = dataBegin + rangeIndex*(dataSize/rangeCount);
+        if(boundary < rangeBegins[rangeIndex - 1]){
+            boundary = rangeBegins[rangeIndex - 1];
+        }
+        if(boundary != dataBegin && *(boundary - 1) != '\n'){
+            boundary = findLineEnd(boundary, dataEnd);
+            if(boundary != dataEnd){
+                ++boundary;
+            }
+        }
+        rangeBegins[rangeIndex] = boundary;
+    }
+    return rangeBegins;
+}
+
+// PRIVATE METHODS OF MAPPEDTEXTFILE
+
+/** Private method that decompresses the whole of a compressed file.
+ *
+ * \param fileDescriptor - A file descriptor open for reading at the start
+ * of the file.
+ *
+ * \return true if the whole file was decompressed into "decompressedText",
+ * false if its format is not supported by this build of the program, or it
+ * is damaged or incomplete.
+ *
+ * The buffer is doubled in size, by at least "decompressedGrowthSize"
+ * characters, whenever it becomes full, so that each character is copied
+ * only a small number of times on average however large the file is.
+ */
+bool MappedTextFile::decompress(int fileDescriptor){
+    InputDecompressor decompressor;
+    if(!decompressor.start(compression, fileDescriptor, 0, 0)){
+        return false;
+    }
+    std::size_t decompressedSize(0);
+    while(true){
+        if(decompressedText.size() - decompressedSize < decompressedGrowthSize){
+            decompressedText.resize(decompressedText.size() + decompressedGrowthSize +
+                                    decompressedText.size());
+        }
+        std::ptrdiff_t readSize = decompressor.read(decompressedText.data() + decompressedSize,
+                                                    decompressedText.size() - decompressedSize);
+        if(readSize < 0){
+            std::vector<char>().swap(decompressedText);
+            return false;
+        }
+        if(readSize == 0){
+            break;
+        }
+        decompressedSize += readSize;
+    }
+    decompressedText.resize(decompressedSize);
+    decompressedText.shrink_to_fit();
+    return true;
+}
+
+// PUBLIC METHODS OF MAPPEDTEXTFILE
+
+/** Constructor for the MappedTextFile class.
+ *
+ * \param fileName - A string specifying the path of the file.
+ *
+ * The file is opened, its size is established using fstat(), and it is
+ * mapped read-only. The kernel is advised that the mapping will be read
+ * sequentially, so that it reads ahead aggressively. The file descriptor
+ * is closed immediately, since the mapping remains valid without it.
+ *
+ * The leading bytes of the file are first examined, without moving the
+ * position of the file descriptor, and a compressed file is decompressed
+ * instead of being mapped. If it cannot be decompressed, the reason is
+ * printed in the same words as by StatsCalculator::readFile().
+ */
+MappedTextFile::MappedTextFile(const std::string & fileName) : fileBegin(0), fileSize(0),
+                                                               readable(false), mapped(false),
+                                                               compression(UNCOMPRESSED_INPUT),
+                                                               decompressedText() {
+    int fileDescriptor = open(fileName.c_str(), O_RDONLY);
+    struct stat fileStatus;
+    char leadingBytes[compressionMagicSize];
+    ssize_t leadingByteCount = (fileDescriptor >= 0) ?
+        pread(fileDescriptor, leadingBytes, compressionMagicSize, 0) : -1;
+    if(leadingByteCount > 0){
+        compression = detectInputCompression(leadingBytes, leadingByteCount);
+    }
+    if(compression != UNCOMPRESSED_INPUT){
+        readable = decompress(fileDescriptor);
+        fileBegin = decompressedText.data();
+        fileSize = decompressedText.size();
+        if(!readable && !isInputCompressionSupported(compression)){
+            std::cout << "Unable to decompress the " << getInputCompressionName(compression)
+            << " compressed input, since this program was compiled without support for it."
+            << std::endl;
+        }
+        else if(!readable){
+            std::cout << "Unable to decompress the whole of the "
+            << getInputCompressionName(compression)
+            << " compressed input, which is damaged or incomplete." << std::endl;
+        }
+    }
+    else if(fileDescriptor >= 0 && fstat(fileDescriptor, &fileStatus) == 0){
+        fileSize = static_cast<std::size_t>(fileStatus.st_size);
+        void * mappedFile = (fileSize > 0) ?
+            mmap(0, fileSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0) : MAP_FAILED;
+        readable = (fileSize == 0);
+        if(mappedFile != MAP_FAILED){
+            madvise(mappedFile, fileSize, MADV_SEQUENTIAL);
+            fileBegin = static_cast<const char *>(mappedFile);
+            readable = true;
+            mapped = true;
+        }
+        else{
+            fileSize = 0;
+        }
+    }
+    if(fileDescriptor >= 0){
+        close(fileDescriptor);
+    }
+}
+
+/** Destructor for the MappedTextFile class.
+ *
+ * Releases the mapping of the file, if it was mapped.
+ */
+MappedTextFile::~MappedTextFile(){
+    if(mapped){
+        munmap(const_cast<char *>(fileBegin), fileSize);
+    }
+}
+
+/** Public method returns true if the file is readable.
+ *
+ * \return true if the file was opened and mapped or decompressed, or is
+ * empty, otherwise false.
+ */
+bool MappedTextFile::isReadable() const {
+    return readable;
+}
+
+/** Public method returns the format in which the file is compressed.
+ *
+ * \return The format identified from the leading bytes of the file, or
+ * UNCOMPRESSED_INPUT if it is not compressed or could not be opened.
+ */
+InputCompression MappedTextFile::getCompression() const {
+    return compression;
+}
+
+/** Public method returns a pointer to the first character of the file.
+ *
+ * \return A pointer to the first character, which equals end() if the
+ * file is empty or could not be read.
+ */
+const char * MappedTextFile::begin() const {
+    return fileBegin;
+}
+
+/** Public method returns a pointer one past the last character of the file.
+ *
+ * \return A pointer one past the last character.
+ */
+const char * MappedTextFile::end() const {
+    return fileBegin + fileSize;
+}
@@ -0,0 +1,305 @@
+// IMPLEMENTATION file for GroupHashTable class
+
+// STL HEADER FILES
+
+// The <cstring> header is included to provide the std::memcpy(...) function.
+#include <cstring>
+
+// LOCAL HEADER FILES
+
+/* The "GroupHashTable.h" header is included to provide a definition of the
+ * GroupHashTable class.
+ */
+#include "GroupHashTable.h"
+
+// CONSTANTS
+
+/* The number of slots in a table when the first group is inserted. The
+ * number of slots is always a power of two, so that the slot of a hash is
+ * found by masking rather than by division.
+ */
+static const std::size_t initialSlotCount = 16;
+
+/* addValues() processes values in batches of this many. Larger batches
+ * allow more memory accesses to overlap, up to the number of outstanding
+ * cache misses that the processor can track.
+ */
+static const std::size_t lookupBatchSize = 16;
+
+/* Definition of the static constant member that holds the longest key that
+ * is copied into a slot, whose value is specified in the class definition.
+ */
+const std::size_t GroupHashTable::inlineKeyLength;
+
+// PRIVATE METHODS OF GROUPHASHTABLE
+
+/** Private method that doubles the number of slots.
+ *
+ * Every occupied slot is moved to the enlarged table using the hash that
+ * it holds, so no key is hashed again. The groups themselves do not move,
+ * so their indices are unchanged.
+ */
+void GroupHashTable::grow(){
+    std::size_t slotCount = slots.empty() ? initialSlotCount : 2*slots.size();
+    std::size_t slotMask = slotCount - 1;
+    std::vector<Slot> previousSlots(slotCount, Slot());
+    previousSlots.swap(slots);
+    for(std::size_t previousIndex = 0; previousIndex < previousSlots.size(); ++previousIndex){
+        const Slot & slot = previousSlots[previousIndex];
+        if(slot.groupNumber == 0){
+            continue;
+        }
+        std::size_t slotIndex = slot.hash & slotMask;
+        while(slots[slotIndex].groupNumber != 0){
+            slotIndex = (slotIndex + 1) & slotMask;
+        }
+        slots[slotIndex] = slot;
+    }
+}
+
+/** Private method that determines whether a slot is occupied by the group
+ * with a key.
+ *
+ * \param slot - The slot.
+ * \param key - The key.
+ * \param hash - The hash of the key.
+ *
+ * \return true if the slot holds a group whose key is equal to "key".
+ *
+ * Most unequal keys are rejected by their hashes or lengths. A key that is
+ * short enough to be held by the slot is compared with its copy there, and
+ * only a longer key is compared with the characters stored by the table.
+ */
+bool GroupHashTable::matchesSlot(const Slot & slot, std::string_view key,
+                                 std::uint64_t hash) const {
+    if(slot.hash != hash || slot.keyLength != key.size()){
+        return false;
+    }
+    if(key.size() <= inlineKeyLength){
+        return std::memcmp(slot.keyPrefix, key.data(), key.size()) == 0;
+    }
+    return getKey(slot.groupNumber - 1) == key;
+}
+
+/** Private method that returns the index of the group with a key, inserting
+ * a new group if there is none.
+ *
+ * \param key - The key, which must not refer to characters stored by this
+ * table.
+ * \param hash - The hash of the key, as returned by hashKey().
+ *
+ * \return The index of the group.
+ *
+ * The slots are examined in turn, starting from the one selected by the
+ * lower bits of the hash, until either a slot that holds the group with the
+ * same key or an empty slot is found. The table is enlarged whenever it
+ * would become more than half full, so that the expected number of slots
+ * examined remains small.
+ */
+std::size_t GroupHashTable::findOrInsert(std::string_view key, std::uint64_t hash){
+    if(2*(accumulators.size() + 1) > slots.size()){
+        grow();
+    }
+    std::size_t slotMask = slots.size() - 1;
+    std::size_t slotIndex = hash & slotMask;
+    while(true){
+        Slot & slot = slots[slotIndex];
+        
+        // An empty slot ends the search, so insert a new group.
+        if(slot.groupNumber == 0){
+            std::size_t groupIndex = accumulators.size();
+            slot.hash = hash;
+            slot.groupNumber = static_cast<std::uint32_t>(groupIndex + 1);
+            slot.keyLength = static_cast<std::uint32_t>(key.size());
+            std::memcpy(slot.keyPrefix, key.data(),
+                        (key.size() < inlineKeyLength) ? key.size() : inlineKeyLength);
+            keyCharacters.insert(keyCharacters.end(), key.begin(), key.end());
+            keyOffsets.push_back(keyCharacters.size());
+            accumulators.push_back(StatsAccumulator());
+            return groupIndex;
+        }
+        
+        if(matchesSlot(slot, key, hash)){
+            return slot.groupNumber - 1;
+        }
+        slotIndex = (slotIndex + 1) & slotMask;
+    }
+}
+
+// PUBLIC METHODS OF GROUPHASHTABLE
+
+/** Default constructor for the GroupHashTable class.
+ *
+ * Creates a table with no groups and no slots. The slots are allocated when
+ * the first group is inserted.
+ */
+GroupHashTable::GroupHashTable() : slots(), keyOffsets(1, 0), keyCharacters(),
+                                   accumulators() {
+    // No further initialization operations are required.
+}
+
+/** Public static method that returns the hash of a key.
+ *
+ * \param key - The key.
+ *
+ * \return A 64-bit hash, every bit of which depends on every character of
+ * the key.
+ *
+ * The characters are combined eight at a time, by multiplying each group
+ * of eight, interpreted as an integer, into the running hash. The result
+ * is then mixed by the finalization step of the MurmurHash3 algorithm, so
+ * that the lower bits, which select a slot, are well distributed.
+ */
+std::uint64_t GroupHashTable::hashKey(std::string_view key){
+    const std::uint64_t multiplier = 0x9E3779B97F4A7C15ULL;
+    std::uint64_t hash = key.size()*multiplier;
+    const char * characters = key.data();
+    std::size_t remaining = key.size();
+    while(remaining >= 8){
+        std::uint64_t word;
+        std::memcpy(&word, characters, 8);
+        hash = (hash ^ word)*multiplier;
+        hash ^= hash >> 32;
+        characters += 8;
+        remaining -= 8;
+    }
+    if(remaining > 0){
+        std::uint64_t word(0);
+        std::memcpy(&word, characters, remaining);
+        hash = (hash ^ word)*multiplier;
+        hash ^= hash >> 32;
+    }
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDULL;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+/** Public method returns the accumulator of the group with a key.
+ *
+ * \param key - The key, which must not refer to characters stored by this
+ * table.
+ *
+ * \return A reference to the accumulator, which is empty if the group has
+ * just been inserted.
+ */
+StatsAccumulator & GroupHashTable::getAccumulator(std::string_view key){
+    return accumulators[findOrInsert(key, hashKey(key))];
+}
+
+/** Public method that adds an array of values to the accumulators of the
+ * groups with the corresponding keys.
+ *
+ * \param keys - A pointer to the first element of an array of keys.
+ * \param values - A pointer to the first element of an array of values.
+ * \param valueCount - The number of elements in each array.
+ *
+ * Each batch of values is processed in three passes. The first hashes
+ * every key and prefetches the slot at which its search begins. The second
+ * finds the group of every key, whose slot is by then usually in the cache,
+ * and prefetches its accumulator. The third adds every value to its
+ * accumulator. The GCC built-in function __builtin_prefetch only requests
+ * that a cache line be loaded, and has no other effect, so the groups are
+ * the same as if every value were added by getAccumulator().
+ */
+void GroupHashTable::addValues(const std::string_view * keys, const double * values,
+                               std::size_t valueCount){
+    std::uint64_t hashes[lookupBatchSize];
+    std::size_t groupIndices[lookupBatchSize];
+    for(std::size_t batchBegin = 0; batchBegin < valueCount; batchBegin += lookupBatchSize){
+        std::size_t batchSize = (valueCount - batchBegin < lookupBatchSize) ?
+                                valueCount - batchBegin : lookupBatchSize;
+        
+        // Ensure that the batch cannot enlarge the table after prefetching.
+        while(2*(accumulators.size() + batchSize) > slots.size()){
+            grow();
+        }
+        std::size_t slotMask = slots.size() - 1;
+        for(std::size_t batchIndex = 0; batchIndex < batchSize; ++batchIndex){
+            hashes[batchIndex] = hashKey(keys[batchBegin + batchIndex]);
+            __builtin_prefetch(&slots[hashes[batchIndex] & slotMask]);
+        }
+        for(std::size_t batchIndex = 0; batchIndex < batchSize; ++batchIndex){
+            groupIndices[batchIndex] = findOrInsert(keys[batchBegin + batchIndex],
+                                                    hashes[batchIndex]);
+            __builtin_prefetch(&accumulators[groupIndices[batchIndex]], 1);
+        }
+        for(std::size_t batchIndex = 0; batchIndex < batchSize; ++batchIndex){
+            accumulators[groupIndices[batchIndex]].addValue(values[batchBegin + batchIndex]);
+        }
+    }
+}
+
+/** Public method returns the index of the group with a key.
+ *
+ * \param key - The key.
+ *
+ * \return The index of the group, or the number of groups if no group has
+ * that key.
+ *
+ * The slots are examined in the same order as by findOrInsert(), but an
+ * empty slot ends the search without inserting a group.
+ */
+std::size_t GroupHashTable::findGroup(std::string_view key) const {
+    if(slots.empty()){
+        return getGroupCount();
+    }
+    std::uint64_t hash = hashKey(key);
+    std::size_t slotMask = slots.size() - 1;
+    std::size_t slotIndex = hash & slotMask;
+    while(slots[slotIndex].groupNumber != 0){
+        if(matchesSlot(slots[slotIndex], key, hash)){
+            return slots[slotIndex].groupNumber - 1;
+        }
+        slotIndex = (slotIndex + 1) & slotMask;
+    }
+    return getGroupCount();
+}
+
+/** Public method that adds the running statistics of every group of another
+ * table to those of this table.
+ *
+ * \param other - The table whose groups are added, which must not be this
+ * table.
+ *
+ * Since the groups of the other table are visited in order, groups that
+ * are new to this table are appended in their original order.
+ */
+void GroupHashTable::merge(const GroupHashTable & other){
+    for(std::size_t groupIndex = 0; groupIndex < other.getGroupCount(); ++groupIndex){
+        std::string_view key = other.getKey(groupIndex);
+        std::size_t thisIndex = findOrInsert(key, hashKey(key));
+        accumulators[thisIndex].merge(other.accumulators[groupIndex]);
+    }
+}
+
+/** Public method returns the number of groups.
+ */
+std::size_t GroupHashTable::getGroupCount() const {
+    return accumulators.size();
+}
+
+/** Public method returns the key of a group.
+ *
+ * \param groupIndex - The index of the group, from zero for the group that
+ * was inserted first.
+ *
+ * \return A view of the characters of the key, which is invalidated when
+ * another group is inserted.
+ */
+std::string_view GroupHashTable::getKey(std::size_t groupIndex) const {
+    return std::string_view(keyCharacters.data() + keyOffsets[groupIndex],
+                            keyOffsets[groupIndex + 1] - keyOffsets[groupIndex]);
+}
+
+/** Public method returns the accumulator of a group.
+ *
+ * \param groupIndex - The index of the group.
+ *
+ * \return A reference to the accumulator.
+ */
+const StatsAccumulator & GroupHashTable::getGroupAccumulator(std::size_t groupIndex) const {
+    return accumulators[groupIndex];
+}
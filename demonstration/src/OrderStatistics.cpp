@@ -0,0 +1,477 @@
+// IMPLEMENTATION file for the order statistics functions
+
+// STL HEADER FILES
+
+/* The <algorithm> header is included to provide the std::nth_element(...),
+ * std::sort(...), std::unique(...) and std::inplace_merge(...) functions.
+ */
+#include <algorithm>
+/* The <cmath> header is included to provide the std::pow(...),
+ * std::sqrt(...) and std::floor(...) functions.
+ */
+#include <cmath>
+// The <functional> header is included to provide the std::function type.
+#include <functional>
+// The <limits> header is included to provide the std::numeric_limits type.
+#include <limits>
+/* The <random> header is included to provide the std::mt19937_64 and
+ * std::uniform_int_distribution types.
+ */
+#include <random>
+// The <thread> header is included to provide the std::thread class.
+#include <thread>
+
+// LOCAL HEADER FILES
+
+/* The "OrderStatistics.h" header is included to provide declarations of the
+ * order statistics functions.
+ */
+#include "OrderStatistics.h"
+
+// CONSTANTS
+
+/* Arrays with fewer elements than this are searched by partitioning a copy
+ * of the whole array, since sampling would save little time.
+ */
+static const std::size_t minimumSampledCount = 1 << 16;
+
+/* Each worker thread should receive at least this many elements. For
+ * smaller parts the cost of starting a thread exceeds the time saved.
+ */
+static const std::size_t minimumPartSize = 1 << 20;
+
+// HELPER FUNCTIONS
+
+/** Helper function that determines the number of parts into which an array
+ * is divided among worker threads.
+ *
+ * \param count - The number of elements in the array.
+ * \param threadCount - The maximum number of worker threads.
+ *
+ * \return The number of parts, which is at least one.
+ */
+static std::size_t countParts(std::size_t count, unsigned int threadCount){
+    std::size_t partCount = threadCount;
+    if(partCount > count/minimumPartSize){
+        partCount = count/minimumPartSize;
+    }
+    return (partCount > 0) ? partCount : 1;
+}
+
+/** Helper function that performs several independent tasks concurrently,
+ * one per worker thread, and waits for all of them to finish.
+ *
+ * \param taskCount - The number of tasks.
+ * \param task - A function that performs the task whose index it is passed.
+ *
+ * A single task is performed on the calling thread.
+ */
+static void runTasks(std::size_t taskCount, const std::function<void(std::size_t)> & task){
+    if(taskCount == 1){
+        task(0);
+        return;
+    }
+    std::vector<std::thread> workers;
+    for(std::size_t taskIndex = 0; taskIndex < taskCount; ++taskIndex){
+        workers.push_back(std::thread(task, taskIndex));
+    }
+    for(std::size_t taskIndex = 0; taskIndex < taskCount; ++taskIndex){
+        workers[taskIndex].join();
+    }
+}
+
+/** Helper function that partially reorders an array so that the element at
+ * each of several ranks is the one that would be there if the array were
+ * sorted.
+ *
+ * \param values - A pointer to the first element of the array.
+ * \param first - The index of the first element of the part of the array
+ * that contains the ranks.
+ * \param last - The index one past the last element of that part.
+ * \param ranksBegin - A pointer to the first of the ranks, which must be
+ * distinct, in ascending order, and lie between "first" and "last".
+ * \param ranksEnd - A pointer one past the last of the ranks.
+ *
+ * The middle rank is found by std::nth_element(...), which partitions the
+ * part of the array about it. The lower and higher ranks then lie in the
+ * lower and upper partitions, which are searched recursively. The cost is
+ * therefore proportional to N log(K) for N elements and K ranks, rather
+ * than N K for K separate selections or N log(N) for a sort.
+ */
+template<typename Element>
+static void multiSelect(Element * values, std::size_t first, std::size_t last,
+                        const std::size_t * ranksBegin, const std::size_t * ranksEnd){
+    if(ranksBegin == ranksEnd){
+        return;
+    }
+    const std::size_t * middleRank = ranksBegin + (ranksEnd - ranksBegin)/2;
+    std::nth_element(values + first, values + *middleRank, values + last);
+    multiSelect(values, first, *middleRank, ranksBegin, middleRank);
+    multiSelect(values, *middleRank + 1, last, middleRank + 1, ranksEnd);
+}
+
+/** Helper function that finds several order statistics of an array by
+ * partitioning a copy of the whole array.
+ *
+ * \param values - A pointer to the first element of the array.
+ * \param count - The number of elements in the array.
+ * \param sortedRanks - The ranks of the required order statistics, which
+ * must be distinct and in ascending order.
+ * \param selected - A vector that receives the order statistics, in the
+ * same order as "sortedRanks".
+ */
+template<typename Element>
+static void selectFromCopy(const Element * values, std::size_t count,
+                           const std::vector<std::size_t> & sortedRanks,
+                           std::vector<double> & selected){
+    std::vector<Element> copy(values, values + count);
+    multiSelect(copy.data(), 0, count, sortedRanks.data(),
+                sortedRanks.data() + sortedRanks.size());
+    for(std::size_t rankIndex = 0; rankIndex < sortedRanks.size(); ++rankIndex){
+        selected[rankIndex] = static_cast<double>(copy[sortedRanks[rankIndex]]);
+    }
+}
+
+/** Helper function that finds several order statistics of an array by
+ * partitioning only those elements that lie close to them.
+ *
+ * \param values - A pointer to the first element of the array.
+ * \param count - The number of elements in the array.
+ * \param sortedRanks - The ranks of the required order statistics, which
+ * must be distinct and in ascending order.
+ * \param threadCount - The number of worker threads.
+ * \param selected - A vector that receives the order statistics, in the
+ * same order as "sortedRanks".
+ *
+ * \return true on success, or false if a required order statistic did not
+ * lie between the bounds estimated from the sample, in which case the
+ * contents of "selected" are unspecified.
+ *
+ * This is a parallel form of the algorithm of Floyd and Rivest. A random
+ * sample of \f$ S = N^{2/3} \f$ elements is sorted, and for each rank R the
+ * elements of the sample at positions \f$ RS/N \pm 3\sqrt{S} \f$ are chosen
+ * as lower and upper bounds, which contain the required order statistic
+ * unless the sample is extraordinarily unrepresentative. Overlapping
+ * intervals between the bounds are combined.
+ *
+ * Each worker thread then classifies its own part of the array in a single
+ * pass, counting the elements that lie between the intervals and copying
+ * those that lie within them. Finally, the copied elements of each interval
+ * are partitioned by multiSelect() to find the ranks within the interval.
+ * Only about \f$ 6N/\sqrt{S} \f$ elements per interval are copied, which is
+ * less than 1% of the array for \f$ N = 10^{8} \f$.
+ */
+template<typename Element>
+static bool selectFromSample(const Element * values, std::size_t count,
+                             const std::vector<std::size_t> & sortedRanks,
+                             unsigned int threadCount, std::vector<double> & selected){
+    
+    /* Draw a random sample of the array, and sort it. The generator is
+     * seeded with a constant, so the time taken is reproducible.
+     */
+    std::size_t sampleSize = static_cast<std::size_t>(std::pow(static_cast<double>(count),
+                                                               2.0/3.0));
+    std::vector<Element> sample(sampleSize);
+    std::mt19937_64 generator(5489u);
+    std::uniform_int_distribution<std::size_t> position(0, count - 1);
+    for(std::size_t sampleIndex = 0; sampleIndex < sampleSize; ++sampleIndex){
+        sample[sampleIndex] = values[position(generator)];
+    }
+    std::sort(sample.begin(), sample.end());
+    
+    /* Bound each rank, combining overlapping intervals, and record the
+     * interval that contains each rank. Ranks beyond either end of the
+     * sample are bounded by infinity.
+     */
+    std::size_t margin = static_cast<std::size_t>(3.0*std::sqrt(static_cast<double>(sampleSize))) + 1;
+    std::vector<double> lowerBounds;
+    std::vector<double> upperBounds;
+    std::vector<std::size_t> rankIntervals(sortedRanks.size());
+    for(std::size_t rankIndex = 0; rankIndex < sortedRanks.size(); ++rankIndex){
+        std::size_t samplePosition = static_cast<std::size_t>(
+            static_cast<double>(sortedRanks[rankIndex])*sampleSize/count);
+        double lowerBound = (samplePosition >= margin) ?
+            static_cast<double>(sample[samplePosition - margin]) :
+            -std::numeric_limits<double>::infinity();
+        double upperBound = (samplePosition + margin < sampleSize) ?
+            static_cast<double>(sample[samplePosition + margin]) :
+            std::numeric_limits<double>::infinity();
+        if(!upperBounds.empty() && lowerBound <= upperBounds.back()){
+            upperBounds.back() = std::max(upperBounds.back(), upperBound);
+        }
+        else{
+            lowerBounds.push_back(lowerBound);
+            upperBounds.push_back(upperBound);
+        }
+        rankIntervals[rankIndex] = lowerBounds.size() - 1;
+    }
+    std::size_t intervalCount = lowerBounds.size();
+    
+    /* Declare, for each part of the array, the number of its elements in
+     * each of the gaps below, between and above the intervals, and the
+     * elements that it contributes to each interval. Each worker thread
+     * writes only to its own elements.
+     */
+    std::size_t partCount = countParts(count, threadCount);
+    std::vector<std::vector<std::size_t> > partGapCounts(partCount,
+        std::vector<std::size_t>(intervalCount + 1, 0));
+    std::vector<std::vector<std::vector<Element> > > partCandidates(partCount,
+        std::vector<std::vector<Element> >(intervalCount));
+    
+    // Classify every element of every part in a single pass.
+    runTasks(partCount, [&](std::size_t partIndex){
+        const Element * partBegin = values + partIndex*(count/partCount);
+        const Element * partEnd = (partIndex + 1 == partCount) ?
+            values + count : partBegin + count/partCount;
+        std::vector<std::size_t> & gapCounts = partGapCounts[partIndex];
+        std::vector<std::vector<Element> > & candidates = partCandidates[partIndex];
+        for(const Element * element = partBegin; element != partEnd; ++element){
+            double value = static_cast<double>(*element);
+            
+            // Find the first interval whose upper bound is not below the value.
+            std::size_t intervalIndex(0);
+            while(intervalIndex < intervalCount && value > upperBounds[intervalIndex]){
+                ++intervalIndex;
+            }
+            
+            // Copy the value if it lies in that interval, or count it otherwise.
+            if(intervalIndex < intervalCount && value >= lowerBounds[intervalIndex]){
+                candidates[intervalIndex].push_back(*element);
+            }
+            else{
+                ++gapCounts[intervalIndex];
+            }
+        }
+    });
+    
+    /* Search the intervals in turn, keeping track of the number of elements
+     * that lie below the current interval.
+     */
+    std::size_t countBelow(0);
+    std::size_t rankIndex(0);
+    for(std::size_t intervalIndex = 0; intervalIndex < intervalCount; ++intervalIndex){
+        
+        // Gather the elements of the interval from every part.
+        std::size_t candidateCount(0);
+        for(std::size_t partIndex = 0; partIndex < partCount; ++partIndex){
+            countBelow += partGapCounts[partIndex][intervalIndex];
+            candidateCount += partCandidates[partIndex][intervalIndex].size();
+        }
+        std::vector<Element> candidates;
+        candidates.reserve(candidateCount);
+        for(std::size_t partIndex = 0; partIndex < partCount; ++partIndex){
+            std::vector<Element> & partInterval = partCandidates[partIndex][intervalIndex];
+            candidates.insert(candidates.end(), partInterval.begin(), partInterval.end());
+            std::vector<Element>().swap(partInterval);
+        }
+        
+        /* Convert the ranks in the interval to ranks among its elements,
+         * verifying that they really do lie in the interval.
+         */
+        std::size_t firstRankIndex = rankIndex;
+        std::vector<std::size_t> localRanks;
+        while(rankIndex < sortedRanks.size() && rankIntervals[rankIndex] == intervalIndex){
+            if(sortedRanks[rankIndex] < countBelow ||
+               sortedRanks[rankIndex] >= countBelow + candidateCount){
+                return false;
+            }
+            localRanks.push_back(sortedRanks[rankIndex] - countBelow);
+            ++rankIndex;
+        }
+        
+        // Find the ranks among the elements of the interval.
+        multiSelect(candidates.data(), 0, candidateCount, localRanks.data(),
+                    localRanks.data() + localRanks.size());
+        for(std::size_t localIndex = 0; localIndex < localRanks.size(); ++localIndex){
+            selected[firstRankIndex + localIndex] =
+                static_cast<double>(candidates[localRanks[localIndex]]);
+        }
+        countBelow += candidateCount;
+    }
+    return true;
+}
+
+// PUBLIC FUNCTIONS
+
+/** Function that finds several order statistics of an array exactly.
+ *
+ * \param values - A pointer to the first element of the array, which must
+ * not contain NaN.
+ * \param count - The number of elements in the array.
+ * \param ranks - The zero-based ranks of the required order statistics, in
+ * any order. Every rank must be less than "count".
+ * \param threadCount - The number of worker threads among which the array
+ * is divided.
+ *
+ * \return The order statistics in the same order as "ranks".
+ *
+ * The array is neither sorted nor modified. Small arrays are copied and the
+ * copy partitioned by std::nth_element(...). Larger arrays are searched by
+ * selectFromSample(), which copies only the elements close to the required
+ * order statistics and so needs little additional memory. In the unlikely
+ * event that its random sample is unrepresentative, the array is copied
+ * instead, which is slower but gives the same result.
+ */
+template<typename Element>
+std::vector<double> selectOrderStatistics(const Element * values, std::size_t count,
+                                          const std::vector<std::size_t> & ranks,
+                                          unsigned int threadCount){
+    
+    // Sort the ranks and remove duplicates.
+    std::vector<std::size_t> sortedRanks(ranks);
+    std::sort(sortedRanks.begin(), sortedRanks.end());
+    sortedRanks.erase(std::unique(sortedRanks.begin(), sortedRanks.end()), sortedRanks.end());
+    
+    // Find the order statistics in ascending order of rank.
+    std::vector<double> sortedSelected(sortedRanks.size());
+    if(!sortedRanks.empty() &&
+       (count < minimumSampledCount ||
+        !selectFromSample(values, count, sortedRanks, threadCount, sortedSelected))){
+        selectFromCopy(values, count, sortedRanks, sortedSelected);
+    }
+    
+    // Return them in the order of the original ranks.
+    std::vector<double> selected(ranks.size());
+    for(std::size_t rankIndex = 0; rankIndex < ranks.size(); ++rankIndex){
+        std::size_t sortedIndex = std::lower_bound(sortedRanks.begin(), sortedRanks.end(),
+                                                   ranks[rankIndex]) - sortedRanks.begin();
+        selected[rankIndex] = sortedSelected[sortedIndex];
+    }
+    return selected;
+}
+
+/** Function that computes several quantiles of an array exactly.
+ *
+ * \param values - A pointer to the first element of the array, which must
+ * not contain NaN.
+ * \param count - The number of elements in the array.
+ * \param probabilities - The fractions of the values that lie below each
+ * quantile. Values outside the range from zero to one are clamped to it.
+ * \param threadCount - The number of worker threads used if the array must
+ * be searched.
+ * \param valuesAreSorted - true if the array is already sorted into
+ * ascending order.
+ *
+ * \return The quantiles in the same order as "probabilities", or NaN for
+ * every quantile if the array is empty.
+ *
+ * The quantile for probability p is found at the position
+ * \f$ h = p(N - 1) \f$ among the N sorted values, interpolating linearly
+ * between the order statistics at ranks \f$ \lfloor h \rfloor \f$ and
+ * \f$ \lfloor h \rfloor + 1 \f$. Both order statistics of every quantile are
+ * found by a single call to selectOrderStatistics(), unless the array is
+ * sorted, in which case they are read directly.
+ */
+template<typename Element>
+std::vector<double> computeExactQuantiles(const Element * values, std::size_t count,
+                                          const std::vector<double> & probabilities,
+                                          unsigned int threadCount,
+                                          bool valuesAreSorted){
+    std::vector<double> quantiles(probabilities.size(),
+                                  std::numeric_limits<double>::quiet_NaN());
+    if(count == 0){
+        return quantiles;
+    }
+    
+    // Determine the positions of the quantiles and the adjacent ranks.
+    std::vector<double> positions(probabilities.size());
+    std::vector<std::size_t> ranks;
+    for(std::size_t quantileIndex = 0; quantileIndex < probabilities.size(); ++quantileIndex){
+        double probability = std::min(std::max(probabilities[quantileIndex], 0.0), 1.0);
+        positions[quantileIndex] = probability*(count - 1);
+        std::size_t lowerRank = static_cast<std::size_t>(std::floor(positions[quantileIndex]));
+        ranks.push_back(lowerRank);
+        ranks.push_back(std::min(lowerRank + 1, count - 1));
+    }
+    
+    // Find the order statistics at those ranks.
+    std::vector<double> orderStatistics(ranks.size());
+    if(valuesAreSorted){
+        for(std::size_t rankIndex = 0; rankIndex < ranks.size(); ++rankIndex){
+            orderStatistics[rankIndex] = static_cast<double>(values[ranks[rankIndex]]);
+        }
+    }
+    else{
+        orderStatistics = selectOrderStatistics(values, count, ranks, threadCount);
+    }
+    
+    // Interpolate between the order statistics adjacent to each quantile.
+    for(std::size_t quantileIndex = 0; quantileIndex < quantiles.size(); ++quantileIndex){
+        double lowerValue = orderStatistics[2*quantileIndex];
+        double upperValue = orderStatistics[2*quantileIndex + 1];
+        double fraction = positions[quantileIndex] - std::floor(positions[quantileIndex]);
+        quantiles[quantileIndex] = (fraction > 0.0) ?
+            lowerValue + fraction*(upperValue - lowerValue) : lowerValue;
+    }
+    return quantiles;
+}
+
+/** Function that sorts an array into ascending order using several worker
+ * threads.
+ *
+ * \param values - A pointer to the first element of the array, which must
+ * not contain NaN.
+ * \param count - The number of elements in the array.
+ * \param threadCount - The number of worker threads.
+ *
+ * The array is divided into one part per thread, and each part is sorted by
+ * std::sort(...) on its own thread. Adjacent pairs of sorted parts are then
+ * merged by std::inplace_merge(...), also concurrently, halving the number
+ * of parts in each round until the whole array is sorted.
+ */
+template<typename Element>
+void sortValuesInParallel(Element * values, std::size_t count, unsigned int threadCount){
+    
+    // Compute the first element of each part, and the end of the array.
+    std::size_t partCount = countParts(count, threadCount);
+    std::vector<std::size_t> partBegins(partCount + 1, count);
+    for(std::size_t partIndex = 0; partIndex < partCount; ++partIndex){
+        partBegins[partIndex] = partIndex*(count/partCount);
+    }
+    
+    // Sort each part on its own thread.
+    runTasks(partCount, [&](std::size_t partIndex){
+        std::sort(values + partBegins[partIndex], values + partBegins[partIndex + 1]);
+    });
+    
+    /* Merge adjacent pairs of sorted runs, each of "runWidth" parts, until a
+     * single run remains.
+     */
+    for(std::size_t runWidth = 1; runWidth < partCount; runWidth *= 2){
+        std::size_t mergeCount = (partCount - runWidth + 2*runWidth - 1)/(2*runWidth);
+        runTasks(mergeCount, [&](std::size_t mergeIndex){
+            std::size_t firstPart = 2*runWidth*mergeIndex;
+            std::size_t lastPart = std::min(firstPart + 2*runWidth, partCount);
+            std::inplace_merge(values + partBegins[firstPart],
+                               values + partBegins[firstPart + runWidth],
+                               values + partBegins[lastPart]);
+        });
+    }
+}
+
+// EXPLICIT INSTANTIATIONS
+
+/* The functions are instantiated for each type of value that
+ * BasicStatsCalculator can store.
+ */
+template std::vector<double> selectOrderStatistics<double>(const double *, std::size_t,
+                                                           const std::vector<std::size_t> &,
+                                                           unsigned int);
+template std::vector<double> selectOrderStatistics<float>(const float *, std::size_t,
+                                                          const std::vector<std::size_t> &,
+                                                          unsigned int);
+template std::vector<double> selectOrderStatistics<std::int64_t>(const std::int64_t *, std::size_t,
+                                                                 const std::vector<std::size_t> &,
+                                                                 unsigned int);
+template std::vector<double> computeExactQuantiles<double>(const double *, std::size_t,
+                                                           const std::vector<double> &,
+                                                           unsigned int, bool);
+template std::vector<double> computeExactQuantiles<float>(const float *, std::size_t,
+                                                          const std::vector<double> &,
+                                                          unsigned int, bool);
+template std::vector<double> computeExactQuantiles<std::int64_t>(const std::int64_t *, std::size_t,
+                                                                 const std::vector<double> &,
+                                                                 unsigned int, bool);
+template void sortValuesInParallel<double>(double *, std::size_t, unsigned int);
+template void sortValuesInParallel<float>(float *, std::size_t, unsigned int);
+template void sortValuesInParallel<std::int64_t>(std::int64_t *, std::size_t, unsigned int);
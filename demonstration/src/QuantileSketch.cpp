@@ -0,0 +1,453 @@
+// IMPLEMENTATION file for the SketchBucketStore and QuantileSketch classes
+
+// STL HEADER FILES
+
+/* The <cmath> header is included to provide the std::log(...), std::exp(...),
+ * std::ceil(...) and std::isfinite(...) functions.
+ */
+#include <cmath>
+// The <limits> header is included to provide the std::numeric_limits type.
+#include <limits>
+
+// LOCAL HEADER FILES
+
+/* The "QuantileSketch.h" header is included to provide definitions of the
+ * SketchBucketStore and QuantileSketch classes.
+ */
+#include "QuantileSketch.h"
+
+// CONSTANTS
+
+/* The maximum number of buckets in each store. For the default relative
+ * accuracy of 1%, this spans values over more than 17 orders of magnitude
+ * in at most 16 KiB per store.
+ */
+static const std::size_t maximumBucketsPerStore = 2048;
+
+/* The smallest supported relative accuracy. The buckets of a store span a
+ * ratio of about \f$ e^{2 \alpha B} \f$ between its smallest and largest
+ * values, where B is "maximumBucketsPerStore", so at this accuracy they span
+ * only a factor of 1.5, and almost any data would cause the lowest buckets
+ * to be merged. It also bounds the magnitude of every key to a few million.
+ */
+static const double minimumRelativeAccuracy = 1.0e-4;
+
+/* The largest magnitude of a bucket key. Keys are clamped to this magnitude,
+ * which leaves room to subtract any two keys without overflowing an int,
+ * even if a sketch is constructed with an unsupported accuracy.
+ */
+static const int maximumKeyMagnitude = std::numeric_limits<int>::max()/4;
+
+// PRIVATE METHODS OF SKETCHBUCKETSTORE
+
+/** Private method that merges every bucket whose key is lower than a new
+ * minimum key into the bucket with that key.
+ *
+ * \param newMinimumKey - The key of the lowest bucket that remains.
+ */
+void SketchBucketStore::collapseBelow(int newMinimumKey){
+    if(newMinimumKey <= minimumKey){
+        return;
+    }
+    
+    // Remove the buckets with lower keys, and sum their counts...
+    std::size_t droppedBucketCount = static_cast<std::size_t>(newMinimumKey - minimumKey);
+    if(droppedBucketCount > bucketCounts.size()){
+        droppedBucketCount = bucketCounts.size();
+    }
+    std::uint64_t collapsedCount(0);
+    for(std::size_t bucketIndex = 0; bucketIndex < droppedBucketCount; ++bucketIndex){
+        collapsedCount += bucketCounts[bucketIndex];
+    }
+    bucketCounts.erase(bucketCounts.begin(), bucketCounts.begin() + droppedBucketCount);
+    minimumKey = newMinimumKey;
+    lowestBucketCollapsed = true;
+    
+    // ...and add the sum to the new lowest bucket.
+    if(bucketCounts.empty()){
+        bucketCounts.push_back(0);
+    }
+    bucketCounts[0] += collapsedCount;
+}
+
+// PUBLIC METHODS OF SKETCHBUCKETSTORE
+
+/** Constructor for the SketchBucketStore class.
+ *
+ * \param maximumBuckets - The maximum number of buckets in the store.
+ */
+SketchBucketStore::SketchBucketStore(std::size_t maximumBuckets) :
+    bucketCounts(), minimumKey(0), maximumBucketCount(maximumBuckets), totalCount(0),
+    lowestBucketCollapsed(false) {
+    // No further initialization operations are required.
+}
+
+/** Public method that adds a count to the bucket with the specified key.
+ *
+ * \param key - The key of the bucket.
+ * \param count - The count to be added.
+ *
+ * The buckets are stored contiguously from the lowest to the highest key,
+ * and the range is extended as required. If the extended range would
+ * contain more than the maximum number of buckets, the lowest buckets are
+ * merged, and the lowest bucket is marked as collapsed.
+ */
+void SketchBucketStore::add(int key, std::uint64_t count){
+    
+    // The first bucket of an empty store is the one with the specified key.
+    if(bucketCounts.empty()){
+        minimumKey = key;
+        bucketCounts.push_back(0);
+    }
+    int maximumKey = minimumKey + static_cast<int>(bucketCounts.size()) - 1;
+    int bucketLimit = static_cast<int>(maximumBucketCount);
+    
+    if(key > maximumKey){
+        // Merge the lowest buckets if the range would become too wide...
+        if(key - minimumKey + 1 > bucketLimit){
+            collapseBelow(key - bucketLimit + 1);
+        }
+        // ...and then extend it upwards.
+        bucketCounts.resize(key - minimumKey + 1, 0);
+    }
+    else if(key < minimumKey){
+        // A key below a range of maximum width joins the lowest bucket...
+        if(maximumKey - key + 1 > bucketLimit){
+            key = maximumKey - bucketLimit + 1;
+            lowestBucketCollapsed = true;
+        }
+        // ...and otherwise the range is extended downwards.
+        if(key < minimumKey){
+            bucketCounts.insert(bucketCounts.begin(), minimumKey - key, 0);
+            minimumKey = key;
+        }
+    }
+    
+    bucketCounts[key - minimumKey] += count;
+    totalCount += count;
+}
+
+/** Public method that adds the counts of every bucket of another store to
+ * this store.
+ *
+ * \param other - The store whose counts should be added.
+ *
+ * If the lowest bucket of the other store is collapsed, it holds values
+ * with lower keys, so every bucket of this store below it is merged into it
+ * too, and the lowest bucket of this store is then collapsed.
+ */
+void SketchBucketStore::merge(const SketchBucketStore & other){
+    for(std::size_t bucketIndex = 0; bucketIndex < other.bucketCounts.size(); ++bucketIndex){
+        if(other.bucketCounts[bucketIndex] > 0){
+            add(other.minimumKey + static_cast<int>(bucketIndex),
+                other.bucketCounts[bucketIndex]);
+        }
+    }
+    if(other.lowestBucketCollapsed && !bucketCounts.empty()){
+        collapseBelow(other.minimumKey);
+        lowestBucketCollapsed = true;
+    }
+}
+
+/** Public method returns the total count of values in all buckets.
+ *
+ * \return The total count as an unsigned integer.
+ */
+std::uint64_t SketchBucketStore::getTotalCount() const {
+    return totalCount;
+}
+
+/** Public method returns the key of the bucket that contains the value with
+ * the specified rank.
+ *
+ * \param rank - The zero-based rank of the value, counting from the bucket
+ * with the lowest key. It must be less than the total count.
+ *
+ * \return The key of the first bucket for which the cumulative count of the
+ * buckets up to and including it exceeds the rank.
+ */
+int SketchBucketStore::getKeyAtRank(std::uint64_t rank) const {
+    std::uint64_t cumulativeCount(0);
+    for(std::size_t bucketIndex = 0; bucketIndex < bucketCounts.size(); ++bucketIndex){
+        cumulativeCount += bucketCounts[bucketIndex];
+        if(cumulativeCount > rank){
+            return minimumKey + static_cast<int>(bucketIndex);
+        }
+    }
+    return minimumKey + static_cast<int>(bucketCounts.size()) - 1;
+}
+
+/** Public method returns true if the value with the specified rank lies in
+ * a collapsed bucket.
+ *
+ * \param rank - The zero-based rank of the value, counting from the bucket
+ * with the lowest key. It must be less than the total count.
+ *
+ * \return true if the lowest bucket is collapsed and contains the value,
+ * otherwise false.
+ */
+bool SketchBucketStore::isRankCollapsed(std::uint64_t rank) const {
+    return lowestBucketCollapsed && !bucketCounts.empty() && rank < bucketCounts[0];
+}
+
+// PRIVATE METHODS OF QUANTILESKETCH
+
+/** Private method returns the bucket key of a positive value.
+ *
+ * \param magnitude - A positive value.
+ *
+ * \return The integer key k for which \f$ \gamma^{k-1} < x \le \gamma^{k} \f$,
+ * clamped to magnitudes of at most "maximumKeyMagnitude".
+ *
+ * The key is computed and clamped in double precision before it is
+ * converted, since converting a double that does not fit in an int is
+ * undefined behaviour. For supported accuracies no clamping is necessary.
+ */
+int QuantileSketch::getKey(double magnitude) const {
+    double key = std::ceil(std::log(magnitude)*inverseLogGamma);
+    if(key > maximumKeyMagnitude){
+        key = maximumKeyMagnitude;
+    }
+    else if(key < -maximumKeyMagnitude){
+        key = -maximumKeyMagnitude;
+    }
+    return static_cast<int>(key);
+}
+
+/** Private method returns the representative value of the bucket with the
+ * specified key.
+ *
+ * \param key - The key of the bucket.
+ *
+ * \return The value \f$ 2\gamma^{k}/(1 + \gamma) \f$, which lies within a
+ * relative error \f$ \alpha \f$ of every value in the bucket.
+ */
+double QuantileSketch::getBucketValue(int key) const {
+    double gamma = (1.0 + relativeAccuracy)/(1.0 - relativeAccuracy);
+    return 2.0*std::exp(key/inverseLogGamma)/(1.0 + gamma);
+}
+
+/** Private method returns the rank of the value that estimates a quantile.
+ *
+ * \param probability - The fraction of the values that lie below the
+ * quantile. Values outside the range from zero to one are clamped to it.
+ *
+ * \return The rank \f$ \lfloor q(N - 1) \rfloor \f$ in ascending order,
+ * where N is the number of values, which must be at least one.
+ */
+std::uint64_t QuantileSketch::getRank(double probability) const {
+    if(probability < 0.0){
+        probability = 0.0;
+    }
+    if(probability > 1.0){
+        probability = 1.0;
+    }
+    return static_cast<std::uint64_t>(probability*(getCount() - 1));
+}
+
+// PUBLIC METHODS OF QUANTILESKETCH
+
+/** Default constructor for the QuantileSketch class.
+ *
+ * Creates an empty sketch whose estimated quantiles are within 1% of the
+ * true values.
+ */
+QuantileSketch::QuantileSketch() : relativeAccuracy(0.01),
+                                   inverseLogGamma(1.0/std::log(1.01/0.99)),
+                                   positiveStore(maximumBucketsPerStore),
+                                   negativeStore(maximumBucketsPerStore),
+                                   zeroCount(0) {
+    // No further initialization operations are required.
+}
+
+/** Constructor for the QuantileSketch class.
+ *
+ * \param accuracy - The relative accuracy \f$ \alpha \f$ of the estimated
+ * quantiles, which must be supported, as reported by isSupportedAccuracy().
+ * Smaller values require more buckets to span the same range of values, so
+ * the lowest buckets are merged sooner.
+ */
+QuantileSketch::QuantileSketch(double accuracy) :
+    relativeAccuracy(accuracy),
+    inverseLogGamma(1.0/std::log((1.0 + accuracy)/(1.0 - accuracy))),
+    positiveStore(maximumBucketsPerStore), negativeStore(maximumBucketsPerStore),
+    zeroCount(0) {
+    // No further initialization operations are required.
+}
+
+/** Public static method returns the smallest supported relative accuracy.
+ *
+ * \return The value of "minimumRelativeAccuracy".
+ */
+double QuantileSketch::getMinimumRelativeAccuracy(){
+    return minimumRelativeAccuracy;
+}
+
+/** Public static method returns true if a relative accuracy is supported.
+ *
+ * \param accuracy - The relative accuracy \f$ \alpha \f$.
+ *
+ * \return true if the accuracy is at least "minimumRelativeAccuracy" and
+ * less than one, otherwise false. An accuracy of one or more would make
+ * \f$ \gamma \f$ infinite or negative, and every estimate NaN. An accuracy
+ * that is NaN fails both comparisons, so it is not supported either.
+ */
+bool QuantileSketch::isSupportedAccuracy(double accuracy){
+    return accuracy >= minimumRelativeAccuracy && accuracy < 1.0;
+}
+
+/** Public method that adds a single value to the sketch.
+ *
+ * \param value - The value to be added.
+ *
+ * Positive and negative values are counted in separate stores, keyed by
+ * their magnitudes. Values whose magnitude is smaller than the smallest
+ * normalized double-precision number are counted as zero, and infinite
+ * values and values that are not numbers are ignored.
+ */
+void QuantileSketch::addValue(double value){
+    if(!std::isfinite(value)){
+        return;
+    }
+    if(value >= std::numeric_limits<double>::min()){
+        positiveStore.add(getKey(value), 1);
+    }
+    else if(value <= -std::numeric_limits<double>::min()){
+        negativeStore.add(getKey(-value), 1);
+    }
+    else{
+        ++zeroCount;
+    }
+}
+
+/** Public method that adds an array of values to the sketch.
+ *
+ * \param values - A pointer to the first element of the array.
+ * \param valueCount - The number of elements in the array.
+ */
+void QuantileSketch::addValues(const double * values, std::size_t valueCount){
+    for(std::size_t valueIndex = 0; valueIndex < valueCount; ++valueIndex){
+        addValue(values[valueIndex]);
+    }
+}
+
+/** Public method that adds an array of single precision values to the
+ * sketch.
+ *
+ * \param values - A pointer to the first element of the array.
+ * \param valueCount - The number of elements in the array.
+ */
+void QuantileSketch::addValues(const float * values, std::size_t valueCount){
+    for(std::size_t valueIndex = 0; valueIndex < valueCount; ++valueIndex){
+        addValue(values[valueIndex]);
+    }
+}
+
+/** Public method that adds an array of 64-bit integers to the sketch.
+ *
+ * \param values - A pointer to the first element of the array.
+ * \param valueCount - The number of elements in the array.
+ */
+void QuantileSketch::addValues(const std::int64_t * values, std::size_t valueCount){
+    for(std::size_t valueIndex = 0; valueIndex < valueCount; ++valueIndex){
+        addValue(static_cast<double>(values[valueIndex]));
+    }
+}
+
+/** Public method that adds the counts of another sketch to this sketch.
+ *
+ * \param other - The sketch whose counts should be added.
+ *
+ * \return true if the sketches were merged, false if their relative
+ * accuracies differ, in which case this sketch is unchanged.
+ *
+ * After merging, this sketch is identical to one that had been supplied
+ * with the values of both sketches, unless the lowest buckets had to be
+ * merged to respect the bound on their number, which isWithinAccuracy()
+ * then reports.
+ */
+bool QuantileSketch::merge(const QuantileSketch & other){
+    if(other.relativeAccuracy != relativeAccuracy){
+        return false;
+    }
+    positiveStore.merge(other.positiveStore);
+    negativeStore.merge(other.negativeStore);
+    zeroCount += other.zeroCount;
+    return true;
+}
+
+/** Public method returns the number of values that have been added.
+ *
+ * \return The number of values as an unsigned integer.
+ */
+std::uint64_t QuantileSketch::getCount() const {
+    return negativeStore.getTotalCount() + zeroCount + positiveStore.getTotalCount();
+}
+
+/** Public method returns the relative accuracy of the sketch.
+ *
+ * \return The relative accuracy \f$ \alpha \f$.
+ */
+double QuantileSketch::getRelativeAccuracy() const {
+    return relativeAccuracy;
+}
+
+/** Public method returns an estimate of a quantile of the values that have
+ * been added.
+ *
+ * \param probability - The fraction of the values that lie below the
+ * quantile. Values outside the range from zero to one are clamped to it.
+ *
+ * \return An estimate of the value with rank \f$ \lfloor q(N - 1) \rfloor \f$
+ * in ascending order, which lies within the relative accuracy of the true
+ * value with that rank unless isWithinAccuracy() returns false. If no values
+ * have been added, NaN is returned.
+ *
+ * The negative values are ranked first, in descending order of magnitude,
+ * followed by the zeros and the positive values in ascending order of
+ * magnitude.
+ */
+double QuantileSketch::getQuantile(double probability) const {
+    std::uint64_t count = getCount();
+    if(count == 0){
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    
+    // Determine the rank of the required value, and the store containing it.
+    std::uint64_t rank = getRank(probability);
+    std::uint64_t negativeCount = negativeStore.getTotalCount();
+    if(rank < negativeCount){
+        // Higher negative keys correspond to lower values.
+        return -getBucketValue(negativeStore.getKeyAtRank(negativeCount - 1 - rank));
+    }
+    if(rank < negativeCount + zeroCount){
+        return 0.0;
+    }
+    return getBucketValue(positiveStore.getKeyAtRank(rank - negativeCount - zeroCount));
+}
+
+/** Public method returns true if the estimate of a quantile is within the
+ * relative accuracy of the sketch.
+ *
+ * \param probability - The fraction of the values that lie below the
+ * quantile. Values outside the range from zero to one are clamped to it.
+ *
+ * \return false if no values have been added, or if the value with the rank
+ * used by getQuantile() lies in a collapsed bucket of the store containing
+ * it, otherwise true. The collapsed bucket of the negative store holds the
+ * negative values of smallest magnitude, which are ranked last among them.
+ */
+bool QuantileSketch::isWithinAccuracy(double probability) const {
+    if(getCount() == 0){
+        return false;
+    }
+    std::uint64_t rank = getRank(probability);
+    std::uint64_t negativeCount = negativeStore.getTotalCount();
+    if(rank < negativeCount){
+        return !negativeStore.isRankCollapsed(negativeCount - 1 - rank);
+    }
+    if(rank < negativeCount + zeroCount){
+        return true;
+    }
+    return !positiveStore.isRankCollapsed(rank - negativeCount - zeroCount);
+}
@@ -0,0 +1,1008 @@
+// IMPLEMENTATION file for the explicitly vectorized reduction kernels
+
+/* The vector kernels use compiler intrinsics that are only available when
+ * compiling for x86 processors. On any other architecture only the scalar
+ * kernel is compiled.
+ */
+#if defined(__x86_64__) || defined(__i386__)
+#define REDUCTION_KERNELS_X86
+// The <immintrin.h> header is included to provide the AVX2 and AVX-512 intrinsics.
+#include <immintrin.h>
+#endif
+
+// STL HEADER FILES
+
+// The <cstdint> header is included to provide the std::int64_t type.
+#include <cstdint>
+// The <limits> header is included to provide the std::numeric_limits type.
+#include <limits>
+
+// LOCAL HEADER FILES
+
+/* The "ReductionKernels.h" header is included to provide the declarations of
+ * the reduction functions.
+ */
+#include "ReductionKernels.h"
+
+// KERNELS
+
+/** Kernel that computes the sums of the first four powers of the deviations
+ * of the elements of an array from a shift value, and the smallest and
+ * largest elements, using only scalar floating-point arithmetic.
+ *
+ * \param values - A pointer to the first element of the array.
+ * \param count - The number of elements in the array.
+ * \param shift - The value that is subtracted from every element.
+ * \param sums - A reference to a structure that receives the results.
+ *
+ * A single accumulator forms a serial dependency chain, because each
+ * addition must wait for the previous one to complete. Four independent
+ * sets of accumulators are therefore updated in rotation, allowing four
+ * additions to be in flight simultaneously, and are combined in a fixed
+ * order, so the result is deterministic. The square of each deviation is
+ * computed once and reused for its third and fourth powers.
+ *
+ * The kernel is a template over the type of the elements, which may be
+ * double, float or std::int64_t. Each element is converted to double
+ * precision as it is loaded, so the sums are always accumulated in double
+ * precision whatever the type in which the values are stored.
+ */
+template<typename Element>
+static void scalarMomentSums(const Element * values, std::size_t count, double shift,
+                             ShiftedMomentSums & sums){
+    
+    // Declare and initialize four sets of partial results.
+    double partialSums[4] = {0.0, 0.0, 0.0, 0.0};
+    double partialSquares[4] = {0.0, 0.0, 0.0, 0.0};
+    double partialCubes[4] = {0.0, 0.0, 0.0, 0.0};
+    double partialFourthPowers[4] = {0.0, 0.0, 0.0, 0.0};
+    double partialMinima[4], partialMaxima[4];
+    for(std::size_t lane = 0; lane < 4; ++lane){
+        partialMinima[lane] = std::numeric_limits<double>::infinity();
+        partialMaxima[lane] = -std::numeric_limits<double>::infinity();
+    }
+    
+    // Process the array in groups of four elements.
+    std::size_t index(0);
+    for(; index + 4 <= count; index += 4){
+        for(std::size_t lane = 0; lane < 4; ++lane){
+            double value = static_cast<double>(values[index + lane]);
+            double deviation = value - shift;
+            double square = deviation*deviation;
+            partialSums[lane] += deviation;
+            partialSquares[lane] += square;
+            partialCubes[lane] += square*deviation;
+            partialFourthPowers[lane] += square*square;
+            partialMinima[lane] = (value < partialMinima[lane]) ? value : partialMinima[lane];
+            partialMaxima[lane] = (value > partialMaxima[lane]) ? value : partialMaxima[lane];
+        }
+    }
+    
+    // Process any remaining elements using the first set of accumulators.
+    for(; index < count; ++index){
+        double value = static_cast<double>(values[index]);
+        double deviation = value - shift;
+        double square = deviation*deviation;
+        partialSums[0] += deviation;
+        partialSquares[0] += square;
+        partialCubes[0] += square*deviation;
+        partialFourthPowers[0] += square*square;
+        partialMinima[0] = (value < partialMinima[0]) ? value : partialMinima[0];
+        partialMaxima[0] = (value > partialMaxima[0]) ? value : partialMaxima[0];
+    }
+    
+    // Combine the partial results pairwise in a fixed order.
+    sums.sum = (partialSums[0] + partialSums[1]) + (partialSums[2] + partialSums[3]);
+    sums.sumOfSquares = (partialSquares[0] + partialSquares[1]) +
+                        (partialSquares[2] + partialSquares[3]);
+    sums.sumOfCubes = (partialCubes[0] + partialCubes[1]) +
+                      (partialCubes[2] + partialCubes[3]);
+    sums.sumOfFourthPowers = (partialFourthPowers[0] + partialFourthPowers[1]) +
+                             (partialFourthPowers[2] + partialFourthPowers[3]);
+    sums.minimum = partialMinima[0];
+    sums.maximum = partialMaxima[0];
+    for(std::size_t lane = 1; lane < 4; ++lane){
+        sums.minimum = (partialMinima[lane] < sums.minimum) ? partialMinima[lane] : sums.minimum;
+        sums.maximum = (partialMaxima[lane] > sums.maximum) ? partialMaxima[lane] : sums.maximum;
+    }
+}
+
+/** Kernel that adds the sums of the products of every pair of columns of a
+ * block of values to the upper triangle of a matrix using only scalar
+ * floating-point arithmetic.
+ *
+ * \param block - A pointer to the first value of the block, whose columns
+ * are stored one after another.
+ * \param columnCount - The number of columns in the block.
+ * \param rowCount - The number of values in each column, which must be a
+ * multiple of eight.
+ * \param columnStride - The distance between the first values of successive
+ * columns, which must not be less than "rowCount".
+ * \param crossProducts - A pointer to the first element of a square matrix
+ * with "columnCount" rows, stored row by row, to whose elements on and
+ * above the diagonal the sums are added.
+ *
+ * Each sum of products is a dot product of two columns. As in
+ * scalarMomentSums(), four independent accumulators are updated in
+ * rotation, so that four multiplications and additions can be in flight
+ * simultaneously.
+ */
+static void scalarCrossProducts(const double * block, std::size_t columnCount,
+                                std::size_t rowCount, std::size_t columnStride,
+                                double * crossProducts){
+    for(std::size_t first = 0; first < columnCount; ++first){
+        const double * firstColumn = block + first*columnStride;
+        for(std::size_t second = first; second < columnCount; ++second){
+            const double * secondColumn = block + second*columnStride;
+            double partialProducts[4] = {0.0, 0.0, 0.0, 0.0};
+            for(std::size_t row = 0; row < rowCount; row += 4){
+                partialProducts[0] += firstColumn[row]*secondColumn[row];
+                partialProducts[1] += firstColumn[row + 1]*secondColumn[row + 1];
+                partialProducts[2] += firstColumn[row + 2]*secondColumn[row + 2];
+                partialProducts[3] += firstColumn[row + 3]*secondColumn[row + 3];
+            }
+            crossProducts[first*columnCount + second] +=
+                (partialProducts[0] + partialProducts[1]) +
+                (partialProducts[2] + partialProducts[3]);
+        }
+    }
+}
+
+#ifdef REDUCTION_KERNELS_X86
+
+/** Helper functions that load four consecutive elements of an array into
+ * the lanes of a 256-bit vector of double precision values, converting them
+ * if necessary. Each overload is selected at compile time by the type of
+ * the elements.
+ *
+ * \param values - A pointer to the first of the four elements.
+ *
+ * \return The vector of converted elements.
+ *
+ * Four single precision values are loaded as a 128-bit vector and widened
+ * by a single instruction. AVX2 provides no instruction that converts
+ * 64-bit integers to double precision, so those are converted one at a
+ * time.
+ */
+__attribute__((target("avx2,fma")))
+static inline __m256d avx2LoadValues(const double * values){
+    return _mm256_loadu_pd(values);
+}
+
+__attribute__((target("avx2,fma")))
+static inline __m256d avx2LoadValues(const float * values){
+    return _mm256_cvtps_pd(_mm_loadu_ps(values));
+}
+
+__attribute__((target("avx2,fma")))
+static inline __m256d avx2LoadValues(const std::int64_t * values){
+    return _mm256_set_pd(static_cast<double>(values[3]), static_cast<double>(values[2]),
+                         static_cast<double>(values[1]), static_cast<double>(values[0]));
+}
+
+/** Kernel that computes the sums of the first four powers of the deviations
+ * of the elements of an array from a shift value, and the smallest and
+ * largest elements, using 256-bit AVX2 vector instructions.
+ *
+ * \param values - A pointer to the first element of the array.
+ * \param count - The number of elements in the array.
+ * \param shift - The value that is subtracted from every element.
+ * \param sums - A reference to a structure that receives the results.
+ *
+ * Six quantities are accumulated, so only two independent vector
+ * accumulators are used for each, processing eight elements per loop
+ * iteration, in order that all of them fit in the sixteen vector registers.
+ * The third and fourth powers are accumulated using fused multiply-add
+ * instructions applied to the squared deviations.
+ *
+ * As for scalarMomentSums(), the type of the elements is a template
+ * parameter, and every element is converted to double precision by
+ * avx2LoadValues() as it is loaded.
+ *
+ * \note The "target" attribute instructs the compiler to generate AVX2 and
+ * FMA instructions for this function only. It must therefore only be called
+ * after verifying that the current processor supports them.
+ */
+template<typename Element>
+__attribute__((target("avx2,fma")))
+static void avx2MomentSums(const Element * values, std::size_t count, double shift,
+                           ShiftedMomentSums & sums){
+    
+    // Declare and initialize two vector accumulators for each quantity.
+    __m256d sums0 = _mm256_setzero_pd(), sums1 = _mm256_setzero_pd();
+    __m256d squares0 = _mm256_setzero_pd(), squares1 = _mm256_setzero_pd();
+    __m256d cubes0 = _mm256_setzero_pd(), cubes1 = _mm256_setzero_pd();
+    __m256d fourths0 = _mm256_setzero_pd(), fourths1 = _mm256_setzero_pd();
+    __m256d minima0 = _mm256_set1_pd(std::numeric_limits<double>::infinity());
+    __m256d minima1 = minima0;
+    __m256d maxima0 = _mm256_set1_pd(-std::numeric_limits<double>::infinity());
+    __m256d maxima1 = maxima0;
+    
+    // Copy the shift value into every lane of a vector.
+    __m256d shifts = _mm256_set1_pd(shift);
+    
+    // Process the array in groups of eight elements.
+    std::size_t index(0);
+    for(; index + 8 <= count; index += 8){
+        __m256d raw0 = avx2LoadValues(values + index);
+        __m256d raw1 = avx2LoadValues(values + index + 4);
+        __m256d values0 = _mm256_sub_pd(raw0, shifts);
+        __m256d values1 = _mm256_sub_pd(raw1, shifts);
+        __m256d valueSquares0 = _mm256_mul_pd(values0, values0);
+        __m256d valueSquares1 = _mm256_mul_pd(values1, values1);
+        sums0 = _mm256_add_pd(sums0, values0);
+        sums1 = _mm256_add_pd(sums1, values1);
+        squares0 = _mm256_add_pd(squares0, valueSquares0);
+        squares1 = _mm256_add_pd(squares1, valueSquares1);
+        cubes0 = _mm256_fmadd_pd(valueSquares0, values0, cubes0);
+        cubes1 = _mm256_fmadd_pd(valueSquares1, values1, cubes1);
+        fourths0 = _mm256_fmadd_pd(valueSquares0, valueSquares0, fourths0);
+        fourths1 = _mm256_fmadd_pd(valueSquares1, valueSquares1, fourths1);
+        minima0 = _mm256_min_pd(minima0, raw0);
+        minima1 = _mm256_min_pd(minima1, raw1);
+        maxima0 = _mm256_max_pd(maxima0, raw0);
+        maxima1 = _mm256_max_pd(maxima1, raw1);
+    }
+    
+    // Combine the vector accumulators, and store their lanes.
+    double sumLanes[4], squareLanes[4], cubeLanes[4], fourthLanes[4];
+    double minimumLanes[4], maximumLanes[4];
+    _mm256_storeu_pd(sumLanes, _mm256_add_pd(sums0, sums1));
+    _mm256_storeu_pd(squareLanes, _mm256_add_pd(squares0, squares1));
+    _mm256_storeu_pd(cubeLanes, _mm256_add_pd(cubes0, cubes1));
+    _mm256_storeu_pd(fourthLanes, _mm256_add_pd(fourths0, fourths1));
+    _mm256_storeu_pd(minimumLanes, _mm256_min_pd(minima0, minima1));
+    _mm256_storeu_pd(maximumLanes, _mm256_max_pd(maxima0, maxima1));
+    
+    // Combine the four lanes of each quantity in a fixed order.
+    sums.sum = (sumLanes[0] + sumLanes[1]) + (sumLanes[2] + sumLanes[3]);
+    sums.sumOfSquares = (squareLanes[0] + squareLanes[1]) + (squareLanes[2] + squareLanes[3]);
+    sums.sumOfCubes = (cubeLanes[0] + cubeLanes[1]) + (cubeLanes[2] + cubeLanes[3]);
+    sums.sumOfFourthPowers = (fourthLanes[0] + fourthLanes[1]) +
+                             (fourthLanes[2] + fourthLanes[3]);
+    sums.minimum = minimumLanes[0];
+    sums.maximum = maximumLanes[0];
+    for(std::size_t lane = 1; lane < 4; ++lane){
+        sums.minimum = (minimumLanes[lane] < sums.minimum) ? minimumLanes[lane] : sums.minimum;
+        sums.maximum = (maximumLanes[lane] > sums.maximum) ? maximumLanes[lane] : sums.maximum;
+    }
+    
+    // Process the final (at most seven) elements individually.
+    for(; index < count; ++index){
+        double value = static_cast<double>(values[index]);
+        double deviation = value - shift;
+        double square = deviation*deviation;
+        sums.sum += deviation;
+        sums.sumOfSquares += square;
+        sums.sumOfCubes += square*deviation;
+        sums.sumOfFourthPowers += square*square;
+        sums.minimum = (value < sums.minimum) ? value : sums.minimum;
+        sums.maximum = (value > sums.maximum) ? value : sums.maximum;
+    }
+}
+
+/** Helper functions that load eight consecutive elements of an array into
+ * the lanes of a 512-bit vector of double precision values, converting them
+ * if necessary, as avx2LoadValues() does for four elements.
+ *
+ * \param mask - A mask that selects the lanes to be loaded. The lanes that
+ * it does not select are set to zero, and the corresponding elements are
+ * not read.
+ * \param values - A pointer to the first of the eight elements.
+ *
+ * \return The vector of converted elements.
+ *
+ * Eight single precision values are loaded as a 256-bit vector and widened
+ * by a single instruction, using its masked form for the reason given in
+ * avx512MomentSums(). A 256-bit masked load requires AVX-512VL, so only the
+ * selected elements are first copied into a local array. AVX-512F provides
+ * no instruction that converts 64-bit integers to double precision (it is
+ * part of AVX-512DQ), so those are converted one at a time.
+ */
+__attribute__((target("avx512f")))
+static inline __m512d avx512LoadValues(__mmask8 mask, const double * values){
+    return _mm512_maskz_loadu_pd(mask, values);
+}
+
+__attribute__((target("avx512f")))
+static inline __m512d avx512LoadValues(__mmask8 mask, const float * values){
+    float selected[8] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+    for(std::size_t lane = 0; lane < 8; ++lane){
+        if(mask & (1u << lane)){
+            selected[lane] = values[lane];
+        }
+    }
+    return _mm512_maskz_cvtps_pd(0xFF, _mm256_loadu_ps(selected));
+}
+
+__attribute__((target("avx512f")))
+static inline __m512d avx512LoadValues(__mmask8 mask, const std::int64_t * values){
+    double converted[8] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+    for(std::size_t lane = 0; lane < 8; ++lane){
+        if(mask & (1u << lane)){
+            converted[lane] = static_cast<double>(values[lane]);
+        }
+    }
+    return _mm512_loadu_pd(converted);
+}
+
+/** Helper functions that load eight consecutive elements of an array into
+ * the lanes of a 512-bit vector of double precision values without a mask.
+ *
+ * \param values - A pointer to the first of the eight elements.
+ *
+ * \return The vector of converted elements.
+ */
+__attribute__((target("avx512f")))
+static inline __m512d avx512LoadValues(const double * values){
+    return _mm512_loadu_pd(values);
+}
+
+__attribute__((target("avx512f")))
+static inline __m512d avx512LoadValues(const float * values){
+    return _mm512_maskz_cvtps_pd(0xFF, _mm256_loadu_ps(values));
+}
+
+__attribute__((target("avx512f")))
+static inline __m512d avx512LoadValues(const std::int64_t * values){
+    return avx512LoadValues(0xFF, values);
+}
+
+/** Kernel that computes the sums of the first four powers of the deviations
+ * of the elements of an array from a shift value, and the smallest and
+ * largest elements, using 512-bit AVX-512F vector instructions.
+ *
+ * \param values - A pointer to the first element of the array.
+ * \param count - The number of elements in the array.
+ * \param shift - The value that is subtracted from every element.
+ * \param sums - A reference to a structure that receives the results.
+ *
+ * Two independent vector accumulators are used for each quantity, so that
+ * sixteen elements are processed per loop iteration. The final partial
+ * vector is loaded using a mask that zeroes the lanes beyond the end of the
+ * array, so no scalar remainder loop is required. The deviations
+ * in the masked lanes are zero, and so contribute nothing to the sums of
+ * their powers, while the masked lanes of the minima and maxima are left
+ * unchanged.
+ *
+ * As for scalarMomentSums(), the type of the elements is a template
+ * parameter, and every element is converted to double precision by
+ * avx512LoadValues() as it is loaded.
+ *
+ * \note The "target" attribute instructs the compiler to generate AVX-512F
+ * instructions for this function only. It must therefore only be called
+ * after verifying that the current processor supports them.
+ */
+template<typename Element>
+__attribute__((target("avx512f")))
+static void avx512MomentSums(const Element * values, std::size_t count, double shift,
+                             ShiftedMomentSums & sums){
+    
+    // Declare and initialize two vector accumulators for each quantity.
+    __m512d sums0 = _mm512_setzero_pd(), sums1 = _mm512_setzero_pd();
+    __m512d squares0 = _mm512_setzero_pd(), squares1 = _mm512_setzero_pd();
+    __m512d cubes0 = _mm512_setzero_pd(), cubes1 = _mm512_setzero_pd();
+    __m512d fourths0 = _mm512_setzero_pd(), fourths1 = _mm512_setzero_pd();
+    __m512d minima0 = _mm512_set1_pd(std::numeric_limits<double>::infinity());
+    __m512d minima1 = minima0;
+    __m512d maxima0 = _mm512_set1_pd(-std::numeric_limits<double>::infinity());
+    __m512d maxima1 = maxima0;
+    
+    // Copy the shift value into every lane of a vector.
+    __m512d shifts = _mm512_set1_pd(shift);
+    
+    /* The minima and maxima are updated using the masked forms of the
+     * instructions with every lane selected, which are equivalent to the
+     * unmasked forms but avoid a spurious warning from some compilers about
+     * the undefined source vector of the latter.
+     */
+    const __mmask8 allLanes = 0xFF;
+    
+    // Process the array in groups of sixteen elements.
+    std::size_t index(0);
+    for(; index + 16 <= count; index += 16){
+        __m512d raw0 = avx512LoadValues(values + index);
+        __m512d raw1 = avx512LoadValues(values + index + 8);
+        __m512d values0 = _mm512_sub_pd(raw0, shifts);
+        __m512d values1 = _mm512_sub_pd(raw1, shifts);
+        __m512d valueSquares0 = _mm512_mul_pd(values0, values0);
+        __m512d valueSquares1 = _mm512_mul_pd(values1, values1);
+        sums0 = _mm512_add_pd(sums0, values0);
+        sums1 = _mm512_add_pd(sums1, values1);
+        squares0 = _mm512_add_pd(squares0, valueSquares0);
+        squares1 = _mm512_add_pd(squares1, valueSquares1);
+        cubes0 = _mm512_fmadd_pd(valueSquares0, values0, cubes0);
+        cubes1 = _mm512_fmadd_pd(valueSquares1, values1, cubes1);
+        fourths0 = _mm512_fmadd_pd(valueSquares0, valueSquares0, fourths0);
+        fourths1 = _mm512_fmadd_pd(valueSquares1, valueSquares1, fourths1);
+        minima0 = _mm512_mask_min_pd(minima0, allLanes, minima0, raw0);
+        minima1 = _mm512_mask_min_pd(minima1, allLanes, minima1, raw1);
+        maxima0 = _mm512_mask_max_pd(maxima0, allLanes, maxima0, raw0);
+        maxima1 = _mm512_mask_max_pd(maxima1, allLanes, maxima1, raw1);
+    }
+    
+    // Process the remaining elements eight at a time using the first accumulators.
+    for(; index < count; index += 8){
+        std::size_t remaining = count - index;
+        __mmask8 mask = (remaining >= 8) ? 0xFF : static_cast<__mmask8>((1u << remaining) - 1);
+        __m512d raw0 = avx512LoadValues(mask, values + index);
+        __m512d values0 = _mm512_maskz_sub_pd(mask, raw0, shifts);
+        __m512d valueSquares0 = _mm512_mul_pd(values0, values0);
+        sums0 = _mm512_add_pd(sums0, values0);
+        squares0 = _mm512_add_pd(squares0, valueSquares0);
+        cubes0 = _mm512_fmadd_pd(valueSquares0, values0, cubes0);
+        fourths0 = _mm512_fmadd_pd(valueSquares0, valueSquares0, fourths0);
+        minima0 = _mm512_mask_min_pd(minima0, mask, minima0, raw0);
+        maxima0 = _mm512_mask_max_pd(maxima0, mask, maxima0, raw0);
+    }
+    
+    // Combine the vector accumulators, and store their lanes.
+    double sumLanes[8], squareLanes[8], cubeLanes[8], fourthLanes[8];
+    double minimumLanes[8], maximumLanes[8];
+    _mm512_storeu_pd(sumLanes, _mm512_add_pd(sums0, sums1));
+    _mm512_storeu_pd(squareLanes, _mm512_add_pd(squares0, squares1));
+    _mm512_storeu_pd(cubeLanes, _mm512_add_pd(cubes0, cubes1));
+    _mm512_storeu_pd(fourthLanes, _mm512_add_pd(fourths0, fourths1));
+    _mm512_storeu_pd(minimumLanes, _mm512_mask_min_pd(minima0, allLanes, minima0, minima1));
+    _mm512_storeu_pd(maximumLanes, _mm512_mask_max_pd(maxima0, allLanes, maxima0, maxima1));
+    
+    // Combine the eight lanes of each quantity in a fixed order.
+    sums.sum = ((sumLanes[0] + sumLanes[1]) + (sumLanes[2] + sumLanes[3])) +
+               ((sumLanes[4] + sumLanes[5]) + (sumLanes[6] + sumLanes[7]));
+    sums.sumOfSquares = ((squareLanes[0] + squareLanes[1]) + (squareLanes[2] + squareLanes[3])) +
+                        ((squareLanes[4] + squareLanes[5]) + (squareLanes[6] + squareLanes[7]));
+    sums.sumOfCubes = ((cubeLanes[0] + cubeLanes[1]) + (cubeLanes[2] + cubeLanes[3])) +
+                      ((cubeLanes[4] + cubeLanes[5]) + (cubeLanes[6] + cubeLanes[7]));
+    sums.sumOfFourthPowers = ((fourthLanes[0] + fourthLanes[1]) +
+                              (fourthLanes[2] + fourthLanes[3])) +
+                             ((fourthLanes[4] + fourthLanes[5]) +
+                              (fourthLanes[6] + fourthLanes[7]));
+    sums.minimum = minimumLanes[0];
+    sums.maximum = maximumLanes[0];
+    for(std::size_t lane = 1; lane < 8; ++lane){
+        sums.minimum = (minimumLanes[lane] < sums.minimum) ? minimumLanes[lane] : sums.minimum;
+        sums.maximum = (maximumLanes[lane] > sums.maximum) ? maximumLanes[lane] : sums.maximum;
+    }
+}
+
+/** Helper function that adds the four lanes of a 256-bit vector in a fixed
+ * order.
+ *
+ * \param lanes - The vector.
+ *
+ * \return The sum of the lanes.
+ */
+__attribute__((target("avx2,fma")))
+static inline double avx2LaneSum(__m256d lanes){
+    double laneValues[4];
+    _mm256_storeu_pd(laneValues, lanes);
+    return (laneValues[0] + laneValues[1]) + (laneValues[2] + laneValues[3]);
+}
+
+/** Helper function that computes the dot product of two columns of a block
+ * using 256-bit AVX2 vector instructions.
+ *
+ * \param firstColumn - A pointer to the first value of one column.
+ * \param secondColumn - A pointer to the first value of the other column.
+ * \param rowCount - The number of values in each column, which must be a
+ * multiple of eight.
+ *
+ * \return The sum of the products of the corresponding values.
+ */
+__attribute__((target("avx2,fma")))
+static double avx2DotProduct(const double * firstColumn, const double * secondColumn,
+                             std::size_t rowCount){
+    __m256d products0 = _mm256_setzero_pd(), products1 = _mm256_setzero_pd();
+    for(std::size_t row = 0; row < rowCount; row += 8){
+        products0 = _mm256_fmadd_pd(_mm256_loadu_pd(firstColumn + row),
+                                    _mm256_loadu_pd(secondColumn + row), products0);
+        products1 = _mm256_fmadd_pd(_mm256_loadu_pd(firstColumn + row + 4),
+                                    _mm256_loadu_pd(secondColumn + row + 4), products1);
+    }
+    return avx2LaneSum(_mm256_add_pd(products0, products1));
+}
+
+/** Kernel that adds the sums of the products of every pair of columns of a
+ * block of values to the upper triangle of a matrix using 256-bit AVX2
+ * vector instructions.
+ *
+ * \param block - A pointer to the first value of the block, whose columns
+ * are stored one after another.
+ * \param columnCount - The number of columns in the block.
+ * \param rowCount - The number of values in each column, which must be a
+ * multiple of eight.
+ * \param columnStride - The distance between the first values of successive
+ * columns, which must not be less than "rowCount".
+ * \param crossProducts - A pointer to the first element of a square matrix
+ * with "columnCount" rows, stored row by row, to whose elements on and
+ * above the diagonal the sums are added.
+ *
+ * Computing each dot product separately would load two values for every
+ * multiplication, so the speed would be limited by the rate at which values
+ * can be loaded rather than by the rate of arithmetic. Instead a tile of
+ * four columns is multiplied by two columns at once: each group of four
+ * rows is loaded once from each of the six columns, and used by eight
+ * fused multiply-add instructions that update eight vector accumulators
+ * held in registers. Tiles that straddle the diagonal also compute a few
+ * products below it, which are discarded. The columns that do not fill a
+ * complete tile are processed by avx2DotProduct().
+ *
+ * \note The "target" attribute instructs the compiler to generate AVX2 and
+ * FMA instructions for this function only. It must therefore only be called
+ * after verifying that the current processor supports them.
+ */
+__attribute__((target("avx2,fma")))
+static void avx2CrossProducts(const double * block, std::size_t columnCount,
+                              std::size_t rowCount, std::size_t columnStride,
+                              double * crossProducts){
+    std::size_t first(0);
+    for(; first + 4 <= columnCount; first += 4){
+        const double * first0 = block + first*columnStride;
+        const double * first1 = first0 + columnStride;
+        const double * first2 = first1 + columnStride;
+        const double * first3 = first2 + columnStride;
+        double * productRow = crossProducts + first*columnCount;
+        
+        // Multiply the four columns by successive pairs of columns.
+        std::size_t second(first);
+        for(; second + 2 <= columnCount; second += 2){
+            const double * second0 = block + second*columnStride;
+            const double * second1 = second0 + columnStride;
+            __m256d products00 = _mm256_setzero_pd(), products01 = _mm256_setzero_pd();
+            __m256d products10 = _mm256_setzero_pd(), products11 = _mm256_setzero_pd();
+            __m256d products20 = _mm256_setzero_pd(), products21 = _mm256_setzero_pd();
+            __m256d products30 = _mm256_setzero_pd(), products31 = _mm256_setzero_pd();
+            for(std::size_t row = 0; row < rowCount; row += 4){
+                __m256d secondValues0 = _mm256_loadu_pd(second0 + row);
+                __m256d secondValues1 = _mm256_loadu_pd(second1 + row);
+                __m256d firstValues = _mm256_loadu_pd(first0 + row);
+                products00 = _mm256_fmadd_pd(firstValues, secondValues0, products00);
+                products01 = _mm256_fmadd_pd(firstValues, secondValues1, products01);
+                firstValues = _mm256_loadu_pd(first1 + row);
+                products10 = _mm256_fmadd_pd(firstValues, secondValues0, products10);
+                products11 = _mm256_fmadd_pd(firstValues, secondValues1, products11);
+                firstValues = _mm256_loadu_pd(first2 + row);
+                products20 = _mm256_fmadd_pd(firstValues, secondValues0, products20);
+                products21 = _mm256_fmadd_pd(firstValues, secondValues1, products21);
+                firstValues = _mm256_loadu_pd(first3 + row);
+                products30 = _mm256_fmadd_pd(firstValues, secondValues0, products30);
+                products31 = _mm256_fmadd_pd(firstValues, secondValues1, products31);
+            }
+            
+            // Store only the sums on or above the diagonal.
+            double tileSums[4][2] = {{avx2LaneSum(products00), avx2LaneSum(products01)},
+                                     {avx2LaneSum(products10), avx2LaneSum(products11)},
+                                     {avx2LaneSum(products20), avx2LaneSum(products21)},
+                                     {avx2LaneSum(products30), avx2LaneSum(products31)}};
+            for(std::size_t tileRow = 0; tileRow < 4; ++tileRow){
+                for(std::size_t tileColumn = 0; tileColumn < 2; ++tileColumn){
+                    if(second + tileColumn >= first + tileRow){
+                        productRow[tileRow*columnCount + second + tileColumn] +=
+                            tileSums[tileRow][tileColumn];
+                    }
+                }
+            }
+        }
+        
+        // Process the final column, if the number of columns is odd.
+        if(second < columnCount){
+            const double * second0 = block + second*columnStride;
+            productRow[second] += avx2DotProduct(first0, second0, rowCount);
+            productRow[columnCount + second] += avx2DotProduct(first1, second0, rowCount);
+            productRow[2*columnCount + second] += avx2DotProduct(first2, second0, rowCount);
+            productRow[3*columnCount + second] += avx2DotProduct(first3, second0, rowCount);
+        }
+    }
+    
+    // Process the final (at most three) columns individually.
+    for(; first < columnCount; ++first){
+        for(std::size_t second = first; second < columnCount; ++second){
+            crossProducts[first*columnCount + second] +=
+                avx2DotProduct(block + first*columnStride, block + second*columnStride,
+                               rowCount);
+        }
+    }
+}
+
+/** Helper function that adds the eight lanes of a 512-bit vector in a fixed
+ * order.
+ *
+ * \param lanes - The vector.
+ *
+ * \return The sum of the lanes.
+ */
+__attribute__((target("avx512f")))
+static inline double avx512LaneSum(__m512d lanes){
+    double laneValues[8];
+    _mm512_storeu_pd(laneValues, lanes);
+    return ((laneValues[0] + laneValues[1]) + (laneValues[2] + laneValues[3])) +
+           ((laneValues[4] + laneValues[5]) + (laneValues[6] + laneValues[7]));
+}
+
+/** Helper function that computes the dot product of two columns of a block
+ * using 512-bit AVX-512F vector instructions.
+ *
+ * \param firstColumn - A pointer to the first value of one column.
+ * \param secondColumn - A pointer to the first value of the other column.
+ * \param rowCount - The number of values in each column, which must be a
+ * multiple of eight.
+ *
+ * \return The sum of the products of the corresponding values.
+ */
+__attribute__((target("avx512f")))
+static double avx512DotProduct(const double * firstColumn, const double * secondColumn,
+                               std::size_t rowCount){
+    __m512d products = _mm512_setzero_pd();
+    for(std::size_t row = 0; row < rowCount; row += 8){
+        products = _mm512_fmadd_pd(_mm512_loadu_pd(firstColumn + row),
+                                   _mm512_loadu_pd(secondColumn + row), products);
+    }
+    return avx512LaneSum(products);
+}
+
+/** Kernel that adds the sums of the products of every pair of columns of a
+ * block of values to the upper triangle of a matrix using 512-bit AVX-512F
+ * vector instructions.
+ *
+ * \param block - A pointer to the first value of the block, whose columns
+ * are stored one after another.
+ * \param columnCount - The number of columns in the block.
+ * \param rowCount - The number of values in each column, which must be a
+ * multiple of eight.
+ * \param columnStride - The distance between the first values of successive
+ * columns, which must not be less than "rowCount".
+ * \param crossProducts - A pointer to the first element of a square matrix
+ * with "columnCount" rows, stored row by row, to whose elements on and
+ * above the diagonal the sums are added.
+ *
+ * The columns are multiplied in tiles of four by two columns, as in
+ * avx2CrossProducts(), but each instruction operates on eight rows.
+ *
+ * \note The "target" attribute instructs the compiler to generate AVX-512F
+ * instructions for this function only. It must therefore only be called
+ * after verifying that the current processor supports them.
+ */
+__attribute__((target("avx512f")))
+static void avx512CrossProducts(const double * block, std::size_t columnCount,
+                                std::size_t rowCount, std::size_t columnStride,
+                                double * crossProducts){
+    std::size_t first(0);
+    for(; first + 4 <= columnCount; first += 4){
+        const double * first0 = block + first*columnStride;
+        const double * first1 = first0 + columnStride;
+        const double * first2 = first1 + columnStride;
+        const double * first3 = first2 + columnStride;
+        double * productRow = crossProducts + first*columnCount;
+        
+        // Multiply the four columns by successive pairs of columns.
+        std::size_t second(first);
+        for(; second + 2 <= columnCount; second += 2){
+            const double * second0 = block + second*columnStride;
+            const double * second1 = second0 + columnStride;
+            __m512d products00 = _mm512_setzero_pd(), products01 = _mm512_setzero_pd();
+            __m512d products10 = _mm512_setzero_pd(), products11 = _mm512_setzero_pd();
+            __m512d products20 = _mm512_setzero_pd(), products21 = _mm512_setzero_pd();
+            __m512d products30 = _mm512_setzero_pd(), products31 = _mm512_setzero_pd();
+            for(std::size_t row = 0; row < rowCount; row += 8){
+                __m512d secondValues0 = _mm512_loadu_pd(second0 + row);
+                __m512d secondValues1 = _mm512_loadu_pd(second1 + row);
+                __m512d firstValues = _mm512_loadu_pd(first0 + row);
+                products00 = _mm512_fmadd_pd(firstValues, secondValues0, products00);
+                products01 = _mm512_fmadd_pd(firstValues, secondValues1, products01);
+                firstValues = _mm512_loadu_pd(first1 + row);
+                products10 = _mm512_fmadd_pd(firstValues, secondValues0, products10);
+                products11 = _mm512_fmadd_pd(firstValues, secondValues1, products11);
+                firstValues = _mm512_loadu_pd(first2 + row);
+                products20 = _mm512_fmadd_pd(firstValues, secondValues0, products20);
+                products21 = _mm512_fmadd_pd(firstValues, secondValues1, products21);
+                firstValues = _mm512_loadu_pd(first3 + row);
+                products30 = _mm512_fmadd_pd(firstValues, secondValues0, products30);
+                products31 = _mm512_fmadd_pd(firstValues, secondValues1, products31);
+            }
+            
+            // Store only the sums on or above the diagonal.
+            double tileSums[4][2] = {{avx512LaneSum(products00), avx512LaneSum(products01)},
+                                     {avx512LaneSum(products10), avx512LaneSum(products11)},
+                                     {avx512LaneSum(products20), avx512LaneSum(products21)},
+                                     {avx512LaneSum(products30), avx512LaneSum(products31)}};
+            for(std::size_t tileRow = 0; tileRow < 4; ++tileRow){
+                for(std::size_t tileColumn = 0; tileColumn < 2; ++tileColumn){
+                    if(second + tileColumn >= first + tileRow){
+                        productRow[tileRow*columnCount + second + tileColumn] +=
+                            tileSums[tileRow][tileColumn];
+                    }
+                }
+            }
+        }
+        
+        // Process the final column, if the number of columns is odd.
+        if(second < columnCount){
+            const double * second0 = block + second*columnStride;
+            productRow[second] += avx512DotProduct(first0, second0, rowCount);
+            productRow[columnCount + second] += avx512DotProduct(first1, second0, rowCount);
+            productRow[2*columnCount + second] += avx512DotProduct(first2, second0, rowCount);
+            productRow[3*columnCount + second] += avx512DotProduct(first3, second0, rowCount);
+        }
+    }
+    
+    // Process the final (at most three) columns individually.
+    for(; first < columnCount; ++first){
+        for(std::size_t second = first; second < columnCount; ++second){
+            crossProducts[first*columnCount + second] +=
+                avx512DotProduct(block + first*columnStride, block + second*columnStride,
+                               rowCount);
+        }
+    }
+}
+
+#endif /* End #ifdef REDUCTION_KERNELS_X86 preprocessor conditional block. */
+
+// DISPATCH FUNCTIONS
+
+/** Helper function that queries the processor on which the program is
+ * currently running for the most capable instruction set that it supports.
+ *
+ * \return AVX512_REDUCTION if AVX-512F is supported, otherwise AVX2_REDUCTION
+ * if both AVX2 and FMA are supported, otherwise SCALAR_REDUCTION.
+ *
+ * \note The GCC built-in function __builtin_cpu_supports queries the
+ * processor at run time, so a single executable selects the best kernel on
+ * every machine on which it runs.
+ */
+static ReductionInstructionSet queryProcessorInstructionSet(){
+#ifdef REDUCTION_KERNELS_X86
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx512f")){
+        return AVX512_REDUCTION;
+    }
+    if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")){
+        return AVX2_REDUCTION;
+    }
+#endif
+    return SCALAR_REDUCTION;
+}
+
+/** Function that returns the most capable instruction set supported by the
+ * processor on which the program is currently running.
+ *
+ * \return The instruction set identified by queryProcessorInstructionSet().
+ *
+ * \note The processor is queried only once, when this function is first
+ * called. C++ guarantees that the initialization of a static local variable
+ * is performed exactly once, even if several threads call the function
+ * concurrently.
+ */
+ReductionInstructionSet detectReductionInstructionSet(){
+    static const ReductionInstructionSet detectedInstructionSet =
+        queryProcessorInstructionSet();
+    return detectedInstructionSet;
+}
+
+/** Function that determines whether the processor on which the program is
+ * currently running supports a particular instruction set.
+ *
+ * \param instructionSet - The instruction set to be queried.
+ *
+ * \return true if kernels for the instruction set may be executed.
+ */
+bool isReductionInstructionSetSupported(ReductionInstructionSet instructionSet){
+    
+    // The instruction sets are enumerated in order of increasing capability.
+    return instructionSet <= detectReductionInstructionSet();
+}
+
+/** Function that returns a short, human-readable name for an instruction set.
+ *
+ * \param instructionSet - The instruction set to be named.
+ *
+ * \return A C-String containing the name.
+ */
+const char * getReductionInstructionSetName(ReductionInstructionSet instructionSet){
+    switch(instructionSet){
+        case AVX2_REDUCTION:
+            return "AVX2";
+        case AVX512_REDUCTION:
+            return "AVX-512";
+        default:
+            return "scalar";
+    }
+}
+
+/** Helper function that computes the sums of the first four powers of the
+ * deviations of the elements of an array from a shift value, and the
+ * smallest and largest elements, in a single pass using the kernel for a
+ * caller-specified instruction set.
+ *
+ * \param instructionSet - The instruction set whose kernel should be used.
+ * \param values - A pointer to the first element of the array.
+ * \param count - The number of elements in the array.
+ * \param shift - The value that is subtracted from every element.
+ * \param sums - A reference to a structure that receives the results.
+ *
+ * The type of the elements is a template parameter, so each of the public
+ * overloads of shiftedMomentSums() dispatches at run time among the
+ * kernels that the compiler generated for its own element type.
+ *
+ * \note For a given instruction set the elements are always combined in the
+ * same order, so repeated calls produce bit-identical results. Different
+ * instruction sets combine the elements in different orders, so their
+ * results may differ in the last few bits.
+ *
+ * \note If the requested instruction set is not supported by the current
+ * processor, the scalar kernel is used instead.
+ */
+template<typename Element>
+static void dispatchMomentSums(ReductionInstructionSet instructionSet,
+                               const Element * values, std::size_t count, double shift,
+                               ShiftedMomentSums & sums){
+#ifdef REDUCTION_KERNELS_X86
+    if(isReductionInstructionSetSupported(instructionSet)){
+        switch(instructionSet){
+            case AVX512_REDUCTION:
+                avx512MomentSums(values, count, shift, sums);
+                return;
+            case AVX2_REDUCTION:
+                avx2MomentSums(values, count, shift, sums);
+                return;
+            default:
+                break;
+        }
+    }
+#endif
+    scalarMomentSums(values, count, shift, sums);
+}
+
+/** Function that computes the sums of the first four powers of the
+ * deviations of the elements of an array from a shift value, and the
+ * smallest and largest elements, in a single pass using the most capable
+ * supported kernel.
+ *
+ * \param values - A pointer to the first element of the array.
+ * \param count - The number of elements in the array.
+ * \param shift - The value that is subtracted from every element.
+ * \param sums - A reference to a structure that receives the results.
+ */
+void shiftedMomentSums(const double * values, std::size_t count, double shift,
+                       ShiftedMomentSums & sums){
+    dispatchMomentSums(detectReductionInstructionSet(), values, count, shift, sums);
+}
+
+/** Function that computes the sums of the first four powers of the
+ * deviations of the elements of an array of single precision values from a
+ * shift value, and the smallest and largest elements, in a single pass
+ * using the most capable supported kernel.
+ *
+ * \param values - A pointer to the first element of the array.
+ * \param count - The number of elements in the array.
+ * \param shift - The value that is subtracted from every element.
+ * \param sums - A reference to a structure that receives the results.
+ */
+void shiftedMomentSums(const float * values, std::size_t count, double shift,
+                       ShiftedMomentSums & sums){
+    dispatchMomentSums(detectReductionInstructionSet(), values, count, shift, sums);
+}
+
+/** Function that computes the sums of the first four powers of the
+ * deviations of the elements of an array of 64-bit integers from a shift
+ * value, and the smallest and largest elements, in a single pass using the
+ * most capable supported kernel.
+ *
+ * \param values - A pointer to the first element of the array.
+ * \param count - The number of elements in the array.
+ * \param shift - The value that is subtracted from every element.
+ * \param sums - A reference to a structure that receives the results.
+ */
+void shiftedMomentSums(const std::int64_t * values, std::size_t count, double shift,
+                       ShiftedMomentSums & sums){
+    dispatchMomentSums(detectReductionInstructionSet(), values, count, shift, sums);
+}
+
+/** Function that computes the sums of the first four powers of the
+ * deviations of the elements of an array from a shift value, and the
+ * smallest and largest elements, in a single pass using the kernel for a
+ * caller-specified instruction set.
+ *
+ * \param instructionSet - The instruction set whose kernel should be used.
+ * \param values - A pointer to the first element of the array.
+ * \param count - The number of elements in the array.
+ * \param shift - The value that is subtracted from every element.
+ * \param sums - A reference to a structure that receives the results.
+ */
+void shiftedMomentSums(ReductionInstructionSet instructionSet,
+                       const double * values, std::size_t count, double shift,
+                       ShiftedMomentSums & sums){
+    dispatchMomentSums(instructionSet, values, count, shift, sums);
+}
+
+/** Function that computes the sums of the first four powers of the
+ * deviations of the elements of an array of single precision values from a
+ * shift value, and the smallest and largest elements, in a single pass
+ * using the kernel for a caller-specified instruction set.
+ *
+ * \param instructionSet - The instruction set whose kernel should be used.
+ * \param values - A pointer to the first element of the array.
+ * \param count - The number of elements in the array.
+ * \param shift - The value that is subtracted from every element.
+ * \param sums - A reference to a structure that receives the results.
+ */
+void shiftedMomentSums(ReductionInstructionSet instructionSet,
+                       const float * values, std::size_t count, double shift,
+                       ShiftedMomentSums & sums){
+    dispatchMomentSums(instructionSet, values, count, shift, sums);
+}
+
+/** Function that computes the sums of the first four powers of the
+ * deviations of the elements of an array of 64-bit integers from a shift
+ * value, and the smallest and largest elements, in a single pass using the
+ * kernel for a caller-specified instruction set.
+ *
+ * \param instructionSet - The instruction set whose kernel should be used.
+ * \param values - A pointer to the first element of the array.
+ * \param count - The number of elements in the array.
+ * \param shift - The value that is subtracted from every element.
+ * \param sums - A reference to a structure that receives the results.
+ */
+void shiftedMomentSums(ReductionInstructionSet instructionSet,
+                       const std::int64_t * values, std::size_t count, double shift,
+                       ShiftedMomentSums & sums){
+    dispatchMomentSums(instructionSet, values, count, shift, sums);
+}
+
+/** Function that adds the sums of the products of every pair of columns of
+ * a block of values to the upper triangle of a matrix using the most
+ * capable supported kernel.
+ *
+ * \param block - A pointer to the first value of the block, whose columns
+ * are stored one after another.
+ * \param columnCount - The number of columns in the block.
+ * \param rowCount - The number of values in each column, which must be a
+ * multiple of eight.
+ * \param columnStride - The distance between the first values of successive
+ * columns.
+ * \param crossProducts - A pointer to the first element of a square matrix
+ * with "columnCount" rows, stored row by row.
+ */
+void addCrossProducts(const double * block, std::size_t columnCount, std::size_t rowCount,
+                      std::size_t columnStride, double * crossProducts){
+    addCrossProducts(detectReductionInstructionSet(), block, columnCount, rowCount,
+                     columnStride, crossProducts);
+}
+
+/** Function that adds the sums of the products of every pair of columns of
+ * a block of values to the upper triangle of a matrix using the kernel for
+ * a caller-specified instruction set.
+ *
+ * \param instructionSet - The instruction set whose kernel should be used.
+ * \param block - A pointer to the first value of the block, whose columns
+ * are stored one after another.
+ * \param columnCount - The number of columns in the block.
+ * \param rowCount - The number of values in each column, which must be a
+ * multiple of eight.
+ * \param columnStride - The distance between the first values of successive
+ * columns.
+ * \param crossProducts - A pointer to the first element of a square matrix
+ * with "columnCount" rows, stored row by row.
+ *
+ * \note As for shiftedMomentSums(), the results are bit-identical
+ * for a given instruction set, and the scalar kernel is used if the
+ * requested instruction set is not supported.
+ */
+void addCrossProducts(ReductionInstructionSet instructionSet,
+                      const double * block, std::size_t columnCount, std::size_t rowCount,
+                      std::size_t columnStride, double * crossProducts){
+#ifdef REDUCTION_KERNELS_X86
+    if(isReductionInstructionSetSupported(instructionSet)){
+        switch(instructionSet){
+            case AVX512_REDUCTION:
+                avx512CrossProducts(block, columnCount, rowCount, columnStride, crossProducts);
+                return;
+            case AVX2_REDUCTION:
+                avx2CrossProducts(block, columnCount, rowCount, columnStride, crossProducts);
+                return;
+            default:
+                break;
+        }
+    }
+#endif
+    scalarCrossProducts(block, columnCount, rowCount, columnStride, crossProducts);
+}
@@ -0,0 +1,470 @@
+// IMPLEMENTATION file for StatsAccumulator class
+
+// STL HEADER FILES
+
+// The <cmath> header is included to provide the std::sqrt(...) function.
+#include <cmath>
+// The <cstring> header is included to provide the std::memcpy(...) function.
+#include <cstring>
+// The <limits> header is included to provide the std::numeric_limits type.
+#include <limits>
+/* The <istream> and <ostream> headers are included to provide the read(...)
+ * and write(...) methods of std::istream and std::ostream.
+ */
+#include <istream>
+#include <ostream>
+
+// LOCAL HEADER FILES
+
+/* The "StatsAccumulator.h" header is included to provide a definition of the
+ * StatsAccumulator class.
+ */
+#include "StatsAccumulator.h"
+
+/* The "ReductionKernels.h" header is included to provide the vectorized
+ * shiftedMomentSums(...) function.
+ */
+#include "ReductionKernels.h"
+
+/* The "ByteOrder.h" header is included to provide functions that store and
+ * load values in little-endian byte order.
+ */
+#include "ByteOrder.h"
+
+// CONSTANTS
+
+/* The four characters that identify a state record, followed by the version
+ * of its layout. The version must be incremented whenever the layout changes,
+ * so that records written by an older program are rejected rather than
+ * misinterpreted.
+ */
+static const char stateRecordMagic[4] = {'S', 'C', 'A', 'S'};
+static const std::uint32_t stateRecordVersion = 2;
+
+/* addValues() processes arrays in blocks of this many values, so that the
+ * deviations of all but the first block are measured from an accurate
+ * running mean.
+ */
+static const std::size_t momentBlockSize = 4096;
+
+/* Definition of the static constant member that holds the number of bytes
+ * in a state record, whose value is specified in the class definition.
+ */
+const std::size_t StatsAccumulator::stateRecordSize;
+
+// PUBLIC METHODS OF STATSACCUMULATOR
+
+/** Default constructor for the StatsAccumulator class.
+ *
+ * Zero-initializes the running statistics, and initializes the minimum and
+ * maximum to positive and negative infinity respectively, so that the
+ * accumulator represents an empty sequence of values.
+ */
+StatsAccumulator::StatsAccumulator() : count(0), sum(0.0), mean(0.0),
+                                       sumOfSquaredDeviations(0.0),
+                                       sumOfCubedDeviations(0.0),
+                                       sumOfFourthPowerDeviations(0.0),
+                                       minimum(std::numeric_limits<double>::infinity()),
+                                       maximum(-std::numeric_limits<double>::infinity()) {
+    // No further initialization operations are required.
+}
+
+/** Public method that adds a single value to the running statistics.
+ *
+ * \param value - The value to be added.
+ *
+ * The running mean and sums of powers of the deviations are updated using
+ * the method of Welford, as extended to higher powers by Terriberry, in
+ * which \f$ \delta = x_{n} - \bar{x}_{n-1} \f$.
+ *
+ * \f[ \bar{x}_{n} = \bar{x}_{n-1} + \frac{\delta}{n}, \qquad
+ *     M_{2,n} = M_{2,n-1} + \delta^{2} \frac{n - 1}{n} \f]
+ * \f[ M_{3,n} = M_{3,n-1} + \delta^{3} \frac{(n - 1)(n - 2)}{n^{2}}
+ *     - 3 \frac{\delta}{n} M_{2,n-1} \f]
+ * \f[ M_{4,n} = M_{4,n-1} + \delta^{4} \frac{(n - 1)(n^{2} - 3n + 3)}{n^{3}}
+ *     + 6 \frac{\delta^{2}}{n^{2}} M_{2,n-1} - 4 \frac{\delta}{n} M_{3,n-1} \f]
+ */
+void StatsAccumulator::addValue(double value){
+    double previousWeight = static_cast<double>(count);
+    ++count;
+    double weight = static_cast<double>(count);
+    sum += value;
+    
+    // Compute the scaled deviation once, since it appears in every update.
+    double delta = value - mean;
+    double scaledDelta = delta/weight;
+    double scaledDeltaSquared = scaledDelta*scaledDelta;
+    double term = delta*scaledDelta*previousWeight;
+    
+    /* Update the highest power first, since each update uses the previous
+     * values of the lower powers.
+     */
+    mean += scaledDelta;
+    sumOfFourthPowerDeviations += term*scaledDeltaSquared*(weight*weight - 3.0*weight + 3.0) +
+        6.0*scaledDeltaSquared*sumOfSquaredDeviations - 4.0*scaledDelta*sumOfCubedDeviations;
+    sumOfCubedDeviations += term*scaledDelta*(weight - 2.0) -
+        3.0*scaledDelta*sumOfSquaredDeviations;
+    sumOfSquaredDeviations += term;
+    
+    // Update the extreme values.
+    if(value < minimum){
+        minimum = value;
+    }
+    if(value > maximum){
+        maximum = value;
+    }
+}
+
+/** Private method that adds an array of values of any supported type to the
+ * running statistics.
+ *
+ * \param values - A pointer to the first element of the array.
+ * \param valueCount - The number of elements in the array.
+ *
+ * The type of the elements is a template parameter, which selects the
+ * overload of shiftedMomentSums(...), and so the vectorized kernels, for
+ * that type at compile time. Every statistic is accumulated in double
+ * precision whatever the type of the elements.
+ *
+ * The array is processed in blocks of "momentBlockSize" values. The sums of
+ * the first four powers of the deviations of each block from a shift value
+ * K, together with its smallest and largest values, are computed in a
+ * single pass by the vectorized shiftedMomentSums(...) function. The
+ * statistics of the block are derived from these and then merged with the
+ * running statistics by merge().
+ *
+ * The shift value is the running mean if any values have already been
+ * accumulated and the first element of the array otherwise. For a shift
+ * value close to the mean of the block the shifted sums \f$ S_{k} \f$ are
+ * small, and the sums of powers of the deviations from the mean of the
+ * block, whose deviation from the shift value is \f$ d = S_{1}/n \f$,
+ *
+ * \f[ M_{2} = S_{2} - n d^{2}, \qquad M_{3} = S_{3} - 3 d S_{2} + 2 n d^{3}, \f]
+ * \f[ M_{4} = S_{4} - 4 d S_{3} + 6 d^{2} S_{2} - 3 n d^{4} \f]
+ *
+ * are obtained without the loss of precision of the unshifted formulae.
+ * This provides the accuracy of a two-pass algorithm at the cost of one
+ * pass.
+ */
+template<typename Element>
+void StatsAccumulator::addElements(const Element * values, std::size_t valueCount){
+    for(std::size_t blockBegin = 0; blockBegin < valueCount; blockBegin += momentBlockSize){
+        std::size_t blockCount = valueCount - blockBegin;
+        if(blockCount > momentBlockSize){
+            blockCount = momentBlockSize;
+        }
+        
+        // Choose the shift value...
+        double shift = (count > 0) ? mean : static_cast<double>(values[blockBegin]);
+        
+        // ...and compute the shifted sums for the block alone.
+        ShiftedMomentSums shiftedSums;
+        shiftedMomentSums(values + blockBegin, blockCount, shift, shiftedSums);
+        
+        // Derive the statistics of the block.
+        double blockWeight = static_cast<double>(blockCount);
+        double meanDeviation = shiftedSums.sum/blockWeight;
+        StatsAccumulator blockStatistics;
+        blockStatistics.count = blockCount;
+        blockStatistics.sum = shift*blockWeight + shiftedSums.sum;
+        blockStatistics.mean = shift + meanDeviation;
+        blockStatistics.sumOfSquaredDeviations =
+            shiftedSums.sumOfSquares - shiftedSums.sum*meanDeviation;
+        blockStatistics.sumOfCubedDeviations =
+            shiftedSums.sumOfCubes - 3.0*meanDeviation*shiftedSums.sumOfSquares +
+            2.0*blockWeight*meanDeviation*meanDeviation*meanDeviation;
+        blockStatistics.sumOfFourthPowerDeviations =
+            shiftedSums.sumOfFourthPowers - 4.0*meanDeviation*shiftedSums.sumOfCubes +
+            6.0*meanDeviation*meanDeviation*shiftedSums.sumOfSquares -
+            3.0*blockWeight*meanDeviation*meanDeviation*meanDeviation*meanDeviation;
+        blockStatistics.minimum = shiftedSums.minimum;
+        blockStatistics.maximum = shiftedSums.maximum;
+        
+        /* Rounding may produce a tiny negative result if every deviation is
+         * almost identical, so clamp the even powers to zero.
+         */
+        if(blockStatistics.sumOfSquaredDeviations < 0.0){
+            blockStatistics.sumOfSquaredDeviations = 0.0;
+        }
+        if(blockStatistics.sumOfFourthPowerDeviations < 0.0){
+            blockStatistics.sumOfFourthPowerDeviations = 0.0;
+        }
+        
+        merge(blockStatistics);
+    }
+}
+
+/** Public method that adds an array of values to the running statistics.
+ *
+ * \param values - A pointer to the first element of the array.
+ * \param valueCount - The number of elements in the array.
+ */
+void StatsAccumulator::addValues(const double * values, std::size_t valueCount){
+    addElements(values, valueCount);
+}
+
+/** Public method that adds an array of single precision values to the
+ * running statistics.
+ *
+ * \param values - A pointer to the first element of the array.
+ * \param valueCount - The number of elements in the array.
+ */
+void StatsAccumulator::addValues(const float * values, std::size_t valueCount){
+    addElements(values, valueCount);
+}
+
+/** Public method that adds an array of 64-bit integers to the running
+ * statistics.
+ *
+ * \param values - A pointer to the first element of the array.
+ * \param valueCount - The number of elements in the array.
+ */
+void StatsAccumulator::addValues(const std::int64_t * values, std::size_t valueCount){
+    addElements(values, valueCount);
+}
+
+/** Public method that adds the running statistics of another accumulator
+ * to those of this accumulator.
+ *
+ * \param other - The accumulator whose statistics should be added.
+ *
+ * After merging, this accumulator describes the concatenation of the two
+ * sequences of values, A and B. The mean and sums of powers of the
+ * deviations of the combined sequence are obtained using the pairwise
+ * update of Chan, Golub and LeVeque, as extended to higher powers by Pebay,
+ * in which \f$ \delta \f$ denotes the difference between the two means.
+ *
+ * \f[ \bar{x} = \bar{x}_{A} + \delta \frac{n_{B}}{n}, \qquad
+ *     M_{2} = M_{2,A} + M_{2,B} + \delta^{2} \frac{n_{A} n_{B}}{n} \f]
+ * \f[ M_{3} = M_{3,A} + M_{3,B} + \delta^{3} \frac{n_{A} n_{B} (n_{A} - n_{B})}{n^{2}}
+ *     + 3 \delta \frac{n_{A} M_{2,B} - n_{B} M_{2,A}}{n} \f]
+ * \f[ M_{4} = M_{4,A} + M_{4,B}
+ *     + \delta^{4} \frac{n_{A} n_{B} (n_{A}^{2} - n_{A} n_{B} + n_{B}^{2})}{n^{3}}
+ *     + 6 \delta^{2} \frac{n_{A}^{2} M_{2,B} + n_{B}^{2} M_{2,A}}{n^{2}}
+ *     + 4 \delta \frac{n_{A} M_{3,B} - n_{B} M_{3,A}}{n} \f]
+ */
+void StatsAccumulator::merge(const StatsAccumulator & other){
+    
+    // Nothing needs to be done if the other sequence is empty.
+    if(other.count == 0){
+        return;
+    }
+    
+    // If this accumulator is empty, simply adopt the other statistics.
+    if(count == 0){
+        *this = other;
+        return;
+    }
+    
+    /* Convert the counts to double precision once, since they appear in
+     * several floating-point expressions.
+     */
+    double thisWeight = static_cast<double>(count);
+    double otherWeight = static_cast<double>(other.count);
+    double combinedWeight = thisWeight + otherWeight;
+    
+    /* Apply the pairwise update formulae, updating the highest power first,
+     * since each update uses the previous values of the lower powers.
+     */
+    double delta = other.mean - mean;
+    double scaledDelta = delta/combinedWeight;
+    double scaledDeltaSquared = scaledDelta*scaledDelta;
+    double weightProduct = thisWeight*otherWeight;
+    sumOfFourthPowerDeviations += other.sumOfFourthPowerDeviations +
+        delta*scaledDelta*scaledDeltaSquared*weightProduct*
+        (thisWeight*thisWeight - weightProduct + otherWeight*otherWeight) +
+        6.0*scaledDeltaSquared*(thisWeight*thisWeight*other.sumOfSquaredDeviations +
+                                otherWeight*otherWeight*sumOfSquaredDeviations) +
+        4.0*scaledDelta*(thisWeight*other.sumOfCubedDeviations -
+                         otherWeight*sumOfCubedDeviations);
+    sumOfCubedDeviations += other.sumOfCubedDeviations +
+        delta*scaledDeltaSquared*weightProduct*(thisWeight - otherWeight) +
+        3.0*scaledDelta*(thisWeight*other.sumOfSquaredDeviations -
+                         otherWeight*sumOfSquaredDeviations);
+    sumOfSquaredDeviations += other.sumOfSquaredDeviations +
+        delta*scaledDelta*weightProduct;
+    mean += scaledDelta*otherWeight;
+    sum += other.sum;
+    count += other.count;
+    
+    // Combine the extreme values.
+    if(other.minimum < minimum){
+        minimum = other.minimum;
+    }
+    if(other.maximum > maximum){
+        maximum = other.maximum;
+    }
+}
+
+/** Public method returns the number of values that have been accumulated.
+ *
+ * \return The number of values as an unsigned integer.
+ */
+std::size_t StatsAccumulator::getCount() const {
+    return count;
+}
+
+/** Public method returns a summary of the statistical properties of the
+ * values that have been accumulated.
+ *
+ * \return A StatsSummary structure containing the number of values, their
+ * sum, mean, variance, standard deviation, minimum, maximum, skewness and
+ * excess kurtosis. If no values have been accumulated, every member is
+ * zero. If every value is identical, the skewness and excess kurtosis are
+ * undefined, and are NaN.
+ *
+ * The (population) variance is the mean squared deviation from the mean,
+ * and the skewness and excess kurtosis are the corresponding (population)
+ * standardized third and fourth moments.
+ *
+ * \f[ \sigma^{2} = \frac{M_{2}}{N}, \qquad
+ *     g_{1} = \frac{\sqrt{N} M_{3}}{M_{2}^{3/2}}, \qquad
+ *     g_{2} = \frac{N M_{4}}{M_{2}^{2}} - 3 \f]
+ */
+StatsSummary StatsAccumulator::getSummary() const {
+    
+    /* Declare a StatsSummary structure with identifier "summary" and
+     * zero-initialize all of its members using an empty initializer list.
+     */
+    StatsSummary summary = {};
+    summary.count = count;
+    summary.sum = sum;
+    
+    // If any values have been accumulated...
+    if(count > 0){
+        
+        /* Compute the variance from the sum of squared deviations, and its
+         * square root using the STL function std::sqrt provided by the
+         * <cmath> header file.
+         */
+        summary.mean = mean;
+        summary.variance = sumOfSquaredDeviations/count;
+        summary.standardDeviation = std::sqrt(summary.variance);
+        summary.minimum = minimum;
+        summary.maximum = maximum;
+        
+        // The skewness and kurtosis are undefined without any variation.
+        if(sumOfSquaredDeviations > 0.0){
+            double weight = static_cast<double>(count);
+            summary.skewness = std::sqrt(weight)*sumOfCubedDeviations/
+                (sumOfSquaredDeviations*std::sqrt(sumOfSquaredDeviations));
+            summary.excessKurtosis = weight*sumOfFourthPowerDeviations/
+                (sumOfSquaredDeviations*sumOfSquaredDeviations) - 3.0;
+        }
+        else{
+            summary.skewness = std::numeric_limits<double>::quiet_NaN();
+            summary.excessKurtosis = std::numeric_limits<double>::quiet_NaN();
+        }
+    }
+    
+    return summary;
+}
+
+/** Public method that stores the running statistics in a buffer as a
+ * fixed-size state record.
+ *
+ * \param record - A pointer to the first of the "stateRecordSize" bytes to
+ * be written.
+ *
+ * The record comprises 72 bytes: the four characters "SCAS", the version of
+ * the layout as a 32-bit unsigned integer, the count as a 64-bit unsigned
+ * integer, and the sum, mean, sums of the second, third and fourth powers of
+ * the deviations, minimum and maximum as IEEE 754 double-precision values.
+ * Every field is stored in little-endian byte order, so records can be
+ * exchanged between different machines.
+ *
+ * The sums of powers of the deviations are stored rather than the variance,
+ * skewness and kurtosis, so that a merge of the records reproduces the
+ * statistics exactly as if the accumulators themselves had been merged.
+ *
+ * \note Version 1 records, which lacked the higher powers and the extreme
+ * values, are rejected by loadState().
+ */
+void StatsAccumulator::storeState(unsigned char * record) const {
+    std::memcpy(record, stateRecordMagic, 4);
+    storeLittleEndian(record + 4, stateRecordVersion, 4);
+    storeLittleEndian(record + 8, count, 8);
+    storeDouble(record + 16, sum);
+    storeDouble(record + 24, mean);
+    storeDouble(record + 32, sumOfSquaredDeviations);
+    storeDouble(record + 40, sumOfCubedDeviations);
+    storeDouble(record + 48, sumOfFourthPowerDeviations);
+    storeDouble(record + 56, minimum);
+    storeDouble(record + 64, maximum);
+}
+
+/** Public method that replaces the running statistics with those loaded
+ * from a state record in a buffer.
+ *
+ * \param record - A pointer to the first of the "stateRecordSize" bytes of
+ * the record.
+ *
+ * \return true if the record has the expected magic characters and version,
+ * false otherwise. If false is returned the running statistics are
+ * unchanged.
+ *
+ * See storeState() for the layout of the record.
+ */
+bool StatsAccumulator::loadState(const unsigned char * record){
+    
+    // Verify that the record was written with the expected layout.
+    if(std::memcmp(record, stateRecordMagic, 4) != 0 ||
+       loadLittleEndian(record + 4, 4) != stateRecordVersion){
+        return false;
+    }
+    
+    count = static_cast<std::size_t>(loadLittleEndian(record + 8, 8));
+    sum = loadDouble(record + 16);
+    mean = loadDouble(record + 24);
+    sumOfSquaredDeviations = loadDouble(record + 32);
+    sumOfCubedDeviations = loadDouble(record + 40);
+    sumOfFourthPowerDeviations = loadDouble(record + 48);
+    minimum = loadDouble(record + 56);
+    maximum = loadDouble(record + 64);
+    return true;
+}
+
+/** Public method that writes the running statistics to a binary stream as a
+ * fixed-size state record.
+ *
+ * \param stream - The stream to which the record should be written. It
+ * should have been opened in binary mode.
+ *
+ * \return true if the record was written successfully, false otherwise.
+ *
+ * See storeState() for the layout of the record.
+ */
+bool StatsAccumulator::writeState(std::ostream & stream) const {
+    
+    // Assemble the record in a local buffer, so it is written in one call.
+    unsigned char record[stateRecordSize];
+    storeState(record);
+    
+    stream.write(reinterpret_cast<const char *>(record), stateRecordSize);
+    return stream.good();
+}
+
+/** Public method that replaces the running statistics with those read from
+ * a state record in a binary stream.
+ *
+ * \param stream - The stream from which the record should be read. It
+ * should have been opened in binary mode.
+ *
+ * \return true if a complete record with the expected magic characters and
+ * version was read, false otherwise. If false is returned the running
+ * statistics are unchanged.
+ *
+ * See storeState() for the layout of the record. To combine a record with
+ * existing statistics, read it into a separate accumulator and merge().
+ */
+bool StatsAccumulator::readState(std::istream & stream){
+    
+    // Read the whole record, and verify that it is complete.
+    unsigned char record[stateRecordSize];
+    stream.read(reinterpret_cast<char *>(record), stateRecordSize);
+    if(stream.gcount() != static_cast<std::streamsize>(stateRecordSize)){
+        return false;
+    }
+    
+    return loadState(record);
+}
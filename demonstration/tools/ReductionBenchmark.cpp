@@ -0,0 +1,253 @@
+/// \file ReductionBenchmark.cpp TOOL FILE that measures the throughput of the vectorized reduction kernels
+
+// The <chrono> header is included to provide the std::chrono::steady_clock clock.
+#include <chrono>
+// The <cmath> header is included to provide the std::llround(...) function.
+#include <cmath>
+// The <cstdint> header is included to provide the std::int64_t type.
+#include <cstdint>
+// The <cstdlib> header is included to provide the std::strtoull(...) function.
+#include <cstdlib>
+// The <iostream> header is included to enable textual terminal output.
+#include <iostream>
+// The <random> header is included to provide the std::mt19937_64 generator.
+#include <random>
+// The <string> header is included to provide the STL std::string type.
+#include <string>
+// The <vector> header is included to provide the STL std::vector type.
+#include <vector>
+
+/* Include ReductionKernels.h to provide the shiftedMomentSums(...) functions,
+ * the ShiftedMomentSums structure and the ReductionInstructionSet enumeration.
+ */
+#include "ReductionKernels.h"
+
+// CONSTANTS
+
+/** The number of elements that each kernel reduces in every measurement. An
+ * array with fewer elements is reduced repeatedly, so that every measurement
+ * lasts long enough to be timed reliably.
+ */
+static const std::size_t elementsPerMeasurement = 1000000000;
+
+/** The value that is subtracted from every element, which is close to the
+ * mean of the generated values, as StatsAccumulator::addValues() would choose
+ * it when computeStatistics() summarizes them.
+ */
+static const double benchmarkShift = 1000.0;
+
+// HELPER FUNCTIONS
+
+/** Helper function that computes the sums of the first four powers of the
+ * deviations of an array from a shift value, and its smallest and largest
+ * elements, with a single range-based loop. Each sum is a single serial chain
+ * of floating-point additions, which the compiler cannot vectorize without
+ * reordering them, so the loop shows the throughput that the vectorized
+ * kernels improve upon.
+ *
+ * \param values - The array of values.
+ * \param sums - A reference to a structure that receives the sums.
+ */
+template<typename Element>
+static void referenceMomentSums(const std::vector<Element> & values,
+                                ShiftedMomentSums & sums){
+    sums = ShiftedMomentSums();
+    sums.minimum = values.empty() ? 0.0 : static_cast<double>(values[0]);
+    sums.maximum = sums.minimum;
+    for(Element element : values){
+        double value = static_cast<double>(element);
+        double deviation = value - benchmarkShift;
+        double squaredDeviation = deviation*deviation;
+        sums.sum += deviation;
+        sums.sumOfSquares += squaredDeviation;
+        sums.sumOfCubes += squaredDeviation*deviation;
+        sums.sumOfFourthPowers += squaredDeviation*squaredDeviation;
+        if(value < sums.minimum){
+            sums.minimum = value;
+        }
+        if(value > sums.maximum){
+            sums.maximum = value;
+        }
+    }
+}
+
+/** Helper function that prints the throughput of one kernel and the sums
+ * that it computed.
+ *
+ * \param name - The name of the kernel.
+ * \param elapsedSeconds - The time taken to reduce "elementCount" elements.
+ * \param elementCount - The total number of elements that were reduced.
+ * \param sums - The sums computed by the kernel.
+ */
+static void printThroughput(const char * name, double elapsedSeconds,
+                            std::size_t elementCount, const ShiftedMomentSums & sums){
+    std::cout << "Kernel = " << name << "\n"
+    << "Elements/s = " << elementCount/elapsedSeconds << "\n"
+    << "Sum = " << sums.sum << "\n"
+    << "Sum of Squares = " << sums.sumOfSquares << "\n"
+    << "Sum of Cubes = " << sums.sumOfCubes << "\n"
+    << "Sum of Fourth Powers = " << sums.sumOfFourthPowers << "\n"
+    << "Minimum = " << sums.minimum << "\n"
+    << "Maximum = " << sums.maximum << "\n" << std::endl;
+}
+
+/** Helper function that measures the range-based loop and the kernel for
+ * each instruction set that the processor supports, for one array of values
+ * of a single element type.
+ *
+ * \param typeName - The name of the element type, which is printed.
+ * \param values - The array of values.
+ * \param repetitionCount - The number of times each kernel reduces the array.
+ */
+template<typename Element>
+static void measureKernels(const char * typeName, const std::vector<Element> & values,
+                           std::size_t repetitionCount){
+    
+    // The instruction sets whose kernels are measured.
+    const ReductionInstructionSet instructionSets[] = {
+        SCALAR_REDUCTION, AVX2_REDUCTION, AVX512_REDUCTION
+    };
+    
+    std::size_t elementCount = repetitionCount*values.size();
+    std::cout << "Element type = " << typeName << "\n" << std::endl;
+    
+    // Measure the range-based loop.
+    ShiftedMomentSums sums;
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+    for(std::size_t repetition = 0; repetition < repetitionCount; ++repetition){
+        referenceMomentSums(values, sums);
+        
+        /* An empty assembly statement that the compiler must assume reads
+         * and writes memory, which prevents it from computing the
+         * loop-invariant sums only once.
+         */
+        __asm__ __volatile__("" : : : "memory");
+    }
+    double elapsedSeconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - startTime).count();
+    printThroughput("range-based loop", elapsedSeconds, elementCount, sums);
+    
+    // Measure the kernel for each instruction set that is supported.
+    for(ReductionInstructionSet instructionSet : instructionSets){
+        if(!isReductionInstructionSetSupported(instructionSet)){
+            std::cout << "Kernel = " << getReductionInstructionSetName(instructionSet)
+            << "\n" << "Elements/s = unsupported by this processor\n" << std::endl;
+            continue;
+        }
+        startTime = std::chrono::steady_clock::now();
+        for(std::size_t repetition = 0; repetition < repetitionCount; ++repetition){
+            shiftedMomentSums(instructionSet, values.data(), values.size(),
+                              benchmarkShift, sums);
+        }
+        elapsedSeconds = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - startTime).count();
+        printThroughput(getReductionInstructionSetName(instructionSet),
+                        elapsedSeconds, elementCount, sums);
+    }
+}
+
+/** The main function is the entry point for the program. The program measures
+ * the number of elements per second that each of the kernels provided by
+ * shiftedMomentSums(...) reduces, for every instruction set that the
+ * processor supports, and compares them with a plain range-based loop. These
+ * are the kernels through which computeStatistics() summarizes the stored
+ * values, so arrays of double precision values, of single precision values
+ * and of 64-bit integers are all measured.
+ *
+ * The program may be invoked with any number of command line arguments, each
+ * of which is the number of values in an array to be reduced. The values are
+ * drawn from a normal distribution with a mean of 1000 and a standard
+ * deviation of 50, using a fixed seed, so the results are reproducible, and
+ * are converted to single precision or rounded to the nearest integer for
+ * the other element types. By default arrays of 32768 values, which fit in
+ * the level 1 or level 2 cache, and of 134217728 values, which must be
+ * streamed from main memory, are measured.
+ *
+ * Each kernel reduces each array repeatedly, until about 10^9 elements have
+ * been reduced. The sums of the final reduction are printed too, so that
+ * the results of the kernels can be compared. They agree to the printed
+ * precision, although different instruction sets may differ in their last
+ * bits.
+ *
+ * The program returns zero on success and 1 if incorrect command line
+ * arguments were provided.
+ *
+ * \note Like the other tools, this file defines its own main() function and
+ * is built by linking it with every file in the "src" directory except
+ * "StatsCalculatorTest.cpp", as described in the "commands" file.
+ */
+int main(int argc, char * argv[]){
+    
+    // The numbers of values in the arrays to be reduced.
+    std::vector<std::size_t> arraySizes;
+    
+    // A flag that records whether an invalid argument was encountered.
+    bool invalidArgument(false);
+    
+    // Loop over all command line tokens except the executable name itself.
+    for(int argIndex = 1; argIndex < argc; ++argIndex){
+        char * argumentEnd(0);
+        std::size_t arraySize = std::strtoull(argv[argIndex], &argumentEnd, 10);
+        if(*argumentEnd != '\0' || arraySize == 0){
+            invalidArgument = true;
+        }
+        arraySizes.push_back(arraySize);
+    }
+    if(arraySizes.empty()){
+        arraySizes = {32768, 134217728};
+    }
+    
+    if(invalidArgument){ // Invalid arguments were provided.
+        std::cout << "Required Syntax:\n\n"
+        << "./reductionBenchmark [arraySize ...]\n\n"
+        << "Argument Descriptions:\n\n"
+        << "arraySize - The number of values in an array to be reduced "
+        << "(default 32768 and 134217728)."
+        << std::endl;
+        return 1;
+    }
+    
+    std::cout << "Dispatched instruction set = "
+    << getReductionInstructionSetName(detectReductionInstructionSet()) << "\n" << std::endl;
+    
+    for(std::size_t sizeIndex = 0; sizeIndex < arraySizes.size(); ++sizeIndex){
+        
+        // Generate the values using a fixed seed.
+        std::vector<double> values(arraySizes[sizeIndex]);
+        std::mt19937_64 generator(20240101);
+        std::normal_distribution<double> distribution(1000.0, 50.0);
+        for(double & value : values){
+            value = distribution(generator);
+        }
+        
+        /* The number of repetitions needed to reduce approximately
+         * "elementsPerMeasurement" elements.
+         */
+        std::size_t repetitionCount = elementsPerMeasurement/values.size();
+        if(repetitionCount == 0){
+            repetitionCount = 1;
+        }
+        
+        std::cout << "Array size = " << values.size() << "\n"
+        << "Repetitions = " << repetitionCount << "\n" << std::endl;
+        
+        measureKernels("double", values, repetitionCount);
+        
+        /* Measure the single precision and integer arrays one at a time, so
+         * that no more than one converted copy of the values is stored.
+         */
+        {
+            std::vector<float> floatValues(values.begin(), values.end());
+            measureKernels("float", floatValues, repetitionCount);
+        }
+        {
+            std::vector<std::int64_t> integerValues(values.size());
+            for(std::size_t valueIndex = 0; valueIndex < values.size(); ++valueIndex){
+                integerValues[valueIndex] = std::llround(values[valueIndex]);
+            }
+            measureKernels("int64", integerValues, repetitionCount);
+        }
+    }
+    
+    return 0;
+}
@@ -0,0 +1,166 @@
+/// \file SelectionBenchmark.cpp TOOL FILE that compares exact quantiles found by parallel selection with those found by sorting
+
+// The <algorithm> header is included to provide the std::sort(...) function.
+#include <algorithm>
+// The <chrono> header is included to provide the std::chrono::steady_clock clock.
+#include <chrono>
+/* The <cstdlib> header is included to provide the std::strtoul(...) and
+ * std::strtoull(...) functions.
+ */
+#include <cstdlib>
+// The <iostream> header is included to enable textual terminal output.
+#include <iostream>
+// The <random> header is included to provide the std::mt19937_64 generator.
+#include <random>
+// The <string> header is included to provide the STL std::string type.
+#include <string>
+// The <thread> header is included to provide the std::thread class.
+#include <thread>
+// The <vector> header is included to provide the STL std::vector type.
+#include <vector>
+
+/* Include OrderStatistics.h to provide the computeExactQuantiles(...) and
+ * sortValuesInParallel(...) functions.
+ */
+#include "OrderStatistics.h"
+
+/** The main function is the entry point for the program. The program measures
+ * the time taken to find the exact p50, p90, p99 and p99.9 quantiles of an
+ * array of values by the parallel multi-selection of computeExactQuantiles(),
+ * as StatsCalculator does with "--exact-quantiles", and compares it with the
+ * time taken to find them after sorting a copy of the array, both with a
+ * single call of std::sort(...) and with sortValuesInParallel(), as
+ * StatsCalculator does with "--sort".
+ *
+ * The program may be invoked with any number of command line arguments, each
+ * of which is the number of values in an array. These may be preceded by the
+ * option "--threads N", which divides the selection and the parallel sort
+ * among N worker threads (0, the default, selects one per hardware thread).
+ * The values are drawn from a normal distribution with a mean of 1000 and a
+ * standard deviation of 50, using a fixed seed, so the results are
+ * reproducible. By default an array of 10^8 values is measured, which
+ * occupies 800 MB, and a second array of the same size is needed for the
+ * sorted copy.
+ *
+ * For each array the program prints the time taken by each method, the
+ * speed-up of the selection relative to std::sort(...), and whether every
+ * method found identical quantiles.
+ *
+ * The program returns zero on success and 1 if incorrect command line
+ * arguments were provided or the methods found different quantiles.
+ *
+ * \note Like the other tools, this file defines its own main() function and
+ * is built by linking it with every file in the "src" directory except
+ * "StatsCalculatorTest.cpp", as described in the "commands" file.
+ */
+int main(int argc, char * argv[]){
+    
+    // The number of worker threads requested using the "--threads" option.
+    unsigned int threadCount(0);
+    
+    // The numbers of values in the arrays.
+    std::vector<std::size_t> arraySizes;
+    
+    // A flag that records whether an invalid argument was encountered.
+    bool invalidArgument(false);
+    
+    // Loop over all command line tokens except the executable name itself.
+    for(int argIndex = 1; argIndex < argc; ++argIndex){
+        std::string argument(argv[argIndex]);
+        if(argument == "--threads" && argIndex + 1 < argc){
+            threadCount = std::strtoul(argv[++argIndex], 0, 10);
+            continue;
+        }
+        char * argumentEnd(0);
+        std::size_t arraySize = std::strtoull(argv[argIndex], &argumentEnd, 10);
+        if(*argumentEnd != '\0' || arraySize == 0){
+            invalidArgument = true;
+        }
+        arraySizes.push_back(arraySize);
+    }
+    if(arraySizes.empty()){
+        arraySizes.push_back(100000000);
+    }
+    
+    if(invalidArgument){ // Invalid arguments were provided.
+        std::cout << "Required Syntax:\n\n"
+        << "./selectionBenchmark [--threads N] [arraySize ...]\n\n"
+        << "Argument Descriptions:\n\n"
+        << "--threads N - Select and sort using N worker threads "
+        << "(0 selects one per hardware thread).\n\n"
+        << "arraySize - The number of values in an array (default 100000000)."
+        << std::endl;
+        return 1;
+    }
+    
+    // Resolve the default number of threads.
+    if(threadCount == 0){
+        threadCount = std::thread::hardware_concurrency();
+    }
+    if(threadCount == 0){
+        threadCount = 1;
+    }
+    
+    // The probabilities of the quantiles reported by StatsCalculator.
+    const std::vector<double> probabilities = {0.5, 0.9, 0.99, 0.999};
+    
+    bool identicalQuantiles(true);
+    for(std::size_t sizeIndex = 0; sizeIndex < arraySizes.size(); ++sizeIndex){
+        
+        // Generate the values using a fixed seed.
+        std::vector<double> values(arraySizes[sizeIndex]);
+        std::mt19937_64 generator(20240101);
+        std::normal_distribution<double> distribution(1000.0, 50.0);
+        for(double & value : values){
+            value = distribution(generator);
+        }
+        
+        // Find the quantiles by selection, which leaves the values unchanged.
+        std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+        std::vector<double> selectedQuantiles =
+            computeExactQuantiles(values.data(), values.size(), probabilities,
+                                  threadCount, false);
+        double selectionSeconds = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - startTime).count();
+        
+        /* Find the quantiles by sorting a copy of the values using a single
+         * call of std::sort(...). The time taken to copy them is excluded.
+         */
+        std::vector<double> sortedValues(values);
+        startTime = std::chrono::steady_clock::now();
+        std::sort(sortedValues.begin(), sortedValues.end());
+        std::vector<double> sortedQuantiles =
+            computeExactQuantiles(sortedValues.data(), sortedValues.size(),
+                                  probabilities, 1, true);
+        double sortSeconds = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - startTime).count();
+        
+        // Repeat with the parallel sort used by StatsCalculator::sortValues().
+        sortedValues = values;
+        startTime = std::chrono::steady_clock::now();
+        sortValuesInParallel(sortedValues.data(), sortedValues.size(), threadCount);
+        std::vector<double> parallelSortedQuantiles =
+            computeExactQuantiles(sortedValues.data(), sortedValues.size(),
+                                  probabilities, 1, true);
+        double parallelSortSeconds = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - startTime).count();
+        
+        bool identical = selectedQuantiles == sortedQuantiles &&
+                         parallelSortedQuantiles == sortedQuantiles;
+        identicalQuantiles = identicalQuantiles && identical;
+        
+        std::cout << "Array size = " << values.size() << "\n"
+        << "Threads = " << threadCount << "\n"
+        << "Selection Seconds = " << selectionSeconds << "\n"
+        << "std::sort Seconds = " << sortSeconds << "\n"
+        << "Parallel Sort Seconds = " << parallelSortSeconds << "\n"
+        << "Speed-up over std::sort = " << sortSeconds/selectionSeconds << "\n";
+        for(std::size_t quantileIndex = 0; quantileIndex < probabilities.size(); ++quantileIndex){
+            std::cout << "Exact Quantile " << probabilities[quantileIndex] << " = "
+            << selectedQuantiles[quantileIndex] << "\n";
+        }
+        std::cout << "Identical results = " << (identical ? "yes" : "no") << "\n" << std::endl;
+    }
+    
+    return identicalQuantiles ? 0 : 1;
+}
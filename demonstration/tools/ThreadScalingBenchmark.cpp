@@ -0,0 +1,165 @@
+/// \file ThreadScalingBenchmark.cpp TOOL FILE that measures how the parsing of one input file scales with the number of threads
+
+// The <algorithm> header is included to provide the std::find(...) function.
+#include <algorithm>
+// The <chrono> header is included to provide the std::chrono::steady_clock clock.
+#include <chrono>
+// The <cstdlib> header is included to provide the std::strtoul(...) function.
+#include <cstdlib>
+// The <iostream> header is included to enable textual terminal output.
+#include <iostream>
+// The <string> header is included to provide the STL std::string type.
+#include <string>
+// The <thread> header is included to provide the std::thread class.
+#include <thread>
+// The <vector> header is included to provide the STL std::vector type.
+#include <vector>
+
+// The <sys/stat.h> header is included to provide the stat(...) function.
+#include <sys/stat.h>
+
+/* Include StatsCalculator.h to provide class definition of
+ * StatsCalculator
+ */
+#include "StatsCalculator.h"
+
+/** The main function is the entry point for the program. The program measures
+ * the rate at which StatsCalculator::readFile() ingests a single text input
+ * file when its parsing is divided among 1, 2, 4 and 8 worker threads, and
+ * among one thread per hardware thread of the processor, as selected by the
+ * "--threads" option of the statsCalculator program.
+ *
+ * The program is designed to be invoked with one command line argument: the
+ * path of the input text file, which should be large enough, for example a
+ * gigabyte, that the time taken to start the threads is negligible. It may
+ * be preceded by the option "--repeats R", which reads the file R times
+ * with each number of threads and reports the fastest, so that the first
+ * read, which may load the file from the storage device rather than from
+ * the page cache, does not distort the results. The default is 3.
+ *
+ * For each number of threads the program prints the fastest time taken to
+ * read the file, the ingest rate in gigabytes per second and the speed-up
+ * relative to a single thread. It also checks that every number of threads
+ * reads the same number of values with the same sum, since the values must
+ * be joined in their original order.
+ *
+ * The program returns zero on success and 1 if incorrect command line
+ * arguments were provided, the input file could not be read or the results
+ * differed between numbers of threads.
+ *
+ * \note Like the other tools, this file defines its own main() function and
+ * is built by linking it with every file in the "src" directory except
+ * "StatsCalculatorTest.cpp", as described in the "commands" file.
+ */
+int main(int argc, char * argv[]){
+    
+    // The number of times the file is read with each number of threads.
+    unsigned long repeatCount(3);
+    
+    // The input file path.
+    std::vector<std::string> paths;
+    
+    // A flag that records whether an unrecognized option was encountered.
+    bool invalidOption(false);
+    
+    // Loop over all command line tokens except the executable name itself.
+    for(int argIndex = 1; argIndex < argc; ++argIndex){
+        std::string argument(argv[argIndex]);
+        if(argument == "--repeats" && argIndex + 1 < argc){
+            repeatCount = std::strtoul(argv[++argIndex], 0, 10);
+        }
+        else if(argument.size() > 2 && argument.compare(0, 2, "--") == 0){
+            invalidOption = true;
+        }
+        else{
+            paths.push_back(argument);
+        }
+    }
+    
+    // Establish the size of the input file using the POSIX stat() function.
+    struct stat fileStatus;
+    if(paths.size() == 1 && !invalidOption && repeatCount > 0 &&
+       stat(paths[0].c_str(), &fileStatus) == 0){
+        double gigabytes = static_cast<double>(fileStatus.st_size)/1.0e9;
+        
+        /* The numbers of threads to be measured, ending with one thread per
+         * hardware thread unless that number has already been measured.
+         */
+        std::vector<unsigned int> threadCounts = {1, 2, 4, 8};
+        unsigned int hardwareThreadCount = std::thread::hardware_concurrency();
+        if(hardwareThreadCount > 0 &&
+           std::find(threadCounts.begin(), threadCounts.end(),
+                     hardwareThreadCount) == threadCounts.end()){
+            threadCounts.push_back(hardwareThreadCount);
+        }
+        
+        std::cout << "Input file = " << paths[0] << "\n"
+        << "Input size (GB) = " << gigabytes << "\n"
+        << "Hardware threads = " << hardwareThreadCount << "\n" << std::endl;
+        
+        // The results of a single thread, with which the others are compared.
+        double singleThreadSeconds(0.0);
+        StatsSummary singleThreadSummary = StatsSummary();
+        bool consistentResults(true);
+        
+        for(std::size_t countIndex = 0; countIndex < threadCounts.size(); ++countIndex){
+            double fastestSeconds(0.0);
+            for(unsigned long repeatIndex = 0; repeatIndex < repeatCount; ++repeatIndex){
+                /* Read the whole file into a new, quiet StatsCalculator, so
+                 * that every read stores the values afresh.
+                 */
+                StatsCalculator statsCalculator;
+                statsCalculator.setVerbosity(QUIET_OUTPUT);
+                statsCalculator.setThreadCount(threadCounts[countIndex]);
+                std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+                bool readable = statsCalculator.readFile(paths[0]);
+                double elapsedSeconds = std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - startTime).count();
+                if(!readable){
+                    return 1;
+                }
+                if(repeatIndex == 0 || elapsedSeconds < fastestSeconds){
+                    fastestSeconds = elapsedSeconds;
+                }
+                
+                /* Compare the count and sum of the values with those read by
+                 * a single thread. The sum is computed by the same kernel
+                 * from the same values in the same order, so it must agree
+                 * exactly.
+                 */
+                StatsSummary summary = statsCalculator.getSummary();
+                if(countIndex == 0 && repeatIndex == 0){
+                    singleThreadSummary = summary;
+                }
+                else if(summary.count != singleThreadSummary.count ||
+                        summary.sum != singleThreadSummary.sum){
+                    consistentResults = false;
+                }
+            }
+            if(countIndex == 0){
+                singleThreadSeconds = fastestSeconds;
+            }
+            
+            std::cout << "Threads = " << threadCounts[countIndex] << "\n"
+            << "Seconds = " << fastestSeconds << "\n"
+            << "GB/s = " << gigabytes/fastestSeconds << "\n"
+            << "Speed-up = " << singleThreadSeconds/fastestSeconds << "\n" << std::endl;
+        }
+        
+        std::cout << "Count = " << singleThreadSummary.count << "\n"
+        << "Sum =  " << singleThreadSummary.sum << "\n"
+        << "Identical results = " << (consistentResults ? "yes" : "no") << std::endl;
+        return consistentResults ? 0 : 1;
+    }
+    else{ // Invalid arguments were provided.
+        std::cout << "Required Syntax:\n\n"
+        << "./threadScalingBenchmark [--repeats R] inputFile\n\n"
+        << "Argument Descriptions:\n\n"
+        << "--repeats R - Read the input file R times with each number of "
+        << "threads, and report the fastest (default 3).\n\n"
+        << "inputFile - The path of an existing text file containing "
+        << "whitespace-separated numeric values."
+        << std::endl;
+        return 1;
+    }
+}